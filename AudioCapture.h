@@ -1,75 +1,199 @@
-#ifndef AUDIOCAPTURE_H
-#define AUDIOCAPTURE_H
-
-#include <QObject>
-#include <QAudioSource>
-#include <QAudioDevice>
-#include <QByteArray>
-#include <QTimer>
-
-class AudioCapture : public QObject
-{
-    Q_OBJECT
-
-public:
-    explicit AudioCapture(QObject *parent = nullptr);
-    ~AudioCapture();
-
-public slots:
-    void initialize();  // 从 ConfigManager 读取配置，打开音频设备，启动定时器
-    void stop();        // 停止采集，释放资源
-
-private slots:
-    void onTimerTimeout();  // 定时器回调：读取硬件缓冲区数据并切帧
-
-private:
-    float calculateRMS(const QByteArray &data);   // 计算归一化 RMS 音量
-    void  processFrame(const QByteArray &frame);  // 对一帧执行 VAD 状态机
-    void  resetState();                           // 重置 VAD 状态机
-
-private:
-    // ─── 音频设备 ────────────────────────────────────────────────────────────
-    QAudioSource *m_audioSource = nullptr;
-    QIODevice    *m_audioDevice = nullptr;
-    QAudioFormat  m_format;
-    QTimer       *m_sampleTimer = nullptr;
-
-    // ─── VAD 参数 ─────────────────────────────────────────────────────────────
-    double m_vadThreshold;  // 音量阈值（归一化 RMS）
-    int    m_minSilenceDurationMs;    // 断句最短静音时长（毫秒）
-
-    // ─── VAD 状态机 ──────────────────────────────────────────────────────────
-    enum class RecordingState {
-        Idle,       // 空闲，等待语音
-        Buffering,  // 预积累，还未达到触发阈值
-        Recording   // 录制中，持续发送音频
-    };
-    RecordingState m_state = RecordingState::Idle;
-
-    QList<QByteArray> m_bufferQueue;    // Buffering 状态下的预积累帧队列
-    int m_silenceFrameCount  = 0;       // 连续静音帧计数
-    int m_recordingFrameCount = 0;      // 当前句子已录制帧数（用于限制最长录制时长）
-
-    // ─── 音频积累缓冲区（核心修复新增）──────────────────────────────────────
-    // 用于积累从硬件读取的原始 PCM 数据，按 FRAME_SIZE 切帧后再做 VAD。
-    // 解决定时器与硬件采集节奏不同步导致 read() 读到零值数据的问题。
-    QByteArray m_accumBuffer;
-
-    // ─── 常量 ────────────────────────────────────────────────────────────────
-    static constexpr int FRAME_MS              = 40;    // 每帧时长（毫秒）
-    static constexpr int FRAME_SIZE            = 1280;  // 每帧字节数（40ms@16kHz/16bit/1ch）
-    static constexpr int MIN_FRAMES_TO_TRIGGER = 15;    // 触发识别所需最少连续语音帧
-    static constexpr int MAX_RECORDING_FRAMES  = 1500;  // 单句最长录制帧数（60s）
-
-    // 由 initialize() 根据配置动态计算，不在成员变量初始化时写死
-    int m_maxSilenceFrames = 20;
-
-signals:
-    void startRecognition();
-    void sendAudioChunk(const QByteArray &chunk);
-    void stopRecognition();
-    void error(const QString &message);
-    void debug(const QString &message);
-};
-
-#endif // AUDIOCAPTURE_H
+#ifndef AUDIOCAPTURE_H
+#define AUDIOCAPTURE_H
+
+#include <QObject>
+#include <QAudioSource>
+#include <QAudioDevice>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <memory>
+#include "audioringbuffer.h"
+#include "audiohandoffqueue.h"
+#include "audioframepool.h"
+#include "voiceactivitydetector.h"
+#include "noisefloorestimator.h"
+#include "endpointer.h"
+#include "audioconverter.h"
+#include <vector>
+
+class AudioCapture : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit AudioCapture(QObject *parent = nullptr);
+    ~AudioCapture();
+
+    // 设置交给识别线程的有界队列（moveToThread 之前调用）
+    void setHandoffQueue(AudioHandoffQueue *queue);
+    // 设置音频帧池（moveToThread 之前调用；帧池须比识别线程持有的句柄活得更久）
+    void setFramePool(AudioFramePool *pool);
+
+public slots:
+    void initialize();  // 从 ConfigManager 读取配置，打开音频设备
+    void stop();        // 停止采集，释放资源
+    void calibrate();   // 一次性校准：采集 CALIBRATION_FRAMES 帧环境噪声，据此设定阈值
+    void setMuted(bool muted);   // 游戏内静音：暂停 VAD 与识别（由 OscReceiver::muteChanged 触发）
+    void setPushToTalk(bool held);   // 按键说话：按下立即开始、松开立即结束（PushToTalkKey / OscReceiver 触发）
+    // 流式识别中间结果：取末尾标点作为断句提示（SpeechRecogniser::recognitionPartial）
+    void onRecognitionPartial(quint64 sessionId, const QString &text, int stableLength);
+    void onRecognitionSessionStarted(quint64 utterance, quint64 sessionId);
+
+private slots:
+    void onReadyRead();     // 设备有新数据：读入环形缓冲区并切帧
+
+private:
+    bool setupFormat(const QAudioDevice &device);  // 选择设备格式，必要时启用格式转换
+    void readDirect();                             // 16kHz/16bit/单声道：直接读进环形缓冲区
+    void readConverted();                          // 其他格式：读入原始数据，转换后写进环形缓冲区
+    void writeRing(const char *data, int bytes);   // 写入环形缓冲区，满时丢弃并计数
+    void drainFrames();                            // 按整帧取出并处理
+
+private:
+    void  processFrame(const QByteArray &frame);  // 对一帧执行 VAD 状态机（frame 为环形缓冲区内的视图）
+    void  processPushToTalkFrame(const QByteArray &frame);   // 按键说话模式：不做 VAD，只按按键状态录制
+    void  endPushToTalk();                        // 按键说话：不足 MIN_PTT_FRAMES 取消，否则结束识别
+    void  resetState();                           // 重置 VAD 状态机
+    AudioFrameRef captureFrame(const QByteArray &frame);   // 从帧池取一帧并拷入，帧池耗尽时返回空句柄
+    void  pushPreRoll(const QByteArray &frame);   // 帧写入预录环
+    void  deliverPreRoll(int frames);             // 按时间顺序发送预录环中最近 frames 帧
+    void  startUtterance();                       // 起始确认通过，开始识别
+    void  endUtterance();                         // 静音断句：正常结束或取消误触发
+
+    // 把开始/音频/结束事件放入交接队列；控制事件立即唤醒识别线程，
+    // 音频帧每 m_batchFrames 帧唤醒一次
+    void  deliver(AudioEvent::Type type, const AudioFrameRef &frame = AudioFrameRef());
+    void  wakeConsumer();
+    void  reportStats();
+    void  reportEndpoint();                       // 自适应断句：输出本次断句依据
+    void  updateNoiseFloor(float rms);            // 更新噪声底、自适应阈值与校准
+    void  applyThreshold(double threshold);
+
+private:
+    // ─── 音频设备 ────────────────────────────────────────────────────────────
+    QAudioSource *m_audioSource = nullptr;
+    QIODevice    *m_audioDevice = nullptr;
+    QAudioFormat  m_format;
+
+    // ─── 格式转换（设备不支持 16kHz/16bit/单声道时启用）────────────────────
+    AudioConverter       m_converter;
+    bool                 m_converting = false;
+    std::vector<char>    m_rawBuffer;       // 设备原始数据（可能残留不足一帧的字节）
+    int                  m_rawPending = 0;  // m_rawBuffer 中尚未转换的字节数
+    std::vector<int16_t> m_convertBuffer;   // 转换结果
+
+    // ─── VAD 参数 ─────────────────────────────────────────────────────────────
+    double m_vadThreshold;  // 音量阈值（归一化 RMS）
+    int    m_minSilenceDurationMs;    // 断句最短静音时长（毫秒）
+    std::unique_ptr<IVoiceActivityDetector> m_vad;   // 由配置 vadMode 选择的检测器
+    quint64 m_reportedVadOverruns = 0;                // 已上报的 VAD 超预算帧数
+
+    // ─── 噪声底与自适应阈值 ──────────────────────────────────────────────────
+    NoiseFloorEstimator m_noiseFloor;
+    bool  m_autoThreshold      = false;   // 由配置 autoVadThreshold 决定
+    int   m_noiseReportCounter = 0;
+    int   m_calibrationFrames  = 0;       // >0 表示正在校准，剩余帧数
+    std::vector<float> m_calibrationRms;  // 校准期间的逐帧 RMS（预留容量，不在采集中分配）
+
+    // ─── VAD 状态机 ──────────────────────────────────────────────────────────
+    enum class RecordingState {
+        Idle,       // 空闲，等待语音
+        Buffering,  // 疑似语音，等待起始确认
+        Recording   // 录制中，持续发送音频
+    };
+    RecordingState m_state = RecordingState::Idle;
+
+    int m_silenceFrameCount  = 0;       // 连续静音帧计数
+    int m_recordingFrameCount = 0;      // 当前句子已录制帧数（用于限制最长录制时长）
+    int m_bufferingFrames    = 0;       // 进入 Buffering 以来的帧数
+    int m_onsetVoicedFrames  = 0;       // Buffering 期间的语音帧数
+    int m_utteranceVoicedFrames = 0;    // 当前句子的语音帧总数（判断误触发）
+
+    // ─── 自适应断句 ──────────────────────────────────────────────────────────
+    // 录制中的静音超时由 Endpointer 按说话人停顿统计、语速、能量趋势和标点决定；
+    // 配置 adaptiveEndpoint=false 时退回固定的 minSilenceDuration。
+    Endpointer m_endpointer;
+    bool    m_adaptiveEndpoint   = true;
+    quint64 m_lastEndFrame       = 0;   // 上一句因静音结束时的 m_framesCaptured
+    bool    m_hasLastEnd         = false;
+    int     m_onsetGapFrames     = -1;  // 本句起始距上一句结束的帧数
+    // 每个 Start 事件携带递增的句子序号，识别端回报为该句创建的会话编号，
+    // 只有本句会话的中间结果才作为标点提示（迟到的上一句结果不会误判句末）
+    quint64 m_utteranceSerial    = 0;   // 最近一次发出的 Start 的序号
+    quint64 m_currentSessionId   = 0;
+    bool    m_hasCurrentSession  = false;
+
+    // ─── 预录环 ──────────────────────────────────────────────────────────────
+    // 非录制状态下始终保留最近的若干帧，触发识别时先补发，保住句首音节。
+    // 容量 = 预录帧数 + 起始确认可能经历的最长帧数，initialize() 时一次性分配。
+    // 环中保存帧池句柄，补发时直接交出引用，不再拷贝音频。
+    std::vector<AudioFrameRef> m_preRoll;
+    int m_preRollCapacity = 0;          // 环容量（帧）
+    int m_preRollHead     = 0;          // 下一帧写入位置
+    int m_preRollCount    = 0;          // 已保存帧数
+    int m_preRollFrames   = 0;          // 配置 preRollMs 对应的帧数
+    int m_onsetFrames     = 4;          // 配置 onsetMs 对应的起始确认帧数
+
+    // ─── 音频环形缓冲区 ──────────────────────────────────────────────────────
+    // readyRead 时把设备数据直接读入预分配的环形缓冲区，按 FRAME_SIZE 原地切帧。
+    // 容量固定（RING_FRAMES 帧），界面卡顿时不会无限增长；写满时丢弃并计数。
+    AudioRingBuffer m_ring;
+    quint64 m_droppedBytes = 0;   // 环形缓冲区写满而丢弃的字节数
+
+    // ─── 交接队列、帧池与溢出统计 ────────────────────────────────────────────
+    AudioHandoffQueue *m_handoff   = nullptr;
+    AudioFramePool    *m_framePool = nullptr;
+    int     m_batchFrames      = 2;     // 配置 handoffBatchFrames：每批音频帧数
+    int     m_unsignalledFrames = 0;    // 已入队、尚未唤醒的音频帧数
+    QElapsedTimer m_readClock;          // 两次 readyRead 的间隔计时
+    quint64 m_framesCaptured = 0;       // 已处理帧数
+    int     m_maxReadGapMs   = 0;       // 统计周期内 readyRead 最大间隔
+    quint64 m_lateReads      = 0;       // 间隔超过硬件缓冲区时长的次数（可能发生硬件溢出）
+
+    // ─── 常量 ────────────────────────────────────────────────────────────────
+    static constexpr int FRAME_MS              = 40;    // 每帧时长（毫秒）
+    static constexpr int FRAME_SIZE            = AudioFramePool::FRAME_BYTES;  // 每帧字节数（40ms@16kHz/16bit/1ch）
+    static constexpr int ONSET_GAP_FRAMES      = 3;     // 起始确认期间允许的连续静音帧
+    static constexpr int MIN_UTTERANCE_FRAMES  = 5;     // 语音帧少于此数（200ms）的句子视为误触发
+    static constexpr int MAX_RECORDING_FRAMES  = AudioFramePool::MAX_UTTERANCE_FRAMES;  // 单句最长录制帧数（60s）
+    static constexpr int MAX_ENDPOINT_FRAMES   = 50;    // 自适应断句的静音超时上限（2s）
+    static constexpr int MIN_PTT_FRAMES        = 3;     // 按住不足此帧数（120ms）视为误按，取消识别
+    static constexpr int RING_FRAMES           = 50;    // 环形缓冲区容量（帧，约 2s）
+    static constexpr int HW_BUFFER_BYTES       = 6400;  // 硬件缓冲区（约 200ms）
+    static constexpr int HW_BUFFER_MS          = 200;
+    static constexpr int STATS_INTERVAL_FRAMES = 125;   // 每 5s 上报一次采集统计
+    static constexpr int CONVERT_BLOCK_MS      = 20;    // 格式转换时每次读取的原始数据时长
+    static constexpr int NOISE_REPORT_FRAMES   = 12;    // 约每 0.5s 上报一次噪声底
+    static constexpr int CALIBRATION_FRAMES    = 75;    // 校准时长（3s）
+    static constexpr double ADAPTIVE_MARGIN    = 3.0;   // 自适应阈值 = 噪声底 × 3（约 +9.5dB）
+    static constexpr double CALIBRATION_MARGIN = 2.0;   // 校准阈值 = 噪声 90 分位 × 2
+    static constexpr double MIN_THRESHOLD      = 0.003;
+    static constexpr double MAX_THRESHOLD      = 0.15;
+
+    // 由 initialize() 根据配置动态计算，不在成员变量初始化时写死
+    int m_maxSilenceFrames = 20;
+
+    // 游戏内静音期间仍读走设备数据（避免硬件溢出），但不做 VAD、不发起识别
+    bool m_muted = false;
+
+    // 按键说话（配置 pushToTalk）：断句完全由按键决定，不等待静音、不做起始确认
+    bool m_pushToTalk = false;
+    bool m_pttHeld    = false;
+
+signals:
+    void speechOnset();         // 检测到疑似语音（进入 Buffering），供下游提前预热连接
+    void audioAvailable();      // 交接队列中有新事件
+    // 采集统计：ringDropped 为环形缓冲区丢弃字节数，handoffDropped 为交接队列丢弃帧数，
+    // lateReads 为 readyRead 间隔超过硬件缓冲区时长的次数
+    // wakeups 为唤醒识别线程的次数
+    void captureStats(quint64 frames, quint64 ringDropped, quint64 handoffDropped,
+                      quint64 lateReads, int maxReadGapMs, quint64 wakeups);
+    // 帧池统计：inUse/peakInUse 为在用帧数及峰值，exhausted 为帧池耗尽而丢弃的帧数
+    void framePoolStats(int inUse, int peakInUse, int capacity, quint64 exhausted);
+    void noiseFloorChanged(double floor, double threshold);   // 当前噪声底与生效阈值（归一化 RMS）
+    void thresholdCalibrated(double threshold);               // 校准完成，新阈值
+    void error(const QString &message);
+    void debug(const QString &message);
+};
+
+#endif // AUDIOCAPTURE_H
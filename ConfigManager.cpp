@@ -1,154 +1,466 @@
-#include "ConfigManager.h"
-#include <QCoreApplication>
-#include <QDir>
-#include <QSettings>
-#include <QMutexLocker>
-
-// 全局唯一锁初始化
-QMutex ConfigManager::m_globalMutex;
-
-ConfigManager::ConfigManager(QObject *parent)
-    : QObject(parent)
-    , m_vadThreshold(0.015)
-    , m_minSilenceDuration(800)
-    , m_targetPort(9000)
-    , m_targetHost("127.0.0.1")
-    , sampleRate(16000)
-{}
-
-ConfigManager& ConfigManager::getInstance() {
-    static ConfigManager instance;
-    return instance;
-}
-
-void ConfigManager::loadFileToManager() {
-    QMutexLocker locker(&m_globalMutex);
-
-    QDir exeDir(QCoreApplication::applicationDirPath());
-    QString configPath = exeDir.absoluteFilePath("config.ini");
-    QSettings settings(configPath, QSettings::IniFormat);
-
-    m_vadThreshold       = settings.value("vadThreshold", 0.015).toDouble();
-    m_minSilenceDuration = settings.value("minSilenceDuration", 800).toInt();
-    m_targetPort         = settings.value("targetPort", 9000).toInt();
-    m_targetHost         = settings.value("targetHost", "127.0.0.1").toString();
-    m_xunFeiAppId        = settings.value("xunFeiAppId", "").toString();
-    m_xunFeiApiSecret    = settings.value("xunFeiApiSecret", "").toString();
-    m_xunFeiApiKey       = settings.value("xunFeiApiKey", "").toString();
-    m_DeepseekApiKey     = settings.value("DeepseekApiKey", "").toString();
-    m_targetLanguage     = settings.value("targetLanguage", "英语(EN)").toString();
-    m_device             = settings.value("device", "").toString();
-}
-
-void ConfigManager::loadManagerToFile() {
-    QMutexLocker locker(&m_globalMutex);
-
-    QDir exeDir(QCoreApplication::applicationDirPath());
-    QString configPath = exeDir.absoluteFilePath("config.ini");
-    QSettings settings(configPath, QSettings::IniFormat);
-
-    settings.setValue("vadThreshold", m_vadThreshold);
-    settings.setValue("minSilenceDuration", m_minSilenceDuration);
-    settings.setValue("targetPort", m_targetPort);
-    settings.setValue("targetHost", m_targetHost);
-    settings.setValue("xunFeiAppId", m_xunFeiAppId);
-    settings.setValue("xunFeiApiSecret", m_xunFeiApiSecret);
-    settings.setValue("xunFeiApiKey", m_xunFeiApiKey);
-    settings.setValue("DeepseekApiKey", m_DeepseekApiKey);
-    settings.setValue("targetLanguage", m_targetLanguage);
-    settings.setValue("device", m_device);
-    settings.sync();
-}
-
-double ConfigManager::getVadThreshold() const {
-    QMutexLocker locker(&m_globalMutex);
-    return m_vadThreshold;
-}
-void ConfigManager::setVadThreshold(double value) {
-    QMutexLocker locker(&m_globalMutex);
-    m_vadThreshold = value;
-}
-
-int ConfigManager::getMinSilenceDuration() const {
-    QMutexLocker locker(&m_globalMutex);
-    return m_minSilenceDuration;
-}
-void ConfigManager::setMinSilenceDuration(int value) {
-    QMutexLocker locker(&m_globalMutex);
-    m_minSilenceDuration = value;
-}
-
-int ConfigManager::getTargetPort() const {
-    QMutexLocker locker(&m_globalMutex);
-    return m_targetPort;
-}
-void ConfigManager::setTargetPort(int value) {
-    QMutexLocker locker(&m_globalMutex);
-    m_targetPort = value;
-}
-
-QString ConfigManager::getTargetHost() const {
-    QMutexLocker locker(&m_globalMutex);
-    return m_targetHost;
-}
-void ConfigManager::setTargetHost(const QString& value) {
-    QMutexLocker locker(&m_globalMutex);
-    m_targetHost = value;
-}
-
-QString ConfigManager::getXunFeiAppId() const {
-    QMutexLocker locker(&m_globalMutex);
-    return m_xunFeiAppId;
-}
-void ConfigManager::setXunFeiAppId(const QString& value) {
-    QMutexLocker locker(&m_globalMutex);
-    m_xunFeiAppId = value;
-}
-
-QString ConfigManager::getXunFeiApiSecret() const {
-    QMutexLocker locker(&m_globalMutex);
-    return m_xunFeiApiSecret;
-}
-void ConfigManager::setXunFeiApiSecret(const QString& value) {
-    QMutexLocker locker(&m_globalMutex);
-    m_xunFeiApiSecret = value;
-}
-
-QString ConfigManager::getXunFeiApiKey() const {
-    QMutexLocker locker(&m_globalMutex);
-    return m_xunFeiApiKey;
-}
-void ConfigManager::setXunFeiApiKey(const QString& value) {
-    QMutexLocker locker(&m_globalMutex);
-    m_xunFeiApiKey = value;
-}
-
-QString ConfigManager::getDeepseekApiKey() const {
-    QMutexLocker locker(&m_globalMutex);
-    return m_DeepseekApiKey;
-}
-void ConfigManager::setDeepseekApiKey(const QString& value) {
-    QMutexLocker locker(&m_globalMutex);
-    m_DeepseekApiKey = value;
-}
-
-QString ConfigManager::getTargetLanguage() const {
-    QMutexLocker locker(&m_globalMutex);
-    return m_targetLanguage;
-}
-void ConfigManager::setTargetLanguage(QString value) {
-    QMutexLocker locker(&m_globalMutex);
-    m_targetLanguage = value;
-}
-
-QString ConfigManager::getDevice() const {
-    QMutexLocker locker(&m_globalMutex);
-    return m_device;
-}
-void ConfigManager::setDevice(const QString& value) {
-    QMutexLocker locker(&m_globalMutex);
-    m_device = value;
-}
-int ConfigManager::getSampleRate() const{
-    return 16000;
-}
+#include "ConfigManager.h"
+#include <QCoreApplication>
+#include <QDir>
+#include <QSettings>
+#include <QMutexLocker>
+
+// 全局唯一锁初始化
+QMutex ConfigManager::m_globalMutex;
+
+ConfigManager::ConfigManager(QObject *parent)
+    : QObject(parent)
+    , m_vadThreshold(0.015)
+    , m_minSilenceDuration(800)
+    , m_targetPort(9000)
+    , m_targetHost("127.0.0.1")
+    , m_streamingRecognition(true)
+    , m_maxRecognitionSessions(3)
+    , m_highPriorityCapture(true)
+    , m_vadMode("rms")
+    , m_autoVadThreshold(false)
+    , m_preRollMs(300)
+    , m_onsetMs(160)
+    , m_resamplerQuality("medium")
+    , m_handoffBatchFrames(2)
+    , m_dynamicCorrection(true)
+    , m_partialToChatbox(false)
+    , m_partialChatboxIntervalMs(1500)
+    , m_speculativeTranslation(false)
+    , m_streamTranslation(true)
+    , m_translationMaxInFlight(2)
+    , m_translationCache(true)
+    , m_translationKeepAliveSec(180)
+    , m_chatboxIntervalMs(1500)
+    , m_chatboxPageMs(3000)
+    , m_muteGating(true)
+    , m_oscListenPort(9001)
+    , m_pushToTalk(false)
+    , m_pttHotkey("F8")
+    , m_pttOscParameter("/avatar/parameters/PushToTalk")
+    , m_adaptiveEndpoint(true)
+    , m_endpointMinMs(300)
+    , sampleRate(16000)
+{}
+
+ConfigManager& ConfigManager::getInstance() {
+    static ConfigManager instance;
+    return instance;
+}
+
+void ConfigManager::loadFileToManager() {
+    QMutexLocker locker(&m_globalMutex);
+
+    QDir exeDir(QCoreApplication::applicationDirPath());
+    QString configPath = exeDir.absoluteFilePath("config.ini");
+    QSettings settings(configPath, QSettings::IniFormat);
+
+    m_vadThreshold       = settings.value("vadThreshold", 0.015).toDouble();
+    m_minSilenceDuration = settings.value("minSilenceDuration", 800).toInt();
+    m_targetPort         = settings.value("targetPort", 9000).toInt();
+    m_targetHost         = settings.value("targetHost", "127.0.0.1").toString();
+    m_xunFeiAppId        = settings.value("xunFeiAppId", "").toString();
+    m_xunFeiApiSecret    = settings.value("xunFeiApiSecret", "").toString();
+    m_xunFeiApiKey       = settings.value("xunFeiApiKey", "").toString();
+    m_DeepseekApiKey     = settings.value("DeepseekApiKey", "").toString();
+    m_targetLanguage     = settings.value("targetLanguage", "英语(EN)").toString();
+    m_device             = settings.value("device", "").toString();
+    m_streamingRecognition = settings.value("streamingRecognition", true).toBool();
+    m_maxRecognitionSessions = settings.value("maxRecognitionSessions", 3).toInt();
+    m_highPriorityCapture  = settings.value("highPriorityCapture", true).toBool();
+    m_vadMode = settings.value("vadMode", "rms").toString();
+    m_autoVadThreshold = settings.value("autoVadThreshold", false).toBool();
+    m_preRollMs = settings.value("preRollMs", 300).toInt();
+    m_onsetMs = settings.value("onsetMs", 160).toInt();
+    m_resamplerQuality = settings.value("resamplerQuality", "medium").toString();
+    m_handoffBatchFrames = settings.value("handoffBatchFrames", 2).toInt();
+    m_dynamicCorrection = settings.value("dynamicCorrection", true).toBool();
+    m_partialToChatbox = settings.value("partialToChatbox", false).toBool();
+    m_partialChatboxIntervalMs = settings.value("partialChatboxIntervalMs", 1500).toInt();
+    m_speculativeTranslation = settings.value("speculativeTranslation", false).toBool();
+    m_streamTranslation = settings.value("streamTranslation", true).toBool();
+    m_translationMaxInFlight = settings.value("translationMaxInFlight", 2).toInt();
+    m_translationCache = settings.value("translationCache", true).toBool();
+    m_translationKeepAliveSec = settings.value("translationKeepAliveSec", 180).toInt();
+    m_chatboxIntervalMs = settings.value("chatboxIntervalMs", 1500).toInt();
+    m_chatboxPageMs = settings.value("chatboxPageMs", 3000).toInt();
+    m_muteGating = settings.value("muteGating", true).toBool();
+    m_oscListenPort = settings.value("oscListenPort", 9001).toInt();
+    m_pushToTalk = settings.value("pushToTalk", false).toBool();
+    m_pttHotkey = settings.value("pttHotkey", "F8").toString();
+    m_pttOscParameter = settings.value("pttOscParameter", "/avatar/parameters/PushToTalk").toString();
+    m_adaptiveEndpoint = settings.value("adaptiveEndpoint", true).toBool();
+    m_endpointMinMs = settings.value("endpointMinMs", 300).toInt();
+}
+
+void ConfigManager::loadManagerToFile() {
+    QMutexLocker locker(&m_globalMutex);
+
+    QDir exeDir(QCoreApplication::applicationDirPath());
+    QString configPath = exeDir.absoluteFilePath("config.ini");
+    QSettings settings(configPath, QSettings::IniFormat);
+
+    settings.setValue("vadThreshold", m_vadThreshold);
+    settings.setValue("minSilenceDuration", m_minSilenceDuration);
+    settings.setValue("targetPort", m_targetPort);
+    settings.setValue("targetHost", m_targetHost);
+    settings.setValue("xunFeiAppId", m_xunFeiAppId);
+    settings.setValue("xunFeiApiSecret", m_xunFeiApiSecret);
+    settings.setValue("xunFeiApiKey", m_xunFeiApiKey);
+    settings.setValue("DeepseekApiKey", m_DeepseekApiKey);
+    settings.setValue("targetLanguage", m_targetLanguage);
+    settings.setValue("device", m_device);
+    settings.setValue("streamingRecognition", m_streamingRecognition);
+    settings.setValue("maxRecognitionSessions", m_maxRecognitionSessions);
+    settings.setValue("highPriorityCapture", m_highPriorityCapture);
+    settings.setValue("vadMode", m_vadMode);
+    settings.setValue("autoVadThreshold", m_autoVadThreshold);
+    settings.setValue("preRollMs", m_preRollMs);
+    settings.setValue("onsetMs", m_onsetMs);
+    settings.setValue("resamplerQuality", m_resamplerQuality);
+    settings.setValue("handoffBatchFrames", m_handoffBatchFrames);
+    settings.setValue("dynamicCorrection", m_dynamicCorrection);
+    settings.setValue("partialToChatbox", m_partialToChatbox);
+    settings.setValue("partialChatboxIntervalMs", m_partialChatboxIntervalMs);
+    settings.setValue("speculativeTranslation", m_speculativeTranslation);
+    settings.setValue("streamTranslation", m_streamTranslation);
+    settings.setValue("translationMaxInFlight", m_translationMaxInFlight);
+    settings.setValue("translationCache", m_translationCache);
+    settings.setValue("translationKeepAliveSec", m_translationKeepAliveSec);
+    settings.setValue("chatboxIntervalMs", m_chatboxIntervalMs);
+    settings.setValue("chatboxPageMs", m_chatboxPageMs);
+    settings.setValue("muteGating", m_muteGating);
+    settings.setValue("oscListenPort", m_oscListenPort);
+    settings.setValue("pushToTalk", m_pushToTalk);
+    settings.setValue("pttHotkey", m_pttHotkey);
+    settings.setValue("pttOscParameter", m_pttOscParameter);
+    settings.setValue("adaptiveEndpoint", m_adaptiveEndpoint);
+    settings.setValue("endpointMinMs", m_endpointMinMs);
+    settings.sync();
+}
+
+double ConfigManager::getVadThreshold() const {
+    QMutexLocker locker(&m_globalMutex);
+    return m_vadThreshold;
+}
+void ConfigManager::setVadThreshold(double value) {
+    QMutexLocker locker(&m_globalMutex);
+    m_vadThreshold = value;
+}
+
+int ConfigManager::getMinSilenceDuration() const {
+    QMutexLocker locker(&m_globalMutex);
+    return m_minSilenceDuration;
+}
+void ConfigManager::setMinSilenceDuration(int value) {
+    QMutexLocker locker(&m_globalMutex);
+    m_minSilenceDuration = value;
+}
+
+int ConfigManager::getTargetPort() const {
+    QMutexLocker locker(&m_globalMutex);
+    return m_targetPort;
+}
+void ConfigManager::setTargetPort(int value) {
+    QMutexLocker locker(&m_globalMutex);
+    m_targetPort = value;
+}
+
+QString ConfigManager::getTargetHost() const {
+    QMutexLocker locker(&m_globalMutex);
+    return m_targetHost;
+}
+void ConfigManager::setTargetHost(const QString& value) {
+    QMutexLocker locker(&m_globalMutex);
+    m_targetHost = value;
+}
+
+QString ConfigManager::getXunFeiAppId() const {
+    QMutexLocker locker(&m_globalMutex);
+    return m_xunFeiAppId;
+}
+void ConfigManager::setXunFeiAppId(const QString& value) {
+    QMutexLocker locker(&m_globalMutex);
+    m_xunFeiAppId = value;
+}
+
+QString ConfigManager::getXunFeiApiSecret() const {
+    QMutexLocker locker(&m_globalMutex);
+    return m_xunFeiApiSecret;
+}
+void ConfigManager::setXunFeiApiSecret(const QString& value) {
+    QMutexLocker locker(&m_globalMutex);
+    m_xunFeiApiSecret = value;
+}
+
+QString ConfigManager::getXunFeiApiKey() const {
+    QMutexLocker locker(&m_globalMutex);
+    return m_xunFeiApiKey;
+}
+void ConfigManager::setXunFeiApiKey(const QString& value) {
+    QMutexLocker locker(&m_globalMutex);
+    m_xunFeiApiKey = value;
+}
+
+QString ConfigManager::getDeepseekApiKey() const {
+    QMutexLocker locker(&m_globalMutex);
+    return m_DeepseekApiKey;
+}
+void ConfigManager::setDeepseekApiKey(const QString& value) {
+    QMutexLocker locker(&m_globalMutex);
+    m_DeepseekApiKey = value;
+}
+
+QString ConfigManager::getTargetLanguage() const {
+    QMutexLocker locker(&m_globalMutex);
+    return m_targetLanguage;
+}
+void ConfigManager::setTargetLanguage(QString value) {
+    QMutexLocker locker(&m_globalMutex);
+    m_targetLanguage = value;
+}
+
+QString ConfigManager::getDevice() const {
+    QMutexLocker locker(&m_globalMutex);
+    return m_device;
+}
+void ConfigManager::setDevice(const QString& value) {
+    QMutexLocker locker(&m_globalMutex);
+    m_device = value;
+}
+bool ConfigManager::getStreamingRecognition() const {
+    QMutexLocker locker(&m_globalMutex);
+    return m_streamingRecognition;
+}
+void ConfigManager::setStreamingRecognition(bool value) {
+    QMutexLocker locker(&m_globalMutex);
+    m_streamingRecognition = value;
+}
+
+int ConfigManager::getMaxRecognitionSessions() const {
+    QMutexLocker locker(&m_globalMutex);
+    return m_maxRecognitionSessions;
+}
+void ConfigManager::setMaxRecognitionSessions(int value) {
+    QMutexLocker locker(&m_globalMutex);
+    m_maxRecognitionSessions = value;
+}
+
+bool ConfigManager::getHighPriorityCapture() const {
+    QMutexLocker locker(&m_globalMutex);
+    return m_highPriorityCapture;
+}
+void ConfigManager::setHighPriorityCapture(bool value) {
+    QMutexLocker locker(&m_globalMutex);
+    m_highPriorityCapture = value;
+}
+
+QString ConfigManager::getVadMode() const {
+    QMutexLocker locker(&m_globalMutex);
+    return m_vadMode;
+}
+void ConfigManager::setVadMode(const QString& value) {
+    QMutexLocker locker(&m_globalMutex);
+    m_vadMode = value;
+}
+
+bool ConfigManager::getAutoVadThreshold() const {
+    QMutexLocker locker(&m_globalMutex);
+    return m_autoVadThreshold;
+}
+void ConfigManager::setAutoVadThreshold(bool value) {
+    QMutexLocker locker(&m_globalMutex);
+    m_autoVadThreshold = value;
+}
+
+int ConfigManager::getPreRollMs() const {
+    QMutexLocker locker(&m_globalMutex);
+    return m_preRollMs;
+}
+void ConfigManager::setPreRollMs(int value) {
+    QMutexLocker locker(&m_globalMutex);
+    m_preRollMs = value;
+}
+
+int ConfigManager::getOnsetMs() const {
+    QMutexLocker locker(&m_globalMutex);
+    return m_onsetMs;
+}
+void ConfigManager::setOnsetMs(int value) {
+    QMutexLocker locker(&m_globalMutex);
+    m_onsetMs = value;
+}
+
+QString ConfigManager::getResamplerQuality() const {
+    QMutexLocker locker(&m_globalMutex);
+    return m_resamplerQuality;
+}
+void ConfigManager::setResamplerQuality(const QString& value) {
+    QMutexLocker locker(&m_globalMutex);
+    m_resamplerQuality = value;
+}
+
+int ConfigManager::getHandoffBatchFrames() const {
+    QMutexLocker locker(&m_globalMutex);
+    return m_handoffBatchFrames;
+}
+void ConfigManager::setHandoffBatchFrames(int value) {
+    QMutexLocker locker(&m_globalMutex);
+    m_handoffBatchFrames = value;
+}
+
+bool ConfigManager::getDynamicCorrection() const {
+    QMutexLocker locker(&m_globalMutex);
+    return m_dynamicCorrection;
+}
+void ConfigManager::setDynamicCorrection(bool value) {
+    QMutexLocker locker(&m_globalMutex);
+    m_dynamicCorrection = value;
+}
+
+bool ConfigManager::getPartialToChatbox() const {
+    QMutexLocker locker(&m_globalMutex);
+    return m_partialToChatbox;
+}
+void ConfigManager::setPartialToChatbox(bool value) {
+    QMutexLocker locker(&m_globalMutex);
+    m_partialToChatbox = value;
+}
+
+int ConfigManager::getPartialChatboxIntervalMs() const {
+    QMutexLocker locker(&m_globalMutex);
+    return m_partialChatboxIntervalMs;
+}
+void ConfigManager::setPartialChatboxIntervalMs(int value) {
+    QMutexLocker locker(&m_globalMutex);
+    m_partialChatboxIntervalMs = value;
+}
+
+bool ConfigManager::getSpeculativeTranslation() const {
+    QMutexLocker locker(&m_globalMutex);
+    return m_speculativeTranslation;
+}
+void ConfigManager::setSpeculativeTranslation(bool value) {
+    QMutexLocker locker(&m_globalMutex);
+    m_speculativeTranslation = value;
+}
+
+bool ConfigManager::getStreamTranslation() const {
+    QMutexLocker locker(&m_globalMutex);
+    return m_streamTranslation;
+}
+void ConfigManager::setStreamTranslation(bool value) {
+    QMutexLocker locker(&m_globalMutex);
+    m_streamTranslation = value;
+}
+
+int ConfigManager::getTranslationMaxInFlight() const {
+    QMutexLocker locker(&m_globalMutex);
+    return m_translationMaxInFlight;
+}
+void ConfigManager::setTranslationMaxInFlight(int value) {
+    QMutexLocker locker(&m_globalMutex);
+    m_translationMaxInFlight = value;
+}
+
+bool ConfigManager::getTranslationCache() const {
+    QMutexLocker locker(&m_globalMutex);
+    return m_translationCache;
+}
+void ConfigManager::setTranslationCache(bool value) {
+    QMutexLocker locker(&m_globalMutex);
+    m_translationCache = value;
+}
+
+int ConfigManager::getTranslationKeepAliveSec() const {
+    QMutexLocker locker(&m_globalMutex);
+    return m_translationKeepAliveSec;
+}
+void ConfigManager::setTranslationKeepAliveSec(int value) {
+    QMutexLocker locker(&m_globalMutex);
+    m_translationKeepAliveSec = value;
+}
+
+int ConfigManager::getChatboxIntervalMs() const {
+    QMutexLocker locker(&m_globalMutex);
+    return m_chatboxIntervalMs;
+}
+void ConfigManager::setChatboxIntervalMs(int value) {
+    QMutexLocker locker(&m_globalMutex);
+    m_chatboxIntervalMs = value;
+}
+
+int ConfigManager::getChatboxPageMs() const {
+    QMutexLocker locker(&m_globalMutex);
+    return m_chatboxPageMs;
+}
+void ConfigManager::setChatboxPageMs(int value) {
+    QMutexLocker locker(&m_globalMutex);
+    m_chatboxPageMs = value;
+}
+
+bool ConfigManager::getMuteGating() const {
+    QMutexLocker locker(&m_globalMutex);
+    return m_muteGating;
+}
+void ConfigManager::setMuteGating(bool value) {
+    QMutexLocker locker(&m_globalMutex);
+    m_muteGating = value;
+}
+
+int ConfigManager::getOscListenPort() const {
+    QMutexLocker locker(&m_globalMutex);
+    return m_oscListenPort;
+}
+void ConfigManager::setOscListenPort(int value) {
+    QMutexLocker locker(&m_globalMutex);
+    m_oscListenPort = value;
+}
+
+bool ConfigManager::getPushToTalk() const {
+    QMutexLocker locker(&m_globalMutex);
+    return m_pushToTalk;
+}
+void ConfigManager::setPushToTalk(bool value) {
+    QMutexLocker locker(&m_globalMutex);
+    m_pushToTalk = value;
+}
+
+QString ConfigManager::getPttHotkey() const {
+    QMutexLocker locker(&m_globalMutex);
+    return m_pttHotkey;
+}
+void ConfigManager::setPttHotkey(const QString& value) {
+    QMutexLocker locker(&m_globalMutex);
+    m_pttHotkey = value;
+}
+
+QString ConfigManager::getPttOscParameter() const {
+    QMutexLocker locker(&m_globalMutex);
+    return m_pttOscParameter;
+}
+void ConfigManager::setPttOscParameter(const QString& value) {
+    QMutexLocker locker(&m_globalMutex);
+    m_pttOscParameter = value;
+}
+
+bool ConfigManager::getAdaptiveEndpoint() const {
+    QMutexLocker locker(&m_globalMutex);
+    return m_adaptiveEndpoint;
+}
+void ConfigManager::setAdaptiveEndpoint(bool value) {
+    QMutexLocker locker(&m_globalMutex);
+    m_adaptiveEndpoint = value;
+}
+
+int ConfigManager::getEndpointMinMs() const {
+    QMutexLocker locker(&m_globalMutex);
+    return m_endpointMinMs;
+}
+void ConfigManager::setEndpointMinMs(int value) {
+    QMutexLocker locker(&m_globalMutex);
+    m_endpointMinMs = value;
+}
+
+int ConfigManager::getSampleRate() const{
+    return 16000;
+}
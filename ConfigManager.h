@@ -1,75 +1,179 @@
-#ifndef CONFIGMANAGER_H
-#define CONFIGMANAGER_H
-
-#include <QObject>
-#include <QMutex>
-#include <QAudioDevice>
-
-class ConfigManager : public QObject
-{
-    Q_OBJECT
-
-private:
-    explicit ConfigManager(QObject *parent = nullptr);
-
-    // 全局唯一静态锁
-    static QMutex m_globalMutex;
-
-    double m_vadThreshold;
-    int    m_minSilenceDuration;
-    int    m_targetPort;
-    QString m_targetHost;
-    QString m_xunFeiAppId;
-    QString m_xunFeiApiSecret;
-    QString m_xunFeiApiKey;
-    QString m_DeepseekApiKey;
-    QString m_targetLanguage;
-    QString m_device;
-
-    int     sampleRate;
-
-public:
-    static ConfigManager& getInstance();
-
-    // 禁止拷贝
-    ConfigManager(const ConfigManager&) = delete;
-    ConfigManager& operator=(const ConfigManager&) = delete;
-
-    // 配置读写
-    void loadFileToManager();
-    void loadManagerToFile();
-
-    double getVadThreshold() const;
-    void setVadThreshold(double value);
-
-    int getMinSilenceDuration() const;
-    void setMinSilenceDuration(int value);
-
-    int getTargetPort() const;
-    void setTargetPort(int value);
-
-    QString getTargetHost() const;
-    void setTargetHost(const QString& value);
-
-    QString getXunFeiAppId() const;
-    void setXunFeiAppId(const QString& value);
-
-    QString getXunFeiApiSecret() const;
-    void setXunFeiApiSecret(const QString& value);
-
-    QString getXunFeiApiKey() const;
-    void setXunFeiApiKey(const QString& value);
-
-    QString getDeepseekApiKey() const;
-    void setDeepseekApiKey(const QString& value);
-
-    QString getTargetLanguage() const;
-    void setTargetLanguage(QString value);
-
-    QString getDevice() const;
-    void setDevice(const QString& value);
-
-    int getSampleRate() const;
-};
-
-#endif
+#ifndef CONFIGMANAGER_H
+#define CONFIGMANAGER_H
+
+#include <QObject>
+#include <QMutex>
+#include <QAudioDevice>
+
+class ConfigManager : public QObject
+{
+    Q_OBJECT
+
+private:
+    explicit ConfigManager(QObject *parent = nullptr);
+
+    // 全局唯一静态锁
+    static QMutex m_globalMutex;
+
+    double m_vadThreshold;
+    int    m_minSilenceDuration;
+    int    m_targetPort;
+    QString m_targetHost;
+    QString m_xunFeiAppId;
+    QString m_xunFeiApiSecret;
+    QString m_xunFeiApiKey;
+    QString m_DeepseekApiKey;
+    QString m_targetLanguage;
+    QString m_device;
+    bool    m_streamingRecognition;
+    int     m_maxRecognitionSessions;
+    bool    m_highPriorityCapture;
+    QString m_vadMode;
+    bool    m_autoVadThreshold;
+    int     m_preRollMs;
+    int     m_onsetMs;
+    QString m_resamplerQuality;
+    int     m_handoffBatchFrames;
+    bool    m_dynamicCorrection;
+    bool    m_partialToChatbox;
+    int     m_partialChatboxIntervalMs;
+    bool    m_speculativeTranslation;
+    bool    m_streamTranslation;
+    int     m_translationMaxInFlight;
+    bool    m_translationCache;
+    int     m_translationKeepAliveSec;
+    int     m_chatboxIntervalMs;
+    int     m_chatboxPageMs;
+    bool    m_muteGating;
+    int     m_oscListenPort;
+    bool    m_pushToTalk;
+    QString m_pttHotkey;
+    QString m_pttOscParameter;
+    bool    m_adaptiveEndpoint;
+    int     m_endpointMinMs;
+
+    int     sampleRate;
+
+public:
+    static ConfigManager& getInstance();
+
+    // 禁止拷贝
+    ConfigManager(const ConfigManager&) = delete;
+    ConfigManager& operator=(const ConfigManager&) = delete;
+
+    // 配置读写
+    void loadFileToManager();
+    void loadManagerToFile();
+
+    double getVadThreshold() const;
+    void setVadThreshold(double value);
+
+    int getMinSilenceDuration() const;
+    void setMinSilenceDuration(int value);
+
+    int getTargetPort() const;
+    void setTargetPort(int value);
+
+    QString getTargetHost() const;
+    void setTargetHost(const QString& value);
+
+    QString getXunFeiAppId() const;
+    void setXunFeiAppId(const QString& value);
+
+    QString getXunFeiApiSecret() const;
+    void setXunFeiApiSecret(const QString& value);
+
+    QString getXunFeiApiKey() const;
+    void setXunFeiApiKey(const QString& value);
+
+    QString getDeepseekApiKey() const;
+    void setDeepseekApiKey(const QString& value);
+
+    QString getTargetLanguage() const;
+    void setTargetLanguage(QString value);
+
+    QString getDevice() const;
+    void setDevice(const QString& value);
+
+    bool getStreamingRecognition() const;
+    void setStreamingRecognition(bool value);
+
+    int getMaxRecognitionSessions() const;
+    void setMaxRecognitionSessions(int value);
+
+    bool getHighPriorityCapture() const;
+    void setHighPriorityCapture(bool value);
+
+    QString getVadMode() const;
+    void setVadMode(const QString& value);
+
+    bool getAutoVadThreshold() const;
+    void setAutoVadThreshold(bool value);
+
+    int getPreRollMs() const;
+    void setPreRollMs(int value);
+
+    int getOnsetMs() const;
+    void setOnsetMs(int value);
+
+    QString getResamplerQuality() const;
+    void setResamplerQuality(const QString& value);
+
+    int getHandoffBatchFrames() const;
+    void setHandoffBatchFrames(int value);
+
+    bool getDynamicCorrection() const;
+    void setDynamicCorrection(bool value);
+
+    bool getPartialToChatbox() const;
+    void setPartialToChatbox(bool value);
+
+    int getPartialChatboxIntervalMs() const;
+    void setPartialChatboxIntervalMs(int value);
+
+    bool getSpeculativeTranslation() const;
+    void setSpeculativeTranslation(bool value);
+
+    bool getStreamTranslation() const;
+    void setStreamTranslation(bool value);
+
+    int getTranslationMaxInFlight() const;
+    void setTranslationMaxInFlight(int value);
+
+    bool getTranslationCache() const;
+    void setTranslationCache(bool value);
+
+    int getTranslationKeepAliveSec() const;
+    void setTranslationKeepAliveSec(int value);
+
+    int getChatboxIntervalMs() const;
+    void setChatboxIntervalMs(int value);
+
+    int getChatboxPageMs() const;
+    void setChatboxPageMs(int value);
+
+    bool getMuteGating() const;
+    void setMuteGating(bool value);
+
+    int getOscListenPort() const;
+    void setOscListenPort(int value);
+
+    bool getPushToTalk() const;
+    void setPushToTalk(bool value);
+
+    QString getPttHotkey() const;
+    void setPttHotkey(const QString& value);
+
+    QString getPttOscParameter() const;
+    void setPttOscParameter(const QString& value);
+
+    bool getAdaptiveEndpoint() const;
+    void setAdaptiveEndpoint(bool value);
+
+    int getEndpointMinMs() const;
+    void setEndpointMinMs(int value);
+
+    int getSampleRate() const;
+};
+
+#endif
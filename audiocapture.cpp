@@ -1,228 +1,759 @@
-#include "AudioCapture.h"
-#include "ConfigManager.h"
-#include <QMediaDevices>
-#include <QAudioDevice>
-#include <cmath>
-#include <QDebug>
-
-// ─────────────────────────────────────────────────────────────────────────────
-// 构造 / 析构
-// ─────────────────────────────────────────────────────────────────────────────
-
-AudioCapture::AudioCapture(QObject *parent)
-    : QObject(parent)
-{
-}
-
-AudioCapture::~AudioCapture()
-{
-    stop();
-}
-
-// ─────────────────────────────────────────────────────────────────────────────
-// initialize()
-// ─────────────────────────────────────────────────────────────────────────────
-void AudioCapture::initialize()
-{
-    ConfigManager &cfg = ConfigManager::getInstance();
-    m_vadThreshold         = cfg.getVadThreshold();
-    m_minSilenceDurationMs = cfg.getMinSilenceDuration();
-    m_maxSilenceFrames     = m_minSilenceDurationMs / FRAME_MS;
-
-    emit debug(QString("AudioCapture: 触发阈值: %1, 断句时长: %2ms")
-                   .arg(m_vadThreshold, 0, 'f', 4)
-                   .arg(m_minSilenceDurationMs));
-
-    // ── 选择音频输入设备 ─────────────────────────────────────────────────────
-    QAudioDevice selectedDevice;
-    const QString deviceName = cfg.getDevice();
-    for (const QAudioDevice &d : QMediaDevices::audioInputs()) {
-        if (d.description() == deviceName) {
-            selectedDevice = d;
-            break;
-        }
-    }
-    if (selectedDevice.isNull()) {
-        selectedDevice = QMediaDevices::defaultAudioInput();
-    }
-
-    // ── 配置音频格式：16kHz / 16bit / 单声道（讯飞要求）────────────────────
-    m_format.setSampleRate(16000);
-    m_format.setChannelCount(1);
-    m_format.setSampleFormat(QAudioFormat::Int16);
-
-    if (!selectedDevice.isFormatSupported(m_format)) {
-        emit error("AudioCapture: audio format (16kHz/16bit/mono) not supported by device");
-        return;
-    }
-
-    // ── 创建 QAudioSource ─────────────────────────────────────────────────────
-    m_audioSource = new QAudioSource(selectedDevice, m_format, this);
-
-    // 【关键】设置足够大的硬件缓冲区（约 200ms = 6400 字节），
-    // 防止定时器触发时缓冲区还没来得及积累满 1280 字节，导致 read() 返回零值数据。
-    m_audioSource->setBufferSize(6400);
-
-    // pull 模式启动：我们主动调用 read() 拉取数据
-    m_audioDevice = m_audioSource->start();
-    if (!m_audioDevice) {
-        emit error("AudioCapture: failed to start audio source");
-        return;
-    }
-
-    // 清空内部积累缓冲区
-    m_accumBuffer.clear();
-
-    // ── 启动采样定时器 ────────────────────────────────────────────────────────
-    m_sampleTimer = new QTimer(this);
-    connect(m_sampleTimer, &QTimer::timeout,
-            this, &AudioCapture::onTimerTimeout);
-    m_sampleTimer->start(FRAME_MS);
-
-    resetState();
-}
-
-// ─────────────────────────────────────────────────────────────────────────────
-// stop()
-// ─────────────────────────────────────────────────────────────────────────────
-void AudioCapture::stop()
-{
-    if (m_sampleTimer) {
-        m_sampleTimer->stop();
-    }
-    if (m_audioSource) {
-        m_audioSource->stop();
-        m_audioDevice = nullptr;
-    }
-    m_accumBuffer.clear();
-    resetState();
-}
-
-// ─────────────────────────────────────────────────────────────────────────────
-// resetState()
-// ─────────────────────────────────────────────────────────────────────────────
-void AudioCapture::resetState()
-{
-    m_state               = RecordingState::Idle;
-    m_bufferQueue.clear();
-    m_silenceFrameCount   = 0;
-    m_recordingFrameCount = 0;
-}
-
-// ─────────────────────────────────────────────────────────────────────────────
-// calculateRMS() — 计算 PCM 16bit 音频帧的归一化 RMS 值（0.0 ~ 1.0）
-// ─────────────────────────────────────────────────────────────────────────────
-float AudioCapture::calculateRMS(const QByteArray &data)
-{
-    const int16_t *samples = reinterpret_cast<const int16_t*>(data.constData());
-    const int      count   = data.size() / 2;
-    if (count == 0) return 0.0f;
-
-    double sumSquares = 0.0;
-    for (int i = 0; i < count; ++i) {
-        double s = static_cast<double>(samples[i]);
-        sumSquares += s * s;
-    }
-    // 除以 32768.0 归一化到 [0.0, 1.0]
-    return static_cast<float>(std::sqrt(sumSquares / count) / 32768.0);
-}
-
-// ─────────────────────────────────────────────────────────────────────────────
-// processFrame() — 对一个完整的 FRAME_SIZE 字节帧执行 VAD 状态机
-// 从 onTimerTimeout() 中拆分出来，保持每个函数职责单一
-// ─────────────────────────────────────────────────────────────────────────────
-void AudioCapture::processFrame(const QByteArray &frame)
-{
-    const float rms      = calculateRMS(frame);
-    const bool  hasVoice = (rms > static_cast<float>(m_vadThreshold));
-
-    switch (m_state) {
-
-    // ── Idle：等待第一帧语音 ─────────────────────────────────────────────────
-    case RecordingState::Idle:
-        if (hasVoice) {
-            m_state = RecordingState::Buffering;
-            m_bufferQueue.clear();
-            m_bufferQueue.append(frame);
-            m_silenceFrameCount = 0;
-        }
-        break;
-
-    // ── Buffering：预积累阶段，达到阈值才触发识别 ────────────────────────────
-    case RecordingState::Buffering:
-        if (hasVoice) {
-            m_bufferQueue.append(frame);
-            m_silenceFrameCount = 0;
-
-            if (m_bufferQueue.size() >= MIN_FRAMES_TO_TRIGGER) {
-                emit startRecognition();
-                emit debug("检测到语音");
-                for (const QByteArray &f : m_bufferQueue)
-                    emit sendAudioChunk(f);
-                m_bufferQueue.clear();
-                m_state               = RecordingState::Recording;
-                m_silenceFrameCount   = 0;
-                m_recordingFrameCount = MIN_FRAMES_TO_TRIGGER;
-            }
-        } else {
-            m_silenceFrameCount++;
-            if (m_silenceFrameCount > 3) {
-                m_bufferQueue.clear();
-                m_silenceFrameCount = 0;
-                m_state = RecordingState::Idle;
-            }
-        }
-        break;
-
-    // ── Recording：持续发送阶段 ──────────────────────────────────────────────
-    case RecordingState::Recording:
-
-        emit sendAudioChunk(frame);
-        
-        if (hasVoice) {
-            m_silenceFrameCount = 0;
-        } else {
-            m_silenceFrameCount++;
-            if (m_silenceFrameCount >= m_maxSilenceFrames) {
-                emit stopRecognition();
-                emit debug("正在识别");
-                m_state               = RecordingState::Idle;
-                m_silenceFrameCount   = 0;
-                m_recordingFrameCount = 0;
-                return;
-            }
-        }
-
-        // 超过最长录制时长60s，强制结束本句
-        ++m_recordingFrameCount;
-        if (m_recordingFrameCount >= MAX_RECORDING_FRAMES) {
-            emit stopRecognition();
-            emit debug("正在识别");
-            m_state               = RecordingState::Idle;
-            m_silenceFrameCount   = 0;
-            m_recordingFrameCount = 0;
-        }
-        break;
-    }
-}
-
-void AudioCapture::onTimerTimeout()
-{
-    if (!m_audioDevice) return;
-
-    // 读取硬件缓冲区中所有已就绪的数据
-    const qint64 available = m_audioDevice->bytesAvailable();
-    if (available > 0) {
-        const QByteArray newData = m_audioDevice->read(available);
-        if (!newData.isEmpty()) {
-            m_accumBuffer.append(newData);
-        }
-    }
-
-    // 从积累缓冲区切出完整帧逐帧处理
-    while (m_accumBuffer.size() >= FRAME_SIZE) {
-        const QByteArray frame = m_accumBuffer.left(FRAME_SIZE);
-        m_accumBuffer.remove(0, FRAME_SIZE);
-        processFrame(frame);
-    }
-}
+#include "AudioCapture.h"
+#include "ConfigManager.h"
+#include "dspkernels.h"
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <QMediaDevices>
+#include <QAudioDevice>
+#include <QDebug>
+
+// ─────────────────────────────────────────────────────────────────────────────
+// 构造 / 析构
+// ─────────────────────────────────────────────────────────────────────────────
+
+AudioCapture::AudioCapture(QObject *parent)
+    : QObject(parent)
+    , m_ring(RING_FRAMES * FRAME_SIZE)
+{
+}
+
+AudioCapture::~AudioCapture()
+{
+    stop();
+}
+
+void AudioCapture::setHandoffQueue(AudioHandoffQueue *queue)
+{
+    m_handoff = queue;
+}
+
+void AudioCapture::setFramePool(AudioFramePool *pool)
+{
+    m_framePool = pool;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// initialize()
+// ─────────────────────────────────────────────────────────────────────────────
+void AudioCapture::initialize()
+{
+    ConfigManager &cfg = ConfigManager::getInstance();
+    m_vadThreshold         = cfg.getVadThreshold();
+    m_autoThreshold        = cfg.getAutoVadThreshold();
+    m_minSilenceDurationMs = cfg.getMinSilenceDuration();
+    m_maxSilenceFrames     = m_minSilenceDurationMs / FRAME_MS;
+    m_preRollFrames        = qMax(0, cfg.getPreRollMs() / FRAME_MS);
+    m_onsetFrames          = qMax(1, cfg.getOnsetMs() / FRAME_MS);
+    m_batchFrames          = qBound(1, cfg.getHandoffBatchFrames(), 8);
+    m_unsignalledFrames    = 0;
+    m_pushToTalk           = cfg.getPushToTalk();
+    m_adaptiveEndpoint     = cfg.getAdaptiveEndpoint();
+    // 自适应断句：下限取 endpointMinMs，上限为固定断句时长的两倍（最多 2s）
+    const int minEndpointFrames = qBound(1, cfg.getEndpointMinMs() / FRAME_MS, qMax(1, m_maxSilenceFrames));
+    const int maxEndpointFrames = qMax(m_maxSilenceFrames, qMin(m_maxSilenceFrames * 2, MAX_ENDPOINT_FRAMES));
+    m_endpointer.configure(m_maxSilenceFrames, minEndpointFrames, maxEndpointFrames, m_adaptiveEndpoint);
+    m_endpointer.reset();
+    m_hasLastEnd           = false;
+    m_onsetGapFrames       = -1;
+    m_hasCurrentSession    = false;
+    m_pttHeld              = false;
+
+    emit debug(QString("AudioCapture: 触发阈值: %1, 断句时长: %2ms, 起始确认: %3ms, 预录: %4ms")
+                   .arg(m_vadThreshold, 0, 'f', 4)
+                   .arg(m_minSilenceDurationMs)
+                   .arg(m_onsetFrames * FRAME_MS)
+                   .arg(m_preRollFrames * FRAME_MS));
+    if (m_autoThreshold) {
+        emit debug("AudioCapture: 自适应阈值已开启，将随环境噪声调整");
+    }
+    emit debug(QString("AudioCapture: DSP 内核: %1").arg(Dsp::kernels().name));
+    if (m_pushToTalk) {
+        emit debug("AudioCapture: 按键说话模式，按住说话、松开立即识别");
+    } else if (m_adaptiveEndpoint) {
+        emit debug(QString("AudioCapture: 自适应断句已开启，静音超时 %1–%2ms")
+                       .arg(minEndpointFrames * FRAME_MS).arg(maxEndpointFrames * FRAME_MS));
+    }
+
+    // 语音检测器：rms 为原有的音量阈值规则，spectral 为多特征检测
+    m_vad = createVoiceActivityDetector(cfg.getVadMode(), m_vadThreshold);
+    m_reportedVadOverruns = 0;
+    emit debug(QString("AudioCapture: VAD 模式: %1").arg(m_vad->name()));
+
+    // ── 选择音频输入设备 ─────────────────────────────────────────────────────
+    QAudioDevice selectedDevice;
+    const QString deviceName = cfg.getDevice();
+    for (const QAudioDevice &d : QMediaDevices::audioInputs()) {
+        if (d.description() == deviceName) {
+            selectedDevice = d;
+            break;
+        }
+    }
+    if (selectedDevice.isNull()) {
+        selectedDevice = QMediaDevices::defaultAudioInput();
+    }
+
+    // ── 配置音频格式：优先 16kHz / 16bit / 单声道，否则按设备原生格式转换 ────
+    if (!setupFormat(selectedDevice)) {
+        return;
+    }
+
+    // ── 创建 QAudioSource ─────────────────────────────────────────────────────
+    m_audioSource = new QAudioSource(selectedDevice, m_format, this);
+
+    // 硬件缓冲区约 200ms（16kHz/16bit/单声道时为 6400 字节），为事件循环偶发的延迟留出余量
+    m_audioSource->setBufferSize(m_converting ? m_format.bytesForDuration(HW_BUFFER_MS * 1000)
+                                              : HW_BUFFER_BYTES);
+
+    // 清空环形缓冲区与统计
+    m_ring.reset();
+    m_droppedBytes   = 0;
+    m_framesCaptured = 0;
+    m_maxReadGapMs   = 0;
+    m_lateReads      = 0;
+    m_readClock.start();
+    m_noiseFloor.reset();
+    m_noiseReportCounter = 0;
+    m_calibrationFrames  = 0;
+    m_calibrationRms.clear();
+    m_calibrationRms.reserve(CALIBRATION_FRAMES);
+
+    // 预录环：起始确认最长经历 m_onsetFrames 个语音帧，每个之间至多 ONSET_GAP_FRAMES 个静音帧
+    m_preRollCapacity = m_preRollFrames + m_onsetFrames * (ONSET_GAP_FRAMES + 1);
+    m_preRoll.assign(static_cast<size_t>(m_preRollCapacity), AudioFrameRef());
+    resetState();
+
+    // 事件驱动：设备每有一批新数据就触发 readyRead，不再按 40ms 定时轮询
+    m_audioDevice = m_audioSource->start();
+    if (!m_audioDevice) {
+        emit error("AudioCapture: failed to start audio source");
+        return;
+    }
+    connect(m_audioDevice, &QIODevice::readyRead,
+            this, &AudioCapture::onReadyRead);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// setupFormat() — 讯飞要求 16kHz / 16bit / 单声道；设备不支持时以其首选格式打开，
+// 由 AudioConverter 做格式转换、混音和重采样
+// ─────────────────────────────────────────────────────────────────────────────
+bool AudioCapture::setupFormat(const QAudioDevice &device)
+{
+    const int outRate = ConfigManager::getInstance().getSampleRate();
+
+    m_format = QAudioFormat();
+    m_format.setSampleRate(outRate);
+    m_format.setChannelCount(1);
+    m_format.setSampleFormat(QAudioFormat::Int16);
+
+    m_converting = !device.isFormatSupported(m_format);
+    if (!m_converting) {
+        return true;
+    }
+
+    m_format = device.preferredFormat();
+
+    AudioConverter::Format in;
+    in.sampleRate = m_format.sampleRate();
+    in.channels   = m_format.channelCount();
+    switch (m_format.sampleFormat()) {
+    case QAudioFormat::UInt8: in.sampleFormat = AudioConverter::SampleFormat::UInt8; break;
+    case QAudioFormat::Int16: in.sampleFormat = AudioConverter::SampleFormat::Int16; break;
+    case QAudioFormat::Int32: in.sampleFormat = AudioConverter::SampleFormat::Int32; break;
+    case QAudioFormat::Float: in.sampleFormat = AudioConverter::SampleFormat::Float; break;
+    default:
+        emit error("AudioCapture: unsupported device sample format");
+        return false;
+    }
+    if (in.sampleRate <= 0 || in.channels <= 0) {
+        emit error("AudioCapture: invalid device audio format");
+        return false;
+    }
+
+    const AudioConverter::Quality quality = AudioConverter::qualityFromName(
+        ConfigManager::getInstance().getResamplerQuality().toStdString());
+    const int blockFrames = in.sampleRate * CONVERT_BLOCK_MS / 1000;
+    m_converter.configure(in, outRate, quality, blockFrames);
+
+    m_rawBuffer.assign(static_cast<size_t>(blockFrames) * m_converter.bytesPerFrame(), 0);
+    m_rawPending = 0;
+    m_convertBuffer.assign(static_cast<size_t>(m_converter.maxOutputSamples(blockFrames)), 0);
+
+    emit debug(QString("AudioCapture: 设备原生格式 %1Hz/%2ch/%3bit，转换为 %4Hz 单声道（质量: %5）")
+                   .arg(in.sampleRate)
+                   .arg(in.channels)
+                   .arg(m_format.bytesPerSample() * 8)
+                   .arg(outRate)
+                   .arg(AudioConverter::qualityName(quality)));
+    return true;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// stop()
+// ─────────────────────────────────────────────────────────────────────────────
+void AudioCapture::stop()
+{
+    if (m_audioSource) {
+        m_audioSource->stop();
+        m_audioSource->deleteLater();
+        m_audioSource = nullptr;
+        m_audioDevice = nullptr;
+    }
+    if (m_droppedBytes > 0) {
+        emit debug(QString("AudioCapture: 缓冲区溢出丢弃 %1 字节").arg(m_droppedBytes));
+        m_droppedBytes = 0;
+    }
+    m_ring.reset();
+    resetState();
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// calibrate() — 请用户保持安静，采集一段环境噪声后设定阈值
+// ─────────────────────────────────────────────────────────────────────────────
+void AudioCapture::calibrate()
+{
+    if (!m_audioDevice) {
+        emit error("AudioCapture: 请先启动再校准");
+        return;
+    }
+    m_calibrationRms.clear();
+    m_calibrationFrames = CALIBRATION_FRAMES;
+    emit debug(QString("AudioCapture: 开始校准，请保持安静 %1 秒").arg(CALIBRATION_FRAMES * FRAME_MS / 1000));
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// applyThreshold() — 更新生效阈值并同步给 VAD
+// ─────────────────────────────────────────────────────────────────────────────
+void AudioCapture::applyThreshold(double threshold)
+{
+    m_vadThreshold = std::clamp(threshold, MIN_THRESHOLD, MAX_THRESHOLD);
+    if (m_vad) {
+        m_vad->setThreshold(m_vadThreshold);
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// updateNoiseFloor() — 每帧调用：跟踪噪声底，按需调整阈值，处理校准
+// ─────────────────────────────────────────────────────────────────────────────
+void AudioCapture::updateNoiseFloor(float rms)
+{
+    m_noiseFloor.update(rms);
+
+    if (m_calibrationFrames > 0) {
+        m_calibrationRms.push_back(rms);
+        if (--m_calibrationFrames == 0) {
+            // 取 90 分位而不是最大值，偶发的一声咳嗽不会把阈值抬得过高
+            const auto p90 = m_calibrationRms.begin() + (m_calibrationRms.size() * 9) / 10;
+            std::nth_element(m_calibrationRms.begin(), p90, m_calibrationRms.end());
+            applyThreshold(*p90 * CALIBRATION_MARGIN);
+            emit debug(QString("AudioCapture: 校准完成，阈值: %1").arg(m_vadThreshold, 0, 'f', 4));
+            emit thresholdCalibrated(m_vadThreshold);
+        }
+    } else if (m_autoThreshold && m_noiseFloor.isReady() && m_state == RecordingState::Idle) {
+        // 只在空闲时调整，避免一句话说到一半阈值变化导致提前断句
+        applyThreshold(m_noiseFloor.floor() * ADAPTIVE_MARGIN);
+    }
+
+    if (++m_noiseReportCounter >= NOISE_REPORT_FRAMES) {
+        m_noiseReportCounter = 0;
+        emit noiseFloorChanged(m_noiseFloor.floor(), m_vadThreshold);
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// resetState()
+// ─────────────────────────────────────────────────────────────────────────────
+void AudioCapture::resetState()
+{
+    m_state                 = RecordingState::Idle;
+    m_silenceFrameCount     = 0;
+    m_recordingFrameCount   = 0;
+    m_bufferingFrames       = 0;
+    m_onsetVoicedFrames     = 0;
+    m_utteranceVoicedFrames = 0;
+    m_preRollHead           = 0;
+    m_preRollCount          = 0;
+    std::fill(m_preRoll.begin(), m_preRoll.end(), AudioFrameRef());
+    if (m_vad) {
+        m_vad->reset();
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// captureFrame() — 环形缓冲区中的一帧拷入帧池，之后只传递引用
+// ─────────────────────────────────────────────────────────────────────────────
+AudioFrameRef AudioCapture::captureFrame(const QByteArray &frame)
+{
+    if (!m_framePool) return AudioFrameRef();
+
+    AudioFrameRef ref = m_framePool->acquire();
+    if (!ref.isNull()) {
+        memcpy(ref.data(), frame.constData(), FRAME_SIZE);
+        ref.setSize(FRAME_SIZE);
+    }
+    return ref;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// pushPreRoll() / deliverPreRoll() — 预录环读写
+// 覆盖最旧的句柄即把那一帧归还帧池，稳态下取一还一
+// ─────────────────────────────────────────────────────────────────────────────
+void AudioCapture::pushPreRoll(const QByteArray &frame)
+{
+    if (m_preRollCapacity == 0) return;
+
+    m_preRoll[m_preRollHead] = AudioFrameRef();   // 先归还，再取新帧
+    m_preRoll[m_preRollHead] = captureFrame(frame);
+    m_preRollHead  = (m_preRollHead + 1) % m_preRollCapacity;
+    m_preRollCount = qMin(m_preRollCount + 1, m_preRollCapacity);
+}
+
+void AudioCapture::deliverPreRoll(int frames)
+{
+    const int n = qMin(frames, m_preRollCount);
+    if (n > 0) {
+        const int first = (m_preRollHead - n + m_preRollCapacity) % m_preRollCapacity;
+        for (int i = 0; i < n; ++i) {
+            deliver(AudioEvent::Type::Chunk, m_preRoll[(first + i) % m_preRollCapacity]);
+        }
+        if (m_handoff && m_unsignalledFrames > 0) {
+            wakeConsumer();
+        }
+    }
+    std::fill(m_preRoll.begin(), m_preRoll.end(), AudioFrameRef());
+    m_preRollHead  = 0;
+    m_preRollCount = 0;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// startUtterance() — 起始确认通过：开始识别，先补发预录环中的音频
+// ─────────────────────────────────────────────────────────────────────────────
+void AudioCapture::startUtterance()
+{
+    deliver(AudioEvent::Type::Start);
+    emit debug("检测到语音");
+
+    // Buffering 期间的帧加上之前 preRollMs 的音频，保住句首
+    deliverPreRoll(m_bufferingFrames + m_preRollFrames);
+
+    m_state                 = RecordingState::Recording;
+    m_silenceFrameCount     = 0;
+    m_recordingFrameCount   = m_bufferingFrames;
+    m_utteranceVoicedFrames = m_onsetVoicedFrames;
+
+    m_endpointer.beginUtterance(m_onsetGapFrames);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// endUtterance() — 静音达到断句时长：语音太短说明是误触发，取消识别
+// ─────────────────────────────────────────────────────────────────────────────
+void AudioCapture::endUtterance()
+{
+    const bool accepted = m_utteranceVoicedFrames >= MIN_UTTERANCE_FRAMES;
+    if (!accepted) {
+        deliver(AudioEvent::Type::Cancel);
+        emit debug("误触发，已取消");
+    } else {
+        deliver(AudioEvent::Type::Stop);
+        emit debug("正在识别");
+    }
+    m_endpointer.endUtterance(accepted);
+    if (accepted) {
+        m_lastEndFrame = m_framesCaptured;
+        m_hasLastEnd   = true;
+        if (m_adaptiveEndpoint) {
+            reportEndpoint();
+        }
+    }
+    m_state                 = RecordingState::Idle;
+    m_silenceFrameCount     = 0;
+    m_recordingFrameCount   = 0;
+    m_utteranceVoicedFrames = 0;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// reportEndpoint() — 输出本次断句的依据，供调整 endpointMinMs / minSilenceDuration 参考
+// ─────────────────────────────────────────────────────────────────────────────
+void AudioCapture::reportEndpoint()
+{
+    const Endpointer::Decision &d = m_endpointer.decision();
+    emit debug(QString("断句: 静音 %1ms（超时 %2ms = 基准 %3ms × 语速 %4 × 能量 %5 × 短句 %6 × 标点 %7）"
+                       "，停顿样本 %8，疑似误断 %9/%10")
+                   .arg(m_endpointer.silenceFrames() * FRAME_MS)
+                   .arg(d.timeoutFrames * FRAME_MS)
+                   .arg(d.baseFrames * FRAME_MS)
+                   .arg(d.rateFactor, 0, 'f', 2)
+                   .arg(d.energyFactor, 0, 'f', 2)
+                   .arg(d.shortFactor, 0, 'f', 2)
+                   .arg(d.punctuationFactor, 0, 'f', 2)
+                   .arg(m_endpointer.pauseSamples())
+                   .arg(m_endpointer.suspectedSplits())
+                   .arg(m_endpointer.utterances()));
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// processFrame() — 对一个完整的 FRAME_SIZE 字节帧执行 VAD 状态机
+// frame 直接指向环形缓冲区内部，处理完即被覆盖：
+// 需要保留的帧（预录环、发往识别线程）拷入帧池一次，之后只传递引用
+// ─────────────────────────────────────────────────────────────────────────────
+void AudioCapture::processFrame(const QByteArray &frame)
+{
+    if (m_pushToTalk) {
+        processPushToTalkFrame(frame);
+        return;
+    }
+
+    const int16_t *samples = reinterpret_cast<const int16_t*>(frame.constData());
+    const int      count   = static_cast<int>(frame.size() / 2);
+
+    const float rms = Dsp::rms(samples, count);
+    updateNoiseFloor(rms);
+    const bool hasVoice = m_vad && m_vad->isSpeech(samples, count);
+
+    switch (m_state) {
+
+    // ── Idle：等待第一帧语音，同时持续写入预录环 ──────────────────────────────
+    case RecordingState::Idle:
+        pushPreRoll(frame);
+        if (hasVoice) {
+            m_state             = RecordingState::Buffering;
+            m_bufferingFrames   = 1;
+            m_onsetVoicedFrames = 1;
+            m_silenceFrameCount = 0;
+            // 距上一句结束的间隔，用于判断上一句是否断得太早
+            m_onsetGapFrames = m_hasLastEnd
+                                   ? int(qMin<quint64>(m_framesCaptured - m_lastEndFrame, INT_MAX))
+                                   : -1;
+            emit speechOnset();
+
+            if (m_onsetVoicedFrames >= m_onsetFrames) {
+                startUtterance();
+            }
+        }
+        break;
+
+    // ── Buffering：起始确认，语音帧达到 m_onsetFrames 即触发识别 ─────────────
+    case RecordingState::Buffering:
+        pushPreRoll(frame);
+        ++m_bufferingFrames;
+        if (hasVoice) {
+            ++m_onsetVoicedFrames;
+            m_silenceFrameCount = 0;
+
+            if (m_onsetVoicedFrames >= m_onsetFrames) {
+                startUtterance();
+            }
+        } else {
+            m_silenceFrameCount++;
+            if (m_silenceFrameCount > ONSET_GAP_FRAMES) {
+                // 未通过确认：回到 Idle。音频仍留在预录环中，
+                // 紧接着的语音触发时会一并补发，短词不会被丢掉
+                m_silenceFrameCount = 0;
+                m_state = RecordingState::Idle;
+            }
+        }
+        break;
+
+    // ── Recording：持续发送阶段 ──────────────────────────────────────────────
+    case RecordingState::Recording:
+
+        deliver(AudioEvent::Type::Chunk, captureFrame(frame));
+
+        if (hasVoice) {
+            ++m_utteranceVoicedFrames;
+        }
+        // 静音超时由 Endpointer 决定（关闭自适应时即固定的 minSilenceDuration）
+        if (m_endpointer.update(hasVoice, rms)) {
+            endUtterance();
+            return;
+        }
+
+        // 超过最长录制时长60s，强制结束本句
+        ++m_recordingFrameCount;
+        if (m_recordingFrameCount >= MAX_RECORDING_FRAMES) {
+            deliver(AudioEvent::Type::Stop);
+            emit debug("正在识别");
+            m_endpointer.endUtterance(false);   // 强制结束不代表停顿，不计入统计
+            m_state                 = RecordingState::Idle;
+            m_silenceFrameCount     = 0;
+            m_recordingFrameCount   = 0;
+            m_utteranceVoicedFrames = 0;
+        }
+        break;
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// processPushToTalkFrame() — 按键说话模式下的逐帧处理
+// 不计算 RMS、不更新噪声底、不跑 VAD；未按下时只写预录环，按下时原样发送
+// ─────────────────────────────────────────────────────────────────────────────
+void AudioCapture::processPushToTalkFrame(const QByteArray &frame)
+{
+    if (m_state != RecordingState::Recording) {
+        pushPreRoll(frame);
+        return;
+    }
+
+    deliver(AudioEvent::Type::Chunk, captureFrame(frame));
+
+    // 按住超过最长录制时长：结束本句并立即接着开始下一句，按键仍然有效
+    if (++m_recordingFrameCount >= MAX_RECORDING_FRAMES) {
+        deliver(AudioEvent::Type::Stop);
+        deliver(AudioEvent::Type::Start);
+        emit debug("正在识别");
+        m_recordingFrameCount = 0;
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// onReadyRead() — 设备数据就绪
+// 生产者：把设备数据写进环形缓冲区（直接读入，或转换后写入）
+// 消费者：按整帧原地切出，处理完立即释放空间
+// ─────────────────────────────────────────────────────────────────────────────
+void AudioCapture::onReadyRead()
+{
+    if (!m_audioDevice) return;
+
+    // readyRead 间隔超过硬件缓冲区时长，说明采集线程被阻塞过，可能已发生硬件溢出
+    const int gapMs = static_cast<int>(m_readClock.restart());
+    m_maxReadGapMs = qMax(m_maxReadGapMs, gapMs);
+    if (gapMs >= HW_BUFFER_MS) {
+        ++m_lateReads;
+    }
+
+    if (m_converting) {
+        readConverted();
+    } else {
+        readDirect();
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// readDirect() — 直接 read() 进环形缓冲区的空闲区域（最多分两段，跨越环尾时）
+// ─────────────────────────────────────────────────────────────────────────────
+void AudioCapture::readDirect()
+{
+    for (;;) {
+        int contiguous = 0;
+        char *dst = m_ring.writePointer(&contiguous);
+        if (contiguous == 0) {
+            // 环形缓冲区已满（处理长时间被阻塞），丢弃设备中的旧数据并计数
+            char scratch[FRAME_SIZE];
+            const qint64 dropped = m_audioDevice->read(scratch, sizeof(scratch));
+            if (dropped <= 0) break;
+            m_droppedBytes += static_cast<quint64>(dropped);
+            continue;
+        }
+        const qint64 n = m_audioDevice->read(dst, contiguous);
+        if (n <= 0) break;
+        m_ring.commitWrite(static_cast<int>(n));
+
+        // 每读满一帧就处理，尽早腾出空间
+        drainFrames();
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// readConverted() — 每次读取至多 CONVERT_BLOCK_MS 的原始数据，只转换整帧部分，
+// 残留的不完整帧留到下次
+// ─────────────────────────────────────────────────────────────────────────────
+void AudioCapture::readConverted()
+{
+    const int bpf      = m_converter.bytesPerFrame();
+    const int maxBytes = m_converter.maxInputFrames() * bpf;
+
+    for (;;) {
+        const qint64 n = m_audioDevice->read(m_rawBuffer.data() + m_rawPending,
+                                             maxBytes - m_rawPending);
+        if (n <= 0) break;
+        m_rawPending += static_cast<int>(n);
+
+        const int whole = (m_rawPending / bpf) * bpf;
+        if (whole == 0) continue;
+
+        const int samples = m_converter.process(m_rawBuffer.data(), whole, m_convertBuffer.data());
+        m_rawPending -= whole;
+        if (m_rawPending > 0) {
+            memmove(m_rawBuffer.data(), m_rawBuffer.data() + whole, static_cast<size_t>(m_rawPending));
+        }
+
+        writeRing(reinterpret_cast<const char*>(m_convertBuffer.data()),
+                  samples * static_cast<int>(sizeof(int16_t)));
+        drainFrames();
+    }
+}
+
+void AudioCapture::writeRing(const char *data, int bytes)
+{
+    while (bytes > 0) {
+        int contiguous = 0;
+        char *dst = m_ring.writePointer(&contiguous);
+        if (contiguous == 0) {
+            m_droppedBytes += static_cast<quint64>(bytes);
+            return;
+        }
+        const int n = qMin(contiguous, bytes);
+        memcpy(dst, data, static_cast<size_t>(n));
+        m_ring.commitWrite(n);
+        data  += n;
+        bytes -= n;
+    }
+}
+
+void AudioCapture::drainFrames()
+{
+    while (m_ring.readAvailable() >= FRAME_SIZE) {
+        int readable = 0;
+        const char *src = m_ring.readPointer(&readable);
+        if (!m_muted) {
+            processFrame(QByteArray::fromRawData(src, FRAME_SIZE));
+        }
+        m_ring.commitRead(FRAME_SIZE);
+
+        if (++m_framesCaptured % STATS_INTERVAL_FRAMES == 0) {
+            reportStats();
+        }
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// setMuted() — 游戏内静音状态变化
+// 静音前已经说出口的话别人听到了：录制中的句子照常结束并识别（过短则取消），
+// 尚在起始确认的疑似语音直接丢弃。取消静音时从空闲状态重新开始。
+// ─────────────────────────────────────────────────────────────────────────────
+void AudioCapture::setMuted(bool muted)
+{
+    if (muted == m_muted) return;
+    m_muted = muted;
+
+    if (muted && m_state == RecordingState::Recording) {
+        // 已在录制的句子正常结束；按键说话模式按松开处理，不走 VAD 的误触发判断
+        if (m_pushToTalk) {
+            endPushToTalk();
+        } else {
+            endUtterance();
+        }
+    }
+    m_pttHeld = false;                          // 静音期间的按键无效，取消静音后需重新按下
+    resetState();
+}
+
+void AudioCapture::onRecognitionSessionStarted(quint64 utterance, quint64 sessionId)
+{
+    // 识别线程可能落后：只认领当前这句的会话，较早句子的回报直接忽略
+    if (utterance == m_utteranceSerial) {
+        m_currentSessionId  = sessionId;
+        m_hasCurrentSession = true;
+    }
+}
+
+void AudioCapture::onRecognitionPartial(quint64 sessionId, const QString &text, int stableLength)
+{
+    Q_UNUSED(stableLength);                     // 末尾未定稿的标点同样可作提示
+    if (m_state != RecordingState::Recording || !m_hasCurrentSession || sessionId != m_currentSessionId) {
+        return;
+    }
+
+    // 只看末尾标点：句末标点说明识别引擎认为这句话已经说完
+    const QString trimmed = text.trimmed();
+    Endpointer::Punctuation punctuation = Endpointer::Punctuation::None;
+    if (!trimmed.isEmpty()) {
+        static const QString FINAL_MARKS = QStringLiteral("。！？!?");
+        static const QString PAUSE_MARKS = QStringLiteral("，、；：,;:");
+        const QChar last = trimmed.back();
+        if (FINAL_MARKS.contains(last) || (last == '.' && !trimmed.endsWith(QLatin1String("..")))) {
+            punctuation = Endpointer::Punctuation::Final;
+        } else if (PAUSE_MARKS.contains(last)) {
+            punctuation = Endpointer::Punctuation::Pause;
+        }
+    }
+    m_endpointer.setPunctuation(punctuation);
+}
+
+void AudioCapture::setPushToTalk(bool held)
+{
+    if (!m_pushToTalk || held == m_pttHeld) return;
+    m_pttHeld = held;
+    if (m_muted) return;                        // 游戏内静音时按键无效
+
+    if (held) {
+        // 按下：立即开始，补发预录环中最近 preRollMs 的音频
+        deliver(AudioEvent::Type::Start);
+        emit speechOnset();
+        deliverPreRoll(m_preRollFrames);
+        m_state               = RecordingState::Recording;
+        m_recordingFrameCount = 0;
+        emit debug("按键说话：开始录音");
+    } else if (m_state == RecordingState::Recording) {
+        endPushToTalk();
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// endPushToTalk() — 松开按键（或按住时游戏内静音）：立即结束，不等待尾部静音
+// ─────────────────────────────────────────────────────────────────────────────
+void AudioCapture::endPushToTalk()
+{
+    if (m_recordingFrameCount < MIN_PTT_FRAMES) {
+        deliver(AudioEvent::Type::Cancel);
+        emit debug("按键时间过短，已取消");
+    } else {
+        deliver(AudioEvent::Type::Stop);
+        emit debug("正在识别");
+    }
+    m_state               = RecordingState::Idle;
+    m_recordingFrameCount = 0;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// deliver() — 事件放入交接队列，按批跨线程唤醒识别线程
+// 补发预录环时一次入队十几帧，只在全部入队后唤醒一次
+// ─────────────────────────────────────────────────────────────────────────────
+void AudioCapture::deliver(AudioEvent::Type type, const AudioFrameRef &frame)
+{
+    if (!m_handoff) return;
+    // 帧池耗尽时该帧已计入 exhausted，直接丢弃
+    if (type == AudioEvent::Type::Chunk && frame.isNull()) return;
+
+    if (type == AudioEvent::Type::Start) {
+        ++m_utteranceSerial;                    // 新的一句：之前认领的会话不再属于当前句子
+        m_hasCurrentSession = false;
+    }
+    m_handoff->push(type, frame, m_utteranceSerial);
+
+    if (type == AudioEvent::Type::Chunk && ++m_unsignalledFrames < m_batchFrames) {
+        return;
+    }
+    wakeConsumer();
+}
+
+void AudioCapture::wakeConsumer()
+{
+    m_unsignalledFrames = 0;
+    // 识别线程还没处理上一次唤醒时不再投递，它会把新事件一并取走
+    if (m_handoff->armWake()) {
+        emit audioAvailable();
+    }
+}
+
+void AudioCapture::reportStats()
+{
+    emit captureStats(m_framesCaptured,
+                      m_droppedBytes,
+                      m_handoff ? m_handoff->overruns() : 0,
+                      m_lateReads,
+                      m_maxReadGapMs,
+                      m_handoff ? m_handoff->wakeups() : 0);
+    m_maxReadGapMs = 0;
+
+    if (m_framePool) {
+        emit framePoolStats(m_framePool->inUse(), m_framePool->peakInUse(),
+                            m_framePool->capacity(), m_framePool->exhausted());
+    }
+
+    if (m_vad && m_vad->budgetOverruns() > m_reportedVadOverruns) {
+        emit debug(QString("AudioCapture: VAD 超出 CPU 预算 %1 帧")
+                       .arg(m_vad->budgetOverruns() - m_reportedVadOverruns));
+        m_reportedVadOverruns = m_vad->budgetOverruns();
+    }
+}
@@ -0,0 +1,245 @@
+#include "audioconverter.h"
+#include "dspkernels.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+
+struct QualityParams {
+    int    taps;      // 每相位抽头数
+    double beta;      // Kaiser 窗参数（决定阻带衰减）
+    double rolloff;   // 截止频率相对目标奈奎斯特频率的比例
+};
+
+QualityParams paramsFor(AudioConverter::Quality quality)
+{
+    switch (quality) {
+    case AudioConverter::Quality::Low:    return { 16, 5.0, 0.85 };   // 约 -50dB
+    case AudioConverter::Quality::High:   return { 64, 9.0, 0.94 };   // 约 -90dB
+    case AudioConverter::Quality::Medium:
+    default:                              return { 32, 7.0, 0.90 };   // 约 -70dB
+    }
+}
+
+// 第一类零阶修正贝塞尔函数（Kaiser 窗用）
+double besselI0(double x)
+{
+    double sum  = 1.0;
+    double term = 1.0;
+    const double q = x * x / 4.0;
+    for (int k = 1; k < 50; ++k) {
+        term *= q / (double(k) * k);
+        sum  += term;
+        if (term < sum * 1e-12) break;
+    }
+    return sum;
+}
+
+int bytesPerSample(AudioConverter::SampleFormat format)
+{
+    switch (format) {
+    case AudioConverter::SampleFormat::UInt8: return 1;
+    case AudioConverter::SampleFormat::Int16: return 2;
+    case AudioConverter::SampleFormat::Int32: return 4;
+    case AudioConverter::SampleFormat::Float: return 4;
+    }
+    return 2;
+}
+
+} // namespace
+
+// ─────────────────────────────────────────────────────────────────────────────
+// configure() — 计算重采样比、设计滤波器、分配全部工作区
+// ─────────────────────────────────────────────────────────────────────────────
+void AudioConverter::configure(const Format &in, int outRate, Quality quality, int maxInputFrames)
+{
+    m_in             = in;
+    m_in.channels    = std::max(1, in.channels);
+    m_outRate        = outRate;
+    m_bytesPerFrame  = bytesPerSample(in.sampleFormat) * m_in.channels;
+    m_maxInputFrames = maxInputFrames;
+
+    const int g = std::gcd(outRate, in.sampleRate);
+    m_up   = outRate / g;
+    m_down = in.sampleRate / g;
+
+    designFilter(quality);
+
+    m_interleaved.assign(static_cast<size_t>(maxInputFrames) * m_in.channels, 0.0f);
+    m_history.assign(static_cast<size_t>(m_taps - 1 + maxInputFrames), 0.0f);
+    m_output.assign(static_cast<size_t>(maxOutputSamples(maxInputFrames)), 0.0f);
+    reset();
+}
+
+void AudioConverter::reset()
+{
+    std::fill(m_history.begin(), m_history.end(), 0.0f);
+    m_historyLen = m_taps - 1;   // 以静音作为初始历史
+    m_position   = static_cast<int64_t>(m_taps - 1) * m_up;
+}
+
+int AudioConverter::maxOutputSamples(int inputFrames) const
+{
+    // 上一块遗留的相位最多多产出一个样本
+    return static_cast<int>((static_cast<int64_t>(inputFrames) * m_up) / m_down) + 2;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// designFilter() — Kaiser 窗 sinc 原型低通，拆分为 L 个相位
+// 原型工作在 L 倍上采样率，截止频率取输入与输出奈奎斯特频率中较低者
+// ─────────────────────────────────────────────────────────────────────────────
+void AudioConverter::designFilter(Quality quality)
+{
+    const QualityParams p = paramsFor(quality);
+
+    if (m_up == 1 && m_down == 1) {
+        // 采样率一致，只需格式转换与混音
+        m_taps = 1;
+        m_phases.assign(1, 1.0f);
+        return;
+    }
+
+    // 降采样时滤波器按降采样比例展宽，保持相同的过渡带相对宽度
+    const double ratio = static_cast<double>(m_down) / m_up;
+    m_taps = ratio > 1.0 ? static_cast<int>(std::ceil(p.taps * ratio)) : p.taps;
+
+    const int    length = m_taps * m_up;
+    const double cutoff = p.rolloff * 0.5 / std::max(m_up, m_down);   // 归一化到上采样率
+    const double center = (length - 1) / 2.0;
+    const double i0Beta = besselI0(p.beta);
+
+    std::vector<double> h(static_cast<size_t>(length));
+    for (int j = 0; j < length; ++j) {
+        const double t    = j - center;
+        const double sinc = (t == 0.0) ? 2.0 * cutoff
+                                       : std::sin(2.0 * PI * cutoff * t) / (PI * t);
+        const double r    = t / center;
+        const double win  = besselI0(p.beta * std::sqrt(std::max(0.0, 1.0 - r * r))) / i0Beta;
+        h[j] = sinc * win * m_up;   // 乘 L 补偿插零带来的增益损失
+    }
+
+    // 相位 ph 的第 k 个抽头作用于 x[i-k]；倒序存放，使点积按历史正序进行
+    m_phases.assign(static_cast<size_t>(m_up) * m_taps, 0.0f);
+    for (int ph = 0; ph < m_up; ++ph) {
+        float *dst = m_phases.data() + static_cast<size_t>(ph) * m_taps;
+        for (int k = 0; k < m_taps; ++k) {
+            dst[m_taps - 1 - k] = static_cast<float>(h[ph + k * m_up]);
+        }
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// toMonoFloat() — 交错样本转 float 并混为单声道
+// ─────────────────────────────────────────────────────────────────────────────
+void AudioConverter::toMonoFloat(const char *in, int frames, float *out)
+{
+    const Dsp::Kernels &k  = Dsp::kernels();
+    const int channels     = m_in.channels;
+    const int samples      = frames * channels;
+    float *inter           = (channels == 1) ? out : m_interleaved.data();
+
+    switch (m_in.sampleFormat) {
+    case SampleFormat::Int16:
+        k.int16ToFloat(reinterpret_cast<const int16_t*>(in), inter, samples);
+        break;
+    case SampleFormat::Float:
+        memcpy(inter, in, static_cast<size_t>(samples) * sizeof(float));
+        break;
+    case SampleFormat::Int32: {
+        const int32_t *src = reinterpret_cast<const int32_t*>(in);
+        for (int i = 0; i < samples; ++i) {
+            inter[i] = static_cast<float>(src[i] * (1.0 / 2147483648.0));
+        }
+        break;
+    }
+    case SampleFormat::UInt8: {
+        const uint8_t *src = reinterpret_cast<const uint8_t*>(in);
+        for (int i = 0; i < samples; ++i) {
+            inter[i] = (static_cast<int>(src[i]) - 128) * (1.0f / 128.0f);
+        }
+        break;
+    }
+    }
+
+    if (channels == 1) {
+        return;
+    }
+    if (channels == 2) {
+        for (int i = 0; i < frames; ++i) {
+            out[i] = 0.5f * (inter[2 * i] + inter[2 * i + 1]);
+        }
+        return;
+    }
+    const float scale = 1.0f / channels;
+    for (int i = 0; i < frames; ++i) {
+        const float *frame = inter + static_cast<size_t>(i) * channels;
+        float sum = 0.0f;
+        for (int c = 0; c < channels; ++c) {
+            sum += frame[c];
+        }
+        out[i] = sum * scale;
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// process() — 新样本追加到历史末尾，按 M/L 步进逐个计算输出，最后保留尾部
+// ─────────────────────────────────────────────────────────────────────────────
+int AudioConverter::process(const char *in, int bytes, int16_t *out)
+{
+    const int frames = std::min(bytes / m_bytesPerFrame, m_maxInputFrames);
+    if (frames <= 0) return 0;
+
+    const Dsp::Kernels &k = Dsp::kernels();
+    float *hist = m_history.data();
+    toMonoFloat(in, frames, hist + m_historyLen);
+    m_historyLen += frames;
+
+    int produced = 0;
+    if (m_up == 1 && m_down == 1) {
+        k.floatToInt16(hist + m_taps - 1, out, frames);
+        m_historyLen = m_taps - 1;
+        return frames;
+    }
+
+    for (;;) {
+        const int64_t idx = m_position / m_up;          // 当前输出对应的最新输入样本
+        if (idx >= m_historyLen) break;
+        const int phase = static_cast<int>(m_position % m_up);
+        m_output[produced++] = k.dot(m_phases.data() + static_cast<size_t>(phase) * m_taps,
+                                     hist + (idx - m_taps + 1), m_taps);
+        m_position += m_down;
+    }
+
+    // 只保留下一个输出需要的 taps-1 个历史样本
+    const int64_t nextIdx = m_position / m_up;
+    const int     keepFrom = static_cast<int>(std::min<int64_t>(nextIdx - (m_taps - 1), m_historyLen));
+    if (keepFrom > 0) {
+        memmove(hist, hist + keepFrom, static_cast<size_t>(m_historyLen - keepFrom) * sizeof(float));
+        m_historyLen -= keepFrom;
+        m_position   -= static_cast<int64_t>(keepFrom) * m_up;
+    }
+
+    k.floatToInt16(m_output.data(), out, produced);
+    return produced;
+}
+
+AudioConverter::Quality AudioConverter::qualityFromName(const std::string &name)
+{
+    if (name == "low")  return Quality::Low;
+    if (name == "high") return Quality::High;
+    return Quality::Medium;
+}
+
+const char *AudioConverter::qualityName(Quality quality)
+{
+    switch (quality) {
+    case Quality::Low:    return "low";
+    case Quality::High:   return "high";
+    case Quality::Medium: return "medium";
+    }
+    return "medium";
+}
@@ -0,0 +1,73 @@
+#ifndef AUDIOCONVERTER_H
+#define AUDIOCONVERTER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// ─────────────────────────────────────────────────────────────────────────────
+// AudioConverter — 设备原生格式 → 16kHz / 16bit / 单声道
+//
+// 流程：交错样本转 float → 多声道平均混为单声道 → 多相 FIR 重采样 → 饱和转 int16。
+// 重采样比取 outRate/inRate 的最简分数 L/M（48k→16k 为 1/3，44.1k→16k 为 160/441），
+// 原型低通为 Kaiser 窗 sinc，按 L 个相位拆成短滤波器，每个输出样本只做一次
+// taps 长度的点积（Dsp::kernels().dot，SSE2/AVX2/NEON）。
+// 所有缓冲区在 configure() 中按最大块长分配，process() 不做任何分配。
+// 不依赖 Qt，只在采集线程中使用。
+// ─────────────────────────────────────────────────────────────────────────────
+class AudioConverter
+{
+public:
+    enum class SampleFormat { UInt8, Int16, Int32, Float };
+
+    // 质量 / CPU 预设：每相位抽头数与阻带衰减依次提高
+    enum class Quality { Low, Medium, High };
+
+    struct Format {
+        int          sampleRate   = 16000;
+        int          channels     = 1;
+        SampleFormat sampleFormat = SampleFormat::Int16;
+    };
+
+    AudioConverter() = default;
+
+    // maxInputFrames 为单次 process() 最多输入的帧数（一帧 = 各声道各一个样本）
+    void configure(const Format &in, int outRate, Quality quality, int maxInputFrames);
+    void reset();   // 清空滤波器历史
+
+    int bytesPerFrame() const { return m_bytesPerFrame; }
+    int maxInputFrames() const { return m_maxInputFrames; }
+    // 输入 inputFrames 帧时最多产生的输出样本数
+    int maxOutputSamples(int inputFrames) const;
+
+    // 转换 bytes 字节输入（必须是整帧，且不超过 maxInputFrames 帧），返回写入 out 的样本数
+    int process(const char *in, int bytes, int16_t *out);
+
+    static Quality     qualityFromName(const std::string &name);   // "low" / "medium" / "high"
+    static const char *qualityName(Quality quality);
+
+private:
+    void toMonoFloat(const char *in, int frames, float *out);
+    void designFilter(Quality quality);
+
+    Format m_in;
+    int    m_outRate        = 16000;
+    int    m_bytesPerFrame  = 2;
+    int    m_maxInputFrames = 0;
+
+    // 重采样比 L/M 与多相滤波器
+    int m_up    = 1;   // L
+    int m_down  = 1;   // M
+    int m_taps  = 1;   // 每相位抽头数
+    std::vector<float> m_phases;   // L × taps，每个相位的系数按时间正序排列，可直接与历史做点积
+
+    // 流式状态：m_history 前 taps-1 个样本为上一块留下的尾部
+    std::vector<float> m_history;
+    int     m_historyLen = 0;
+    int64_t m_position   = 0;      // 下一个输出样本在历史中的位置（以 1/L 输入样本为单位）
+
+    std::vector<float> m_interleaved;   // 交错样本转 float 的工作区
+    std::vector<float> m_output;        // 重采样输出（float）
+};
+
+#endif // AUDIOCONVERTER_H
@@ -0,0 +1,160 @@
+#include "audioframepool.h"
+#include <algorithm>
+
+// ─────────────────────────────────────────────────────────────────────────────
+// AudioFrameRef
+// ─────────────────────────────────────────────────────────────────────────────
+AudioFrameRef::AudioFrameRef(const AudioFrameRef &other)
+    : m_pool(other.m_pool)
+    , m_index(other.m_index)
+{
+    if (m_pool) m_pool->addRef(m_index);
+}
+
+AudioFrameRef::AudioFrameRef(AudioFrameRef &&other) noexcept
+    : m_pool(other.m_pool)
+    , m_index(other.m_index)
+{
+    other.m_pool = nullptr;
+}
+
+AudioFrameRef &AudioFrameRef::operator=(const AudioFrameRef &other)
+{
+    if (this != &other) {
+        if (other.m_pool) other.m_pool->addRef(other.m_index);
+        reset();
+        m_pool  = other.m_pool;
+        m_index = other.m_index;
+    }
+    return *this;
+}
+
+AudioFrameRef &AudioFrameRef::operator=(AudioFrameRef &&other) noexcept
+{
+    if (this != &other) {
+        reset();
+        m_pool  = other.m_pool;
+        m_index = other.m_index;
+        other.m_pool = nullptr;
+    }
+    return *this;
+}
+
+AudioFrameRef::~AudioFrameRef()
+{
+    reset();
+}
+
+void AudioFrameRef::reset()
+{
+    if (m_pool) {
+        m_pool->release(m_index);
+        m_pool = nullptr;
+    }
+}
+
+char *AudioFrameRef::data()
+{
+    return m_pool ? m_pool->m_data.get() + static_cast<size_t>(m_index) * AudioFramePool::FRAME_BYTES
+                  : nullptr;
+}
+
+const char *AudioFrameRef::constData() const
+{
+    return m_pool ? m_pool->m_data.get() + static_cast<size_t>(m_index) * AudioFramePool::FRAME_BYTES
+                  : nullptr;
+}
+
+int AudioFrameRef::size() const
+{
+    return m_pool ? m_pool->m_slots[m_index].size : 0;
+}
+
+void AudioFrameRef::setSize(int bytes)
+{
+    if (m_pool) {
+        m_pool->m_slots[m_index].size = std::clamp(bytes, 0, AudioFramePool::FRAME_BYTES);
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// AudioFramePool
+// ─────────────────────────────────────────────────────────────────────────────
+AudioFramePool::AudioFramePool(int capacity)
+    : m_capacity(std::max(1, capacity))
+    , m_data(new char[static_cast<size_t>(m_capacity) * FRAME_BYTES])
+    , m_slots(new Slot[m_capacity])
+    , m_freeHead(NIL)
+{
+    // 倒序压栈，使首次获取按下标顺序进行
+    for (int i = m_capacity - 1; i >= 0; --i) {
+        pushFree(static_cast<uint32_t>(i));
+    }
+}
+
+AudioFrameRef AudioFramePool::acquire()
+{
+    uint32_t index = NIL;
+    if (!popFree(&index)) {
+        m_exhausted.fetch_add(1, std::memory_order_relaxed);
+        return AudioFrameRef();
+    }
+
+    Slot &slot = m_slots[index];
+    slot.refs.store(1, std::memory_order_relaxed);
+    slot.size = FRAME_BYTES;
+
+    m_acquired.fetch_add(1, std::memory_order_relaxed);
+    const int used = m_inUse.fetch_add(1, std::memory_order_relaxed) + 1;
+    int peak = m_peakInUse.load(std::memory_order_relaxed);
+    while (used > peak && !m_peakInUse.compare_exchange_weak(peak, used, std::memory_order_relaxed)) {
+    }
+    return AudioFrameRef(this, index);
+}
+
+void AudioFramePool::addRef(uint32_t index)
+{
+    m_slots[index].refs.fetch_add(1, std::memory_order_relaxed);
+}
+
+void AudioFramePool::release(uint32_t index)
+{
+    // acq_rel：其他线程对帧内容的读取必须在帧被重新获取、改写之前完成
+    if (m_slots[index].refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        m_inUse.fetch_sub(1, std::memory_order_relaxed);
+        pushFree(index);
+    }
+}
+
+void AudioFramePool::pushFree(uint32_t index)
+{
+    uint64_t head = m_freeHead.load(std::memory_order_relaxed);
+    for (;;) {
+        m_slots[index].next.store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+        const uint64_t newHead = (((head >> 32) + 1) << 32) | index;
+        if (m_freeHead.compare_exchange_weak(head, newHead,
+                                             std::memory_order_release,
+                                             std::memory_order_relaxed)) {
+            return;
+        }
+    }
+}
+
+bool AudioFramePool::popFree(uint32_t *index)
+{
+    uint64_t head = m_freeHead.load(std::memory_order_acquire);
+    for (;;) {
+        const uint32_t top = static_cast<uint32_t>(head);
+        if (top == NIL) {
+            return false;
+        }
+        const uint32_t next    = m_slots[top].next.load(std::memory_order_relaxed);
+        const uint64_t newHead = (((head >> 32) + 1) << 32) | next;
+        if (m_freeHead.compare_exchange_weak(head, newHead,
+                                             std::memory_order_acquire,
+                                             std::memory_order_acquire)) {
+            *index = top;
+            return true;
+        }
+    }
+}
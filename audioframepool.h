@@ -0,0 +1,99 @@
+#ifndef AUDIOFRAMEPOOL_H
+#define AUDIOFRAMEPOOL_H
+
+#include <atomic>
+#include <memory>
+#include <cstdint>
+
+class AudioFramePool;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// AudioFrameRef — 帧池中一帧的引用计数句柄
+//
+// 拷贝只增加引用计数，不拷贝音频；最后一个句柄销毁时帧自动归还帧池。
+// 可以在线程间传递（计数为原子操作），但同一帧的内容只应由获取它的一方写入。
+// ─────────────────────────────────────────────────────────────────────────────
+class AudioFrameRef
+{
+public:
+    AudioFrameRef() = default;
+    AudioFrameRef(const AudioFrameRef &other);
+    AudioFrameRef(AudioFrameRef &&other) noexcept;
+    AudioFrameRef &operator=(const AudioFrameRef &other);
+    AudioFrameRef &operator=(AudioFrameRef &&other) noexcept;
+    ~AudioFrameRef();
+
+    bool isNull() const { return m_pool == nullptr; }
+
+    char       *data();
+    const char *constData() const;
+    int         size() const;          // 有效字节数
+    void        setSize(int bytes);    // 不超过 AudioFramePool::FRAME_BYTES
+
+private:
+    friend class AudioFramePool;
+    AudioFrameRef(AudioFramePool *pool, uint32_t index) : m_pool(pool), m_index(index) {}
+    void reset();
+
+    AudioFramePool *m_pool  = nullptr;
+    uint32_t        m_index = 0;
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+// AudioFramePool — 固定大小的音频帧池（一次性分配的连续内存 + 无锁空闲栈）
+//
+// 采集线程 acquire() 一帧、写入后把句柄交给识别线程，识别线程发送完毕释放句柄，
+// 帧回到空闲栈。稳态下每帧音频没有任何堆分配。
+// 空闲栈为带版本号的 Treiber 栈（版本号防 ABA），获取与归还可在任意线程进行。
+// 帧池耗尽时 acquire() 返回空句柄并计数，由调用方丢弃该帧。
+// 帧池必须比所有句柄活得更久。
+// ─────────────────────────────────────────────────────────────────────────────
+class AudioFramePool
+{
+public:
+    static constexpr int FRAME_BYTES          = 1280;   // 40ms@16kHz/16bit/1ch
+    static constexpr int MAX_UTTERANCE_FRAMES = 1500;   // 单句最长帧数（60s）
+
+    explicit AudioFramePool(int capacity = 1024);
+
+    AudioFramePool(const AudioFramePool&) = delete;
+    AudioFramePool& operator=(const AudioFramePool&) = delete;
+
+    AudioFrameRef acquire();
+
+    // ─── 统计 ────────────────────────────────────────────────────────────────
+    int      capacity() const { return m_capacity; }
+    int      inUse() const { return m_inUse.load(std::memory_order_relaxed); }
+    int      peakInUse() const { return m_peakInUse.load(std::memory_order_relaxed); }
+    uint64_t acquired() const { return m_acquired.load(std::memory_order_relaxed); }
+    uint64_t exhausted() const { return m_exhausted.load(std::memory_order_relaxed); }
+
+private:
+    friend class AudioFrameRef;
+
+    struct Slot {
+        std::atomic<int>      refs{0};
+        std::atomic<uint32_t> next{0};   // 空闲栈中的下一个
+        int                   size = 0;
+    };
+
+    void addRef(uint32_t index);
+    void release(uint32_t index);
+    void pushFree(uint32_t index);
+    bool popFree(uint32_t *index);
+
+    static constexpr uint32_t NIL = 0xFFFFFFFFu;
+
+    const int m_capacity;
+    std::unique_ptr<char[]> m_data;    // capacity × FRAME_BYTES
+    std::unique_ptr<Slot[]> m_slots;
+
+    alignas(64) std::atomic<uint64_t> m_freeHead;   // 高 32 位版本号，低 32 位栈顶下标
+
+    std::atomic<int>      m_inUse{0};
+    std::atomic<int>      m_peakInUse{0};
+    std::atomic<uint64_t> m_acquired{0};
+    std::atomic<uint64_t> m_exhausted{0};
+};
+
+#endif // AUDIOFRAMEPOOL_H
@@ -0,0 +1,73 @@
+#include "audiohandoffqueue.h"
+
+AudioHandoffQueue::AudioHandoffQueue(int capacity)
+    : m_slots(new AudioEvent[capacity])
+    , m_capacity(capacity)
+{
+}
+
+bool AudioHandoffQueue::push(AudioEvent::Type type, const AudioFrameRef &frame, uint64_t utterance)
+{
+    const uint64_t w     = m_writePos.load(std::memory_order_relaxed);
+    const uint64_t r     = m_readPos.load(std::memory_order_acquire);
+    const int      depth = static_cast<int>(w - r);
+
+    const int limit = (type == AudioEvent::Type::Chunk)
+                          ? m_capacity - CONTROL_RESERVE : m_capacity;
+    if (depth >= limit) {
+        m_overruns.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    AudioEvent &slot = m_slots[w % m_capacity];
+    slot.type      = type;
+    slot.frame     = frame;
+    slot.utterance = utterance;
+    m_writePos.store(w + 1, std::memory_order_release);
+
+    if (depth + 1 > m_highWater.load(std::memory_order_relaxed)) {
+        m_highWater.store(depth + 1, std::memory_order_relaxed);
+    }
+    return true;
+}
+
+bool AudioHandoffQueue::pop(AudioEvent *event)
+{
+    const uint64_t r = m_readPos.load(std::memory_order_relaxed);
+    const uint64_t w = m_writePos.load(std::memory_order_acquire);
+    if (r == w) {
+        return false;
+    }
+
+    AudioEvent &slot = m_slots[r % m_capacity];
+    event->type      = slot.type;
+    event->frame     = std::move(slot.frame);   // 槽位不再持有引用，帧可随时归还帧池
+    event->utterance = slot.utterance;
+    m_readPos.store(r + 1, std::memory_order_release);
+    return true;
+}
+
+int AudioHandoffQueue::size() const
+{
+    const uint64_t r = m_readPos.load(std::memory_order_acquire);
+    const uint64_t w = m_writePos.load(std::memory_order_acquire);
+    return static_cast<int>(w - r);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// armWake() / clearWake() — 唤醒标志
+// 两端都用 acq_rel 交换：消费者清除标志后必然能看到在此之前入队的全部事件
+// ─────────────────────────────────────────────────────────────────────────────
+bool AudioHandoffQueue::armWake()
+{
+    if (m_wakePending.exchange(true, std::memory_order_acq_rel)) {
+        return false;
+    }
+    m_wakeups.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void AudioHandoffQueue::clearWake()
+{
+    m_wakePending.exchange(false, std::memory_order_acq_rel);
+}
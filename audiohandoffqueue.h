@@ -0,0 +1,81 @@
+#ifndef AUDIOHANDOFFQUEUE_H
+#define AUDIOHANDOFFQUEUE_H
+
+#include "audioframepool.h"
+#include <atomic>
+#include <memory>
+#include <cstdint>
+
+// ─────────────────────────────────────────────────────────────────────────────
+// AudioEvent — 采集线程交给识别线程的一条事件
+// 开始/音频/结束走同一条有序通道，保证跨线程后仍严格按采集顺序处理
+// 音频以帧池句柄传递，入队出队只移动引用，不拷贝、不分配
+// ─────────────────────────────────────────────────────────────────────────────
+struct AudioEvent
+{
+    enum class Type {
+        Start,   // 新的一句开始
+        Chunk,   // 一帧音频
+        Stop,    // 本句结束
+        Cancel   // 本句为误触发，放弃识别
+    };
+    Type          type = Type::Chunk;
+    AudioFrameRef frame;
+    uint64_t      utterance = 0;   // Start：采集端的句子序号，识别端据此回报对应的会话编号
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+// AudioHandoffQueue — 采集线程 → 识别线程的有界单生产者/单消费者队列
+//
+// 容量固定，识别线程卡顿时不会无限堆积事件。
+// 队列将满时只丢弃音频帧并计数，预留的 CONTROL_RESERVE 个槽位保证
+// 开始/结束事件永远能入队，避免会话状态错乱。
+//
+// 唤醒与入队分离：生产者可以连续入队多条事件后只唤醒一次，
+// 消费者尚未处理上一次唤醒时不再重复唤醒，跨线程事件数随批量大小成倍减少。
+// ─────────────────────────────────────────────────────────────────────────────
+class AudioHandoffQueue
+{
+public:
+    explicit AudioHandoffQueue(int capacity = 256);
+
+    AudioHandoffQueue(const AudioHandoffQueue&) = delete;
+    AudioHandoffQueue& operator=(const AudioHandoffQueue&) = delete;
+
+    // 生产者端：返回 false 表示音频帧因队列满被丢弃
+    bool push(AudioEvent::Type type, const AudioFrameRef &frame = AudioFrameRef(),
+              uint64_t utterance = 0);
+
+    // 消费者端：取出一条事件，队列空时返回 false
+    bool pop(AudioEvent *event);
+
+    // ─── 批量唤醒 ────────────────────────────────────────────────────────────
+    // 生产者端：返回 true 表示消费者当前没有在途的唤醒，调用方需要发出一次唤醒；
+    // 返回 false 表示已有唤醒在途，新事件会被那次唤醒一并取走
+    bool armWake();
+    // 消费者端：开始取事件之前调用，之后入队的事件会重新触发唤醒
+    void clearWake();
+
+    int      size() const;
+    int      capacity() const { return m_capacity; }
+    uint64_t overruns() const { return m_overruns.load(std::memory_order_relaxed); }
+    int      highWaterMark() const { return m_highWater.load(std::memory_order_relaxed); }
+    uint64_t wakeups() const { return m_wakeups.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr int CONTROL_RESERVE = 4;
+
+    std::unique_ptr<AudioEvent[]> m_slots;
+    const int m_capacity;
+
+    alignas(64) std::atomic<uint64_t> m_writePos{0};
+    alignas(64) std::atomic<uint64_t> m_readPos{0};
+
+    std::atomic<uint64_t> m_overruns{0};   // 因队列满丢弃的音频帧数
+    std::atomic<int>      m_highWater{0};  // 队列深度峰值
+
+    alignas(64) std::atomic<bool> m_wakePending{false};   // 已发出唤醒、消费者尚未开始处理
+    std::atomic<uint64_t> m_wakeups{0};    // 实际发出的唤醒次数
+};
+
+#endif // AUDIOHANDOFFQUEUE_H
@@ -0,0 +1,68 @@
+#include "audioringbuffer.h"
+#include <algorithm>
+
+AudioRingBuffer::AudioRingBuffer(int capacity)
+{
+    allocate(capacity);
+}
+
+void AudioRingBuffer::allocate(int capacity)
+{
+    m_data.reset(capacity > 0 ? new char[capacity] : nullptr);
+    m_capacity = std::max(capacity, 0);
+    reset();
+}
+
+void AudioRingBuffer::reset()
+{
+    m_writePos.store(0, std::memory_order_relaxed);
+    m_readPos.store(0, std::memory_order_relaxed);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// 生产者端
+// ─────────────────────────────────────────────────────────────────────────────
+int AudioRingBuffer::writeSpace() const
+{
+    const uint64_t w = m_writePos.load(std::memory_order_relaxed);
+    const uint64_t r = m_readPos.load(std::memory_order_acquire);
+    return m_capacity - static_cast<int>(w - r);
+}
+
+char *AudioRingBuffer::writePointer(int *contiguous)
+{
+    const uint64_t w      = m_writePos.load(std::memory_order_relaxed);
+    const int      offset = m_capacity ? static_cast<int>(w % m_capacity) : 0;
+    *contiguous = std::min(writeSpace(), m_capacity - offset);
+    return m_data.get() + offset;
+}
+
+void AudioRingBuffer::commitWrite(int bytes)
+{
+    // release：保证数据写入先于位置更新对消费者可见
+    m_writePos.fetch_add(static_cast<uint64_t>(bytes), std::memory_order_release);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// 消费者端
+// ─────────────────────────────────────────────────────────────────────────────
+int AudioRingBuffer::readAvailable() const
+{
+    const uint64_t r = m_readPos.load(std::memory_order_relaxed);
+    const uint64_t w = m_writePos.load(std::memory_order_acquire);
+    return static_cast<int>(w - r);
+}
+
+const char *AudioRingBuffer::readPointer(int *contiguous) const
+{
+    const uint64_t r      = m_readPos.load(std::memory_order_relaxed);
+    const int      offset = m_capacity ? static_cast<int>(r % m_capacity) : 0;
+    *contiguous = std::min(readAvailable(), m_capacity - offset);
+    return m_data.get() + offset;
+}
+
+void AudioRingBuffer::commitRead(int bytes)
+{
+    // release：保证本帧读取完成后生产者才能覆盖这段空间
+    m_readPos.fetch_add(static_cast<uint64_t>(bytes), std::memory_order_release);
+}
@@ -0,0 +1,51 @@
+#ifndef AUDIORINGBUFFER_H
+#define AUDIORINGBUFFER_H
+
+#include <atomic>
+#include <memory>
+#include <cstdint>
+
+// ─────────────────────────────────────────────────────────────────────────────
+// AudioRingBuffer — 预分配的单生产者/单消费者无锁环形缓冲区
+//
+//   - 生产者：直接把设备数据 read() 进 writePointer() 返回的连续区域，再 commitWrite()
+//   - 消费者：readPointer() 取得连续可读区域，按帧处理后 commitRead()
+//
+// 容量取帧长的整数倍，且消费者每次只提交整帧时，任何一帧都不会跨越环尾，
+// 因此可以直接在缓冲区内原地切帧（QByteArray::fromRawData），无需拷贝。
+// 读写位置为单调递增的 64 位计数，生产者与消费者各自只写自己的位置。
+// ─────────────────────────────────────────────────────────────────────────────
+class AudioRingBuffer
+{
+public:
+    explicit AudioRingBuffer(int capacity = 0);
+
+    AudioRingBuffer(const AudioRingBuffer&) = delete;
+    AudioRingBuffer& operator=(const AudioRingBuffer&) = delete;
+
+    // 重新分配（非实时路径调用，调用时两端都必须空闲）
+    void allocate(int capacity);
+    void reset();
+
+    int capacity() const { return m_capacity; }
+
+    // ─── 生产者端 ────────────────────────────────────────────────────────────
+    int   writeSpace() const;
+    char *writePointer(int *contiguous);   // 返回可写起点，contiguous 为连续可写字节数
+    void  commitWrite(int bytes);
+
+    // ─── 消费者端 ────────────────────────────────────────────────────────────
+    int         readAvailable() const;
+    const char *readPointer(int *contiguous) const;
+    void        commitRead(int bytes);
+
+private:
+    std::unique_ptr<char[]> m_data;
+    int m_capacity = 0;
+
+    // 生产者与消费者的位置放在不同缓存行，避免伪共享
+    alignas(64) std::atomic<uint64_t> m_writePos{0};
+    alignas(64) std::atomic<uint64_t> m_readPos{0};
+};
+
+#endif // AUDIORINGBUFFER_H
@@ -0,0 +1,438 @@
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMetaObject>
+#include <QThread>
+#include "audioconverter.h"
+#include "audiohandoffqueue.h"
+#include "dspkernels.h"
+#include "oscpacketbuilder.h"
+#include "xunfeiframeencoder.h"
+#include "xunfeiresultparser.h"
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// ─────────────────────────────────────────────────────────────────────────────
+// benchmarks — 热路径的吞吐量基准，与主程序分开构建、手动运行，不参与 ctest
+// 各项结果只用于比较不同实现 / 指令集，正确性由对应的 tst_* 单元测试保证
+// ─────────────────────────────────────────────────────────────────────────────
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// dspKernelsReport() — 以一帧（640 样本）为单位反复调用，统计每秒处理的样本数
+// ─────────────────────────────────────────────────────────────────────────────
+std::string dspKernelsReport()
+{
+    constexpr int    N         = 640;
+    constexpr double RUN_SECS  = 0.02;   // 每个内核约 20ms
+
+    std::vector<int16_t> pcm(N);
+    std::vector<float>   buf(N);
+    std::vector<int16_t> pcmOut(N);
+    uint32_t seed = 12345;
+    for (int i = 0; i < N; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        pcm[i] = static_cast<int16_t>(seed >> 16);
+    }
+    Dsp::scalarKernels().int16ToFloat(pcm.data(), buf.data(), N);
+
+    volatile double sink = 0.0;
+    auto measure = [&](auto &&fn) {
+        long long samples = 0;
+        const auto start = Clock::now();
+        double elapsed = 0.0;
+        do {
+            for (int r = 0; r < 64; ++r) {
+                fn();
+            }
+            samples += 64LL * N;
+            elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+        } while (elapsed < RUN_SECS);
+        return samples / elapsed / 1e6;   // 百万样本/秒
+    };
+
+    const std::vector<const Dsp::Kernels*> list = Dsp::availableKernels();
+    const char *names[] = { "sumSquares", "zeroCrossings", "peakAbs",
+                            "int16ToFloat", "floatToInt16", "removeDc", "dot", "base64" };
+    std::vector<float> taps(N, 0.01f);
+    std::vector<char>  b64(Dsp::base64Length(N * sizeof(int16_t)));
+    const uint8_t     *pcmBytes = reinterpret_cast<const uint8_t*>(pcm.data());
+
+    std::string report = "DSP kernel benchmark (Msamples/s, frame=640):";
+    for (int k = 0; k < 8; ++k) {
+        report += "\n  ";
+        report += names[k];
+        for (const Dsp::Kernels *ks : list) {
+            double msps = 0.0;
+            switch (k) {
+            case 0: msps = measure([&] { sink = sink + ks->sumSquares(pcm.data(), N); }); break;
+            case 1: msps = measure([&] { sink = sink + ks->zeroCrossings(pcm.data(), N); }); break;
+            case 2: msps = measure([&] { sink = sink + ks->peakAbs(pcm.data(), N); }); break;
+            case 3: msps = measure([&] { ks->int16ToFloat(pcm.data(), buf.data(), N); }); break;
+            case 4: msps = measure([&] { ks->floatToInt16(buf.data(), pcmOut.data(), N); }); break;
+            case 5: msps = measure([&] { sink = sink + ks->removeDc(buf.data(), N); }); break;
+            case 6: msps = measure([&] { sink = sink + ks->dot(buf.data(), taps.data(), N); }); break;
+            case 7: msps = measure([&] { sink = sink + ks->base64Encode(pcmBytes, N * sizeof(int16_t), b64.data()); }); break;
+            }
+            char cell[48];
+            std::snprintf(cell, sizeof(cell), "  %s %.0f", ks->name, msps);
+            report += cell;
+        }
+    }
+    return report;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// audioConverterReport() — 按 10ms 一块转换 1 秒音频，报告实时占用率（CPU 时间 / 音频时长）
+// ─────────────────────────────────────────────────────────────────────────────
+std::string audioConverterReport()
+{
+    using Format = AudioConverter::SampleFormat;
+    using Quality = AudioConverter::Quality;
+
+    struct Case { int rate; int channels; Format format; const char *label; };
+    const Case cases[] = {
+        { 48000, 2, Format::Float, "48k/2ch/float" },
+        { 44100, 2, Format::Float, "44.1k/2ch/float" },
+        { 48000, 1, Format::Int16, "48k/1ch/int16" },
+    };
+    const Quality qualities[] = { Quality::Low, Quality::Medium, Quality::High };
+
+    std::string report = "Resampler benchmark (% of real time, lower is better):";
+    for (const Case &c : cases) {
+        report += "\n  ";
+        report += c.label;
+
+        const int blockFrames = c.rate / 100;
+        for (Quality q : qualities) {
+            AudioConverter conv;
+            conv.configure({ c.rate, c.channels, c.format }, 16000, q, blockFrames);
+
+            std::vector<char> input(static_cast<size_t>(blockFrames) * conv.bytesPerFrame());
+            for (size_t i = 0; i < input.size(); ++i) {
+                input[i] = static_cast<char>((i * 37) & 0x3F);
+            }
+            std::vector<int16_t> out(static_cast<size_t>(conv.maxOutputSamples(blockFrames)));
+
+            constexpr int BLOCKS = 100;   // 1 秒音频
+            const auto start = Clock::now();
+            for (int b = 0; b < BLOCKS; ++b) {
+                conv.process(input.data(), static_cast<int>(input.size()), out.data());
+            }
+            const double secs = std::chrono::duration<double>(Clock::now() - start).count();
+
+            char cell[48];
+            std::snprintf(cell, sizeof(cell), "  %s %.3f%%", AudioConverter::qualityName(q), secs * 100.0);
+            report += cell;
+        }
+    }
+    return report;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// handoffReport() — 采集侧尽快送出 FRAMES 帧，消费线程用事件循环接收
+//   逐帧：每帧一个排队调用（原来每帧一次 audioAvailable 的做法）
+//   批量：每 N 帧 armWake() 一次，唤醒在途时不再投递
+// 统计送完全部帧的耗时和消费线程被唤醒的次数
+// ─────────────────────────────────────────────────────────────────────────────
+QString handoffReport()
+{
+    constexpr int FRAMES = 20000;
+
+    QThread consumerThread;
+    QObject receiver;
+    receiver.moveToThread(&consumerThread);
+    consumerThread.start();
+
+    AudioFramePool pool(512);
+    AudioFrameRef  frame = pool.acquire();
+
+    auto run = [&](int batch) {
+        AudioHandoffQueue queue(256);
+        std::atomic<int> received{0};
+        std::atomic<int> wakeups{0};
+
+        auto drain = [&queue, &received, &wakeups, batch]() {
+            wakeups.fetch_add(1, std::memory_order_relaxed);
+            if (batch > 0) {
+                queue.clearWake();
+            }
+            AudioEvent event;
+            int n = 0;
+            while (queue.pop(&event)) {
+                ++n;
+            }
+            received.fetch_add(n, std::memory_order_release);
+        };
+
+        QElapsedTimer timer;
+        timer.start();
+        int sinceWake = 0;
+        for (int i = 0; i < FRAMES; ++i) {
+            while (!queue.push(AudioEvent::Type::Chunk, frame)) {
+                QThread::yieldCurrentThread();   // 消费者跟不上时等待，不丢帧
+            }
+            if (batch == 0) {
+                QMetaObject::invokeMethod(&receiver, drain, Qt::QueuedConnection);
+            } else if (++sinceWake >= batch) {
+                sinceWake = 0;
+                if (queue.armWake()) {
+                    QMetaObject::invokeMethod(&receiver, drain, Qt::QueuedConnection);
+                }
+            }
+        }
+        if (batch > 0 && queue.armWake()) {
+            QMetaObject::invokeMethod(&receiver, drain, Qt::QueuedConnection);
+        }
+        while (received.load(std::memory_order_acquire) < FRAMES) {
+            QThread::yieldCurrentThread();
+        }
+        const double usPerFrame = timer.nsecsElapsed() / 1000.0 / FRAMES;
+
+        // 逐帧模式下最后几次排队调用可能晚于最后一帧到达，等它们执行完再销毁队列
+        QMetaObject::invokeMethod(&receiver, [] {}, Qt::BlockingQueuedConnection);
+
+        return QString("\n  %1  %2 us/帧  唤醒 %3 次（%4 帧/次）")
+            .arg(batch == 0 ? QString("逐帧信号") : QString("批量 %1 帧").arg(batch), -10)
+            .arg(usPerFrame, 0, 'f', 2)
+            .arg(wakeups.load())
+            .arg(double(FRAMES) / qMax(1, wakeups.load()), 0, 'f', 1);
+    };
+
+    QString report = QString("Handoff benchmark (%1 帧):").arg(FRAMES);
+    report += run(0);
+    report += run(1);
+    report += run(2);
+    report += run(4);
+
+    frame = AudioFrameRef();
+    consumerThread.quit();
+    consumerThread.wait();
+    return report;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// oscBuilderReport() — 每条消息的编码耗时（两条路径逐字节一致由 tst_oscpacketbuilder 保证）
+// ─────────────────────────────────────────────────────────────────────────────
+QString oscBuilderReport()
+{
+    // 原实现（SoloOscBroadcaster::sendToOSC）
+    auto legacy = [](const QString &text) {
+        QByteArray oscData;
+        oscData.append(QString("/chatbox/input").toUtf8());
+        oscData.append('\0');
+        while (oscData.size() % 4 != 0) oscData.append('\0');
+        oscData.append(",sTT");
+        oscData.append('\0');
+        while (oscData.size() % 4 != 0) oscData.append('\0');
+        oscData.append(text.toUtf8());
+        oscData.append('\0');
+        while (oscData.size() % 4 != 0) oscData.append('\0');
+        return oscData;
+    };
+
+    const QString text = QString("今天天气不错，我们去公园散步吧。\nThe weather is nice today, let's go for a walk. ")
+                             .repeated(3).left(144);
+    const QByteArray prefix       = OscPacketBuilder::messagePrefix("/chatbox/input", ",sTT");
+    const QByteArray typingPrefix = OscPacketBuilder::messagePrefix("/chatbox/typing", ",F");
+    const QByteArray paramPrefix  = OscPacketBuilder::messagePrefix("/avatar/parameters/Talking", ",i");
+    constexpr int ITERATIONS = 100000;
+
+    QElapsedTimer timer;
+    QByteArray legacyPacket;
+    timer.start();
+    for (int i = 0; i < ITERATIONS; ++i) {
+        legacyPacket = legacy(text);
+    }
+    const double legacyNs = double(timer.nsecsElapsed()) / ITERATIONS;
+
+    OscPacketBuilder builder;
+    timer.restart();
+    for (int i = 0; i < ITERATIONS; ++i) {
+        builder.beginMessage(prefix);
+        builder.addString(text);
+    }
+    const double builderNs = double(timer.nsecsElapsed()) / ITERATIONS;
+
+    timer.restart();
+    for (int i = 0; i < ITERATIONS; ++i) {
+        builder.clear();
+        builder.beginBundle();
+        builder.beginMessage(prefix);
+        builder.addString(text);
+        builder.endMessage();
+        builder.beginMessage(typingPrefix);
+        builder.endMessage();
+        builder.beginMessage(paramPrefix);
+        builder.addInt(i & 1);
+        builder.endMessage();
+    }
+    const double bundleNs = double(timer.nsecsElapsed()) / ITERATIONS;
+
+    return QString("OSC packet builder benchmark (ns/报文, 144 字符聊天框):\n"
+                   "  原 append 路径 %1  编码器 %2  (%3x)\n"
+                   "  三条消息 bundle %4  (%5 字节)")
+        .arg(legacyNs, 0, 'f', 0).arg(builderNs, 0, 'f', 0)
+        .arg(builderNs > 0 ? legacyNs / builderNs : 0.0, 0, 'f', 1)
+        .arg(bundleNs, 0, 'f', 0).arg(builder.data().size());
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// xunfeiEncoderReport() — 整句模式首帧（携带全部音频）的编码耗时
+// 两条路径都算到 sendTextMessage 内部的 toUtf8() 为止，并校验 JSON 内容一致
+// ─────────────────────────────────────────────────────────────────────────────
+QString xunfeiEncoderReport()
+{
+    const QString appId      = "bench";
+    const int     sampleRate = 16000;
+
+    // 原实现（RecognitionSession::sendAudioFrame 的 QJson 版本）
+    auto legacy = [&](const QByteArray &audio) {
+        QJsonObject data;
+        data["status"]   = 0;
+        data["format"]   = QString("audio/L16;rate=%1").arg(sampleRate);
+        data["encoding"] = "raw";
+        data["audio"]    = QString::fromUtf8(audio.toBase64());
+
+        QJsonObject common;
+        common["app_id"] = appId;
+        QJsonObject business;
+        business["language"] = "zh_cn";
+        business["domain"]   = "iat";
+        business["accent"]   = "mandarin";
+        business["eos"]      = 10000;
+
+        QJsonObject frame;
+        frame["common"]   = common;
+        frame["business"] = business;
+        frame["data"]     = data;
+        return QString::fromUtf8(QJsonDocument(frame).toJson(QJsonDocument::Compact)).toUtf8();
+    };
+
+    XunFeiFrameEncoder encoder;
+    encoder.configure(appId, sampleRate);
+
+    QString report = QString("XunFei frame encoder benchmark (ms/帧, base64: %1):")
+                         .arg(Dsp::kernels().name);
+    const int seconds[] = { 1, 10, 60 };
+    for (int secs : seconds) {
+        QByteArray audio(secs * sampleRate * 2, Qt::Uninitialized);
+        for (qsizetype i = 0; i < audio.size(); ++i) {
+            audio[i] = static_cast<char>((i * 131) >> 3);
+        }
+        const int repeats = qMax(2, 20 / secs);
+
+        QElapsedTimer timer;
+        QByteArray legacyWire;
+        timer.start();
+        for (int r = 0; r < repeats; ++r) {
+            legacyWire = legacy(audio);
+        }
+        const double legacyMs = timer.nsecsElapsed() / 1e6 / repeats;
+
+        QByteArray wire;
+        timer.restart();
+        for (int r = 0; r < repeats; ++r) {
+            wire = XunFeiFrameEncoder::toMessage(encoder.encodeAudio(0, audio.constData(),
+                                                 static_cast<int>(audio.size()))).toUtf8();
+        }
+        const double encoderMs = timer.nsecsElapsed() / 1e6 / repeats;
+
+        const bool same = QJsonDocument::fromJson(wire).object()
+                          == QJsonDocument::fromJson(legacyWire).object();
+
+        report += QString("\n  %1s 音频  QJson %2  编码器 %3  (%4x)  内容%5")
+                      .arg(secs, 2)
+                      .arg(legacyMs, 0, 'f', 2)
+                      .arg(encoderMs, 0, 'f', 2)
+                      .arg(legacyMs / qMax(encoderMs, 1e-6), 0, 'f', 1)
+                      .arg(same ? "一致" : "不一致");
+    }
+    return report;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// xunfeiParserReport() — 对一条典型的中间结果消息反复解析
+//   QJson：原 onTextMessageReceived 的做法（toUtf8 + QJsonDocument + 逐层取对象）
+//   拉取式：本解析器，统计预热后结果缓冲区的扩容次数（即每条消息的堆分配）
+// ─────────────────────────────────────────────────────────────────────────────
+QString xunfeiParserReport()
+{
+    const QString message = QString::fromUtf8(
+        "{\"code\":0,\"message\":\"success\",\"sid\":\"iat000e1234@dx18f0a1b2c3d4e5f6\","
+        "\"data\":{\"result\":{\"sn\":3,\"ls\":false,\"bg\":0,\"ed\":0,\"pgs\":\"rpl\",\"rg\":[2,2],"
+        "\"ws\":[{\"bg\":12,\"cw\":[{\"sc\":0,\"w\":\"今天\"}]},"
+        "{\"bg\":60,\"cw\":[{\"sc\":0,\"w\":\"天气\"}]},"
+        "{\"bg\":96,\"cw\":[{\"sc\":0,\"w\":\"怎么样\"}]},"
+        "{\"bg\":140,\"cw\":[{\"sc\":0,\"w\":\"\\uff1f\"}]}]},\"status\":1}}");
+    constexpr int ROUNDS = 20000;
+
+    auto legacy = [](const QString &msg) {
+        const QJsonObject obj     = QJsonDocument::fromJson(msg.toUtf8()).object();
+        const QJsonObject dataObj = obj["data"].toObject();
+        const QJsonObject result  = dataObj["result"].toObject();
+        QString text;
+        for (const QJsonValue &ws : result["ws"].toArray()) {
+            for (const QJsonValue &cw : ws.toObject()["cw"].toArray()) {
+                text += cw.toObject()["w"].toString();
+            }
+        }
+        return text;
+    };
+
+    QElapsedTimer timer;
+    QString legacyText;
+    timer.start();
+    for (int i = 0; i < ROUNDS; ++i) {
+        legacyText = legacy(message);
+    }
+    const double legacyUs = timer.nsecsElapsed() / 1000.0 / ROUNDS;
+
+    XunFeiResultParser parser;
+    XunFeiResult result;
+    parser.parse(message, &result);   // 预热：结果缓冲区扩到所需容量
+    int growths = 0;
+    bool ok = true;
+    timer.restart();
+    for (int i = 0; i < ROUNDS; ++i) {
+        const qsizetype capacity = result.text.capacity();
+        ok = parser.parse(message, &result) && ok;
+        growths += (result.text.capacity() != capacity);
+    }
+    const double parserUs = timer.nsecsElapsed() / 1000.0 / ROUNDS;
+
+    const bool same = ok && result.text == legacyText && result.replace
+                      && result.sn == 3 && result.rangeBegin == 2 && result.rangeEnd == 2;
+
+    return QString("XunFei result parser benchmark (%1 字符/条):"
+                   "\n  QJson %2 us/条  拉取式 %3 us/条  (%4x)"
+                   "\n  拉取式稳态分配: %5 次/%6 条  结果%7")
+        .arg(message.size())
+        .arg(legacyUs, 0, 'f', 2)
+        .arg(parserUs, 0, 'f', 2)
+        .arg(legacyUs / qMax(parserUs, 1e-6), 0, 'f', 1)
+        .arg(growths)
+        .arg(ROUNDS)
+        .arg(same ? "一致" : "不一致");
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    std::printf("%s\n", dspKernelsReport().c_str());
+    std::printf("%s\n", audioConverterReport().c_str());
+    std::printf("%s\n", qPrintable(handoffReport()));
+    std::printf("%s\n", qPrintable(oscBuilderReport()));
+    std::printf("%s\n", qPrintable(xunfeiEncoderReport()));
+    std::printf("%s\n", qPrintable(xunfeiParserReport()));
+    return 0;
+}
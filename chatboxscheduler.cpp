@@ -0,0 +1,234 @@
+#include "chatboxscheduler.h"
+#include "solooscbroadcaster.h"
+#include "ConfigManager.h"
+#include <QTimer>
+
+namespace {
+bool isHighSurrogate(char16_t c) { return c >= 0xD800 && c < 0xDC00; }
+
+bool isSpace(char16_t c)
+{
+    return c == u' ' || c == u'\n' || c == u'\t' || c == u'\r' || c == 0x3000;
+}
+
+// 在此字符之后断页：空白或句读标点
+bool isBreakAfter(char16_t c)
+{
+    static constexpr char16_t PUNCT[] = u"，。！？；：、,.!?;:)）】」』…";
+    if (isSpace(c))
+        return true;
+    for (const char16_t *p = PUNCT; *p; ++p) {
+        if (*p == c)
+            return true;
+    }
+    return false;
+}
+
+qsizetype codepointCount(QStringView text)
+{
+    qsizetype count = 0;
+    for (qsizetype i = 0; i < text.size(); ++i) {
+        if (isHighSurrogate(text[i].unicode()) && i + 1 < text.size())
+            ++i;
+        ++count;
+    }
+    return count;
+}
+
+// 末尾 codepoints 个码点的起始下标（与 codepointCount 的计数方式一致，不拆开代理对）
+qsizetype lastCodepointsStart(QStringView text, qsizetype codepoints)
+{
+    qsizetype i = text.size();
+    while (i > 0 && codepoints > 0) {
+        --i;
+        if (i > 0 && text[i].isLowSurrogate() && isHighSurrogate(text[i - 1].unicode()))
+            --i;
+        --codepoints;
+    }
+    return i;
+}
+
+// 按码点切分正文，每段最多 bodyChars 个码点；若段内后半部分有空白或标点，
+// 在最后一个这样的位置之后断开，否则在码点边界硬断。段首空白略去，段尾空白去掉。
+QStringList splitPages(QStringView text, int bodyChars)
+{
+    QStringList pages;
+    qsizetype pos = 0;
+    while (pos < text.size()) {
+        while (pos < text.size() && isSpace(text[pos].unicode()))
+            ++pos;
+        if (pos >= text.size())
+            break;
+
+        qsizetype end = pos;
+        qsizetype lastBreak = -1;
+        int count = 0;
+        while (end < text.size() && count < bodyChars) {
+            const char16_t c = text[end].unicode();
+            end += (isHighSurrogate(c) && end + 1 < text.size()) ? 2 : 1;
+            ++count;
+            if (count >= bodyChars / 2 && isBreakAfter(c))
+                lastBreak = end;
+        }
+        if (end < text.size() && lastBreak > pos)
+            end = lastBreak;
+
+        qsizetype pageEnd = end;
+        while (pageEnd > pos && isSpace(text[pageEnd - 1].unicode()))
+            --pageEnd;
+        pages.append(text.sliced(pos, pageEnd - pos).toString());
+        pos = end;
+    }
+    return pages;
+}
+}
+
+ChatboxScheduler::ChatboxScheduler(SoloOscBroadcaster *osc, QObject *parent)
+    : QObject(parent)
+    , m_osc(osc)
+{}
+
+void ChatboxScheduler::initialize()
+{
+    ConfigManager& config = ConfigManager::getInstance();
+    m_partialEnabled = config.getPartialToChatbox();
+    m_intervalMs     = qMax(MIN_INTERVAL_MS, config.getChatboxIntervalMs());
+    m_liveIntervalMs = qMax(m_intervalMs, config.getPartialChatboxIntervalMs());
+    m_pageMs         = qMax(m_intervalMs, config.getChatboxPageMs());
+
+    // 定时器在所在线程（initialize 经排队调用执行）中创建
+    if (!m_timer) {
+        m_timer = new QTimer(this);
+        m_timer->setSingleShot(true);
+        connect(m_timer, &QTimer::timeout, this, &ChatboxScheduler::pump);
+        m_clock.start();
+    }
+    m_timer->stop();
+    m_pages.clear();
+    m_live.clear();
+    m_holdUntil = 0;
+    m_merged = m_dropped = 0;
+    reportQueue();
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// submitFinal() — 新的一句：分页后替换上一句尚未发出的页
+// 新句不必等上一句的页停留结束，只受发送间隔限制
+// ─────────────────────────────────────────────────────────────────────────────
+void ChatboxScheduler::submitFinal(const QString &text)
+{
+    if (!m_timer || text.isEmpty())
+        return;
+
+    m_dropped += quint64(m_pages.size());
+    m_pages = paginate(text);
+    m_notifyNext = true;
+    m_holdUntil  = 0;
+    if (!m_live.isEmpty()) {
+        ++m_merged;                 // 实时字幕已被最终译文取代
+        m_live.clear();
+    }
+    pump();
+}
+
+void ChatboxScheduler::submitProgress(const QString &text)
+{
+    submitLive(text);
+}
+
+void ChatboxScheduler::submitPartial(quint64 sessionId, const QString &text, int stableLength)
+{
+    Q_UNUSED(sessionId);
+    Q_UNUSED(stableLength);
+    if (m_partialEnabled)
+        submitLive(text);
+}
+
+// 实时字幕只保留最新一条；放不下时保留末尾，最新说的内容始终可见
+void ChatboxScheduler::submitLive(const QString &text)
+{
+    if (!m_timer || text.isEmpty())
+        return;
+
+    if (!m_live.isEmpty())
+        ++m_merged;
+    // 与 paginate() 一样按码点计长度：VRChat 的 144 字符上限按码点算
+    if (codepointCount(text) <= CHATBOX_MAX_CHARS) {
+        m_live = text;
+    } else {
+        m_live = QString("…") + text.sliced(lastCodepointsStart(text, CHATBOX_MAX_CHARS - 1));
+    }
+    pump();
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// pump() — 发出到期的一页或一条实时字幕；未到期则按最早到期时刻设定定时器
+// ─────────────────────────────────────────────────────────────────────────────
+void ChatboxScheduler::pump()
+{
+    const qint64 now = m_clock.elapsed();
+
+    // 最终译文的页优先；实时字幕还要满足自身的间隔，并等当前页停留结束
+    auto dueTime = [&]() -> qint64 {
+        const qint64 earliest = qMax(m_lastSendAt < 0 ? now : m_lastSendAt + m_intervalMs, m_holdUntil);
+        if (!m_pages.isEmpty())
+            return earliest;
+        if (!m_live.isEmpty())
+            return qMax(earliest, m_lastLiveAt < 0 ? now : m_lastLiveAt + m_liveIntervalMs);
+        return -1;
+    };
+
+    qint64 due = dueTime();
+    if (due >= 0 && now >= due) {
+        if (!m_pages.isEmpty()) {
+            m_osc->sendChatbox(m_pages.takeFirst(), m_notifyNext);
+            m_notifyNext = false;
+            m_holdUntil  = now + m_pageMs;
+        } else {
+            m_osc->sendChatbox(m_live, false);
+            m_live.clear();
+            m_lastLiveAt = now;
+        }
+        m_lastSendAt = now;
+        due = dueTime();            // 还有下一页 / 实时字幕时继续排期
+    }
+
+    if (due >= 0)
+        m_timer->start(int(qMax<qint64>(0, due - now)));
+    else
+        m_timer->stop();
+
+    reportQueue();
+}
+
+void ChatboxScheduler::reportQueue()
+{
+    emit queueChanged(int(m_pages.size()), !m_live.isEmpty(), m_merged, m_dropped);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// paginate() — 按码点分页，每页正文 + 页码后缀 " [i/n]" 不超过 maxChars 个码点
+// 后缀长度取决于总页数 n 的位数：先按一位数预留，分出的页数位数更多时
+// 加大预留重新切分（页数不超过文本长度，预留位数追上页数位数后即停止）
+// ─────────────────────────────────────────────────────────────────────────────
+QStringList ChatboxScheduler::paginate(QStringView text, int maxChars)
+{
+    QStringList pages;
+    if (codepointCount(text) <= maxChars) {
+        pages.append(text.toString());
+        return pages;
+    }
+
+    for (int digits = 1; ; ++digits) {
+        const int suffixChars = 4 + 2 * digits;    // " [" + i + "/" + n + "]"
+        pages = splitPages(text, qMax(1, maxChars - suffixChars));
+        if (QString::number(pages.size()).size() <= digits)
+            break;
+    }
+
+    if (pages.size() > 1) {
+        for (qsizetype i = 0; i < pages.size(); ++i)
+            pages[i] += QString(" [%1/%2]").arg(i + 1).arg(pages.size());
+    }
+    return pages;
+}
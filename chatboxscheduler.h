@@ -0,0 +1,82 @@
+#ifndef CHATBOXSCHEDULER_H
+#define CHATBOXSCHEDULER_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QStringView>
+#include <QElapsedTimer>
+
+class QTimer;
+class SoloOscBroadcaster;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// ChatboxScheduler — 聊天框输出调度
+//
+// VRChat 聊天框最多显示 144 个字符，且过快的 /chatbox/input 会被丢弃。
+// 原来每条译文直接整段发出：长句被截断，连续几句只剩最后一句。
+//
+// · 最终译文按码点分页（优先在空白/标点处断开，不拆开代理对），
+//   每页至少停留 m_pageMs 再翻下一页，第一页带提示音，其余页不带
+// · 任意两次发送间隔不少于 m_intervalMs（限速）
+// · 新的一句到达时，上一句还没发出的页直接丢弃，新句优先
+// · 实时字幕（识别中间结果 / 流式译文进度）只保留最新一条，被覆盖的计为合并；
+//   优先级低于最终译文，当前页停留时间结束后才显示
+// 运行在 OSC 所在线程，直接调用 SoloOscBroadcaster 发送。
+// ─────────────────────────────────────────────────────────────────────────────
+class ChatboxScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ChatboxScheduler(SoloOscBroadcaster *osc, QObject *parent = nullptr);
+
+    // 按码点分页；超过一页时每页末尾附加 " [页码/总页数]"
+    static QStringList paginate(QStringView text, int maxChars = CHATBOX_MAX_CHARS);
+
+    static constexpr int CHATBOX_MAX_CHARS = 144;   // VRChat 聊天框长度上限
+
+public slots:
+    void initialize();
+
+    // 最终译文（由 Translator::translationFinished 触发）
+    void submitFinal(const QString &text);
+    // 流式译文进度（由 Translator::translationProgress 触发）
+    void submitProgress(const QString &text);
+    // 识别中间结果（由 SpeechRecogniser::recognitionPartial 触发，需开启 partialToChatbox）
+    void submitPartial(quint64 sessionId, const QString &text, int stableLength);
+
+signals:
+    // pendingPages: 尚未发出的页数；live: 是否有等待中的实时字幕；
+    // merged: 被后来内容覆盖的实时字幕累计数；dropped: 被新句顶掉的页累计数
+    void queueChanged(int pendingPages, bool live, quint64 merged, quint64 dropped);
+
+private:
+    void submitLive(const QString &text);
+    void pump();                    // 发出到期的内容，并为下一次安排定时器
+    void reportQueue();
+
+    SoloOscBroadcaster *m_osc;
+    QTimer             *m_timer = nullptr;
+    QElapsedTimer       m_clock;
+
+    QStringList m_pages;            // 当前这一句尚未发出的页
+    bool        m_notifyNext = false;   // 下一页是否为新句第一页（带提示音）
+    QString     m_live;             // 最新的实时字幕
+
+    qint64 m_lastSendAt = -1;       // 上次发送时刻（m_clock 毫秒），-1 表示尚未发送
+    qint64 m_lastLiveAt = -1;
+    qint64 m_holdUntil  = 0;        // 当前页至少显示到此时刻
+
+    quint64 m_merged  = 0;
+    quint64 m_dropped = 0;
+
+    bool m_partialEnabled = false;  // 配置 partialToChatbox
+    int  m_liveIntervalMs = 1500;   // 配置 partialChatboxIntervalMs
+    int  m_intervalMs     = 1500;   // 配置 chatboxIntervalMs
+    int  m_pageMs         = 3000;   // 配置 chatboxPageMs
+
+    static constexpr int MIN_INTERVAL_MS = 1000;
+};
+
+#endif // CHATBOXSCHEDULER_H
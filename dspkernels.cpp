@@ -0,0 +1,810 @@
+#include "dspkernels.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#  define DSP_X86 1
+#  include <immintrin.h>
+#  if defined(_MSC_VER) && !defined(__clang__)
+#    include <intrin.h>
+#    define DSP_TARGET_SSE2
+#    define DSP_TARGET_AVX2
+#  else
+#    define DSP_TARGET_SSE2 __attribute__((target("sse2")))
+#    define DSP_TARGET_AVX2 __attribute__((target("avx2")))
+#  endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#  define DSP_NEON 1
+#  include <arm_neon.h>
+#endif
+
+namespace Dsp {
+
+namespace {
+
+constexpr float INT16_SCALE     = 1.0f / 32768.0f;
+constexpr int   ZCR_FLUSH_ITERS = 16384;   // 16 位计数器在溢出前必须归并
+
+constexpr char BASE64_ALPHABET[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// ─────────────────────────────────────────────────────────────────────────────
+// 标量实现
+// ─────────────────────────────────────────────────────────────────────────────
+double sumSquaresScalar(const int16_t *x, int n)
+{
+    int64_t acc = 0;
+    for (int i = 0; i < n; ++i) {
+        acc += static_cast<int32_t>(x[i]) * x[i];
+    }
+    return static_cast<double>(acc);
+}
+
+int zeroCrossingsScalar(const int16_t *x, int n)
+{
+    int count = 0;
+    for (int i = 1; i < n; ++i) {
+        count += ((x[i] < 0) != (x[i - 1] < 0));
+    }
+    return count;
+}
+
+int peakAbsScalar(const int16_t *x, int n)
+{
+    int peak = 0;
+    for (int i = 0; i < n; ++i) {
+        peak = std::max(peak, std::abs(static_cast<int>(x[i])));
+    }
+    return peak;
+}
+
+void int16ToFloatScalar(const int16_t *x, float *out, int n)
+{
+    for (int i = 0; i < n; ++i) {
+        out[i] = x[i] * INT16_SCALE;
+    }
+}
+
+inline int16_t floatSampleToInt16(float v)
+{
+    v *= 32768.0f;
+    v = std::min(std::max(v, -32768.0f), 32767.0f);
+    return static_cast<int16_t>(std::lrint(v));
+}
+
+void floatToInt16Scalar(const float *x, int16_t *out, int n)
+{
+    for (int i = 0; i < n; ++i) {
+        out[i] = floatSampleToInt16(x[i]);
+    }
+}
+
+float removeDcScalar(float *x, int n)
+{
+    if (n <= 0) return 0.0f;
+    double sum = 0.0;
+    for (int i = 0; i < n; ++i) {
+        sum += x[i];
+    }
+    const float mean = static_cast<float>(sum / n);
+    for (int i = 0; i < n; ++i) {
+        x[i] -= mean;
+    }
+    return mean;
+}
+
+float dotScalar(const float *a, const float *b, int n)
+{
+    float acc = 0.0f;
+    for (int i = 0; i < n; ++i) {
+        acc += a[i] * b[i];
+    }
+    return acc;
+}
+
+// 每 3 字节查表输出 4 个字符，末尾不足 3 字节时补 '='；向量实现也用它处理尾部
+size_t base64EncodeScalar(const uint8_t *in, size_t n, char *out)
+{
+    char *dst = out;
+    size_t i = 0;
+    for (; i + 3 <= n; i += 3) {
+        const uint32_t v = (uint32_t(in[i]) << 16) | (uint32_t(in[i + 1]) << 8) | in[i + 2];
+        dst[0] = BASE64_ALPHABET[(v >> 18) & 0x3F];
+        dst[1] = BASE64_ALPHABET[(v >> 12) & 0x3F];
+        dst[2] = BASE64_ALPHABET[(v >> 6) & 0x3F];
+        dst[3] = BASE64_ALPHABET[v & 0x3F];
+        dst += 4;
+    }
+    if (i < n) {
+        const bool     two = (n - i == 2);
+        const uint32_t v   = (uint32_t(in[i]) << 16) | (two ? uint32_t(in[i + 1]) << 8 : 0);
+        dst[0] = BASE64_ALPHABET[(v >> 18) & 0x3F];
+        dst[1] = BASE64_ALPHABET[(v >> 12) & 0x3F];
+        dst[2] = two ? BASE64_ALPHABET[(v >> 6) & 0x3F] : '=';
+        dst[3] = '=';
+        dst += 4;
+    }
+    return static_cast<size_t>(dst - out);
+}
+
+const Kernels SCALAR_KERNELS = {
+    "scalar",
+    sumSquaresScalar,
+    zeroCrossingsScalar,
+    peakAbsScalar,
+    int16ToFloatScalar,
+    floatToInt16Scalar,
+    removeDcScalar,
+    dotScalar,
+    base64EncodeScalar
+};
+
+#if defined(DSP_X86)
+// ─────────────────────────────────────────────────────────────────────────────
+// SSE2 实现（8 × int16 / 4 × float）
+// ─────────────────────────────────────────────────────────────────────────────
+DSP_TARGET_SSE2 double sumSquaresSse2(const int16_t *x, int n)
+{
+    // madd 把相邻两个平方相加成 32 位，最大 2×32768² = 2^31，按无符号解释不会溢出，
+    // 再零扩展到 64 位累加
+    const __m128i zero = _mm_setzero_si128();
+    __m128i acc = _mm_setzero_si128();
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m128i v  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i));
+        const __m128i sq = _mm_madd_epi16(v, v);
+        acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(sq, zero));
+        acc = _mm_add_epi64(acc, _mm_unpackhi_epi32(sq, zero));
+    }
+    alignas(16) uint64_t lanes[2];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+    int64_t total = static_cast<int64_t>(lanes[0] + lanes[1]);
+    for (; i < n; ++i) {
+        total += static_cast<int32_t>(x[i]) * x[i];
+    }
+    return static_cast<double>(total);
+}
+
+DSP_TARGET_SSE2 int zeroCrossingsSse2(const int16_t *x, int n)
+{
+    if (n < 2) return 0;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ones = _mm_set1_epi16(1);
+    int count = 0;
+    int i = 1;
+    int iters = 0;
+    __m128i acc = _mm_setzero_si128();
+    for (; i + 8 <= n; i += 8) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i - 1));
+        const __m128i d = _mm_xor_si128(_mm_cmplt_epi16(a, zero), _mm_cmplt_epi16(b, zero));
+        acc = _mm_sub_epi16(acc, d);   // d 为 -1 表示一次过零
+        if (++iters == ZCR_FLUSH_ITERS) {
+            alignas(16) int32_t s[4];
+            _mm_store_si128(reinterpret_cast<__m128i*>(s), _mm_madd_epi16(acc, ones));
+            count += s[0] + s[1] + s[2] + s[3];
+            acc   = _mm_setzero_si128();
+            iters = 0;
+        }
+    }
+    alignas(16) int32_t s[4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(s), _mm_madd_epi16(acc, ones));
+    count += s[0] + s[1] + s[2] + s[3];
+    for (; i < n; ++i) {
+        count += ((x[i] < 0) != (x[i - 1] < 0));
+    }
+    return count;
+}
+
+DSP_TARGET_SSE2 int peakAbsSse2(const int16_t *x, int n)
+{
+    __m128i mx = _mm_set1_epi16(0);
+    __m128i mn = _mm_set1_epi16(0);
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i));
+        mx = _mm_max_epi16(mx, v);
+        mn = _mm_min_epi16(mn, v);
+    }
+    alignas(16) int16_t hi[8];
+    alignas(16) int16_t lo[8];
+    _mm_store_si128(reinterpret_cast<__m128i*>(hi), mx);
+    _mm_store_si128(reinterpret_cast<__m128i*>(lo), mn);
+    int peak = 0;
+    for (int k = 0; k < 8; ++k) {
+        peak = std::max(peak, std::max(static_cast<int>(hi[k]), -static_cast<int>(lo[k])));
+    }
+    for (; i < n; ++i) {
+        peak = std::max(peak, std::abs(static_cast<int>(x[i])));
+    }
+    return peak;
+}
+
+DSP_TARGET_SSE2 void int16ToFloatSse2(const int16_t *x, float *out, int n)
+{
+    const __m128 scale = _mm_set1_ps(INT16_SCALE);
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m128i v  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i));
+        // 与自身交错后算术右移 16 位，即符号扩展到 32 位
+        const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+        const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+        _mm_storeu_ps(out + i,     _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+        _mm_storeu_ps(out + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+    }
+    for (; i < n; ++i) {
+        out[i] = x[i] * INT16_SCALE;
+    }
+}
+
+DSP_TARGET_SSE2 void floatToInt16Sse2(const float *x, int16_t *out, int n)
+{
+    const __m128 scale = _mm_set1_ps(32768.0f);
+    const __m128 lo    = _mm_set1_ps(-32768.0f);
+    const __m128 hi    = _mm_set1_ps(32767.0f);
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128 a = _mm_mul_ps(_mm_loadu_ps(x + i), scale);
+        __m128 b = _mm_mul_ps(_mm_loadu_ps(x + i + 4), scale);
+        a = _mm_min_ps(_mm_max_ps(a, lo), hi);
+        b = _mm_min_ps(_mm_max_ps(b, lo), hi);
+        const __m128i packed = _mm_packs_epi32(_mm_cvtps_epi32(a), _mm_cvtps_epi32(b));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), packed);
+    }
+    for (; i < n; ++i) {
+        out[i] = floatSampleToInt16(x[i]);
+    }
+}
+
+DSP_TARGET_SSE2 float removeDcSse2(float *x, int n)
+{
+    if (n <= 0) return 0.0f;
+    __m128 acc = _mm_setzero_ps();
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        acc = _mm_add_ps(acc, _mm_loadu_ps(x + i));
+    }
+    alignas(16) float s[4];
+    _mm_store_ps(s, acc);
+    double sum = static_cast<double>(s[0]) + s[1] + s[2] + s[3];
+    for (; i < n; ++i) {
+        sum += x[i];
+    }
+    const float  mean = static_cast<float>(sum / n);
+    const __m128 m    = _mm_set1_ps(mean);
+    for (i = 0; i + 4 <= n; i += 4) {
+        _mm_storeu_ps(x + i, _mm_sub_ps(_mm_loadu_ps(x + i), m));
+    }
+    for (; i < n; ++i) {
+        x[i] -= mean;
+    }
+    return mean;
+}
+
+DSP_TARGET_SSE2 float dotSse2(const float *a, const float *b, int n)
+{
+    // 两组累加器交替使用，隐藏加法延迟
+    __m128 acc0 = _mm_setzero_ps();
+    __m128 acc1 = _mm_setzero_ps();
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(a + i),     _mm_loadu_ps(b + i)));
+        acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+    }
+    alignas(16) float s[4];
+    _mm_store_ps(s, _mm_add_ps(acc0, acc1));
+    float acc = (s[0] + s[1]) + (s[2] + s[3]);
+    for (; i < n; ++i) {
+        acc += a[i] * b[i];
+    }
+    return acc;
+}
+
+const Kernels SSE2_KERNELS = {
+    "sse2",
+    sumSquaresSse2,
+    zeroCrossingsSse2,
+    peakAbsSse2,
+    int16ToFloatSse2,
+    floatToInt16Sse2,
+    removeDcSse2,
+    dotSse2,
+    base64EncodeScalar   // 需要 pshufb（SSSE3），SSE2 组沿用标量实现
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+// AVX2 实现（16 × int16 / 8 × float）
+// ─────────────────────────────────────────────────────────────────────────────
+DSP_TARGET_AVX2 double sumSquaresAvx2(const int16_t *x, int n)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i acc = _mm256_setzero_si256();
+    int i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m256i v  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i));
+        const __m256i sq = _mm256_madd_epi16(v, v);
+        acc = _mm256_add_epi64(acc, _mm256_unpacklo_epi32(sq, zero));
+        acc = _mm256_add_epi64(acc, _mm256_unpackhi_epi32(sq, zero));
+    }
+    alignas(32) uint64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    int64_t total = static_cast<int64_t>(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+    for (; i < n; ++i) {
+        total += static_cast<int32_t>(x[i]) * x[i];
+    }
+    return static_cast<double>(total);
+}
+
+DSP_TARGET_AVX2 int zeroCrossingsAvx2(const int16_t *x, int n)
+{
+    if (n < 2) return 0;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i ones = _mm256_set1_epi16(1);
+    int count = 0;
+    int i = 1;
+    int iters = 0;
+    __m256i acc = _mm256_setzero_si256();
+    for (; i + 16 <= n; i += 16) {
+        const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i));
+        const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i - 1));
+        const __m256i d = _mm256_xor_si256(_mm256_cmpgt_epi16(zero, a),
+                                           _mm256_cmpgt_epi16(zero, b));
+        acc = _mm256_sub_epi16(acc, d);
+        if (++iters == ZCR_FLUSH_ITERS) {
+            alignas(32) int32_t s[8];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(s), _mm256_madd_epi16(acc, ones));
+            for (int k = 0; k < 8; ++k) count += s[k];
+            acc   = _mm256_setzero_si256();
+            iters = 0;
+        }
+    }
+    alignas(32) int32_t s[8];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(s), _mm256_madd_epi16(acc, ones));
+    for (int k = 0; k < 8; ++k) count += s[k];
+    for (; i < n; ++i) {
+        count += ((x[i] < 0) != (x[i - 1] < 0));
+    }
+    return count;
+}
+
+DSP_TARGET_AVX2 int peakAbsAvx2(const int16_t *x, int n)
+{
+    __m256i mx = _mm256_setzero_si256();
+    __m256i mn = _mm256_setzero_si256();
+    int i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i));
+        mx = _mm256_max_epi16(mx, v);
+        mn = _mm256_min_epi16(mn, v);
+    }
+    alignas(32) int16_t hi[16];
+    alignas(32) int16_t lo[16];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(hi), mx);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lo), mn);
+    int peak = 0;
+    for (int k = 0; k < 16; ++k) {
+        peak = std::max(peak, std::max(static_cast<int>(hi[k]), -static_cast<int>(lo[k])));
+    }
+    for (; i < n; ++i) {
+        peak = std::max(peak, std::abs(static_cast<int>(x[i])));
+    }
+    return peak;
+}
+
+DSP_TARGET_AVX2 void int16ToFloatAvx2(const int16_t *x, float *out, int n)
+{
+    const __m256 scale = _mm256_set1_ps(INT16_SCALE);
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i));
+        const __m256i w = _mm256_cvtepi16_epi32(v);
+        _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_cvtepi32_ps(w), scale));
+    }
+    for (; i < n; ++i) {
+        out[i] = x[i] * INT16_SCALE;
+    }
+}
+
+DSP_TARGET_AVX2 void floatToInt16Avx2(const float *x, int16_t *out, int n)
+{
+    const __m256 scale = _mm256_set1_ps(32768.0f);
+    const __m256 lo    = _mm256_set1_ps(-32768.0f);
+    const __m256 hi    = _mm256_set1_ps(32767.0f);
+    int i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256 a = _mm256_mul_ps(_mm256_loadu_ps(x + i), scale);
+        __m256 b = _mm256_mul_ps(_mm256_loadu_ps(x + i + 8), scale);
+        a = _mm256_min_ps(_mm256_max_ps(a, lo), hi);
+        b = _mm256_min_ps(_mm256_max_ps(b, lo), hi);
+        // packs 在每个 128 位通道内交错，需要再按 64 位重排恢复顺序
+        __m256i packed = _mm256_packs_epi32(_mm256_cvtps_epi32(a), _mm256_cvtps_epi32(b));
+        packed = _mm256_permute4x64_epi64(packed, 0xD8);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), packed);
+    }
+    for (; i < n; ++i) {
+        out[i] = floatSampleToInt16(x[i]);
+    }
+}
+
+DSP_TARGET_AVX2 float removeDcAvx2(float *x, int n)
+{
+    if (n <= 0) return 0.0f;
+    __m256 acc = _mm256_setzero_ps();
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        acc = _mm256_add_ps(acc, _mm256_loadu_ps(x + i));
+    }
+    alignas(32) float s[8];
+    _mm256_store_ps(s, acc);
+    double sum = 0.0;
+    for (int k = 0; k < 8; ++k) sum += s[k];
+    for (; i < n; ++i) {
+        sum += x[i];
+    }
+    const float  mean = static_cast<float>(sum / n);
+    const __m256 m    = _mm256_set1_ps(mean);
+    for (i = 0; i + 8 <= n; i += 8) {
+        _mm256_storeu_ps(x + i, _mm256_sub_ps(_mm256_loadu_ps(x + i), m));
+    }
+    for (; i < n; ++i) {
+        x[i] -= mean;
+    }
+    return mean;
+}
+
+DSP_TARGET_AVX2 float dotAvx2(const float *a, const float *b, int n)
+{
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    int i = 0;
+    for (; i + 16 <= n; i += 16) {
+        acc0 = _mm256_add_ps(acc0, _mm256_mul_ps(_mm256_loadu_ps(a + i),     _mm256_loadu_ps(b + i)));
+        acc1 = _mm256_add_ps(acc1, _mm256_mul_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8)));
+    }
+    const __m256 sum  = _mm256_add_ps(acc0, acc1);
+    const __m128 half = _mm_add_ps(_mm256_castps256_ps128(sum), _mm256_extractf128_ps(sum, 1));
+    alignas(16) float s[4];
+    _mm_store_ps(s, half);
+    float acc = (s[0] + s[1]) + (s[2] + s[3]);
+    for (; i < n; ++i) {
+        acc += a[i] * b[i];
+    }
+    return acc;
+}
+
+// base64：每次取 24 字节分到两个 128 位通道（各 12 字节），
+// pshufb 把每 3 字节排成 [b a c b]，再用乘法移位拆出 4 个 6 位索引，
+// 最后按索引所在区间（A-Z / a-z / 0-9 / + /）加上对应偏移得到 ASCII
+DSP_TARGET_AVX2 size_t base64EncodeAvx2(const uint8_t *in, size_t n, char *out)
+{
+    const __m256i shuffle = _mm256_setr_epi8(
+        1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+        1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+    const __m256i offsets = _mm256_setr_epi8(
+        65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0,
+        65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0);
+
+    char *dst = out;
+    size_t i = 0;
+    // 第二个通道读取 in[i+12 .. i+27]，保证不越界
+    for (; i + 28 <= n; i += 24) {
+        const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 12));
+        __m256i v = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+        v = _mm256_shuffle_epi8(v, shuffle);
+
+        const __m256i t0 = _mm256_and_si256(v, _mm256_set1_epi32(0x0FC0FC00));
+        const __m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+        const __m256i t2 = _mm256_and_si256(v, _mm256_set1_epi32(0x003F03F0));
+        const __m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+        const __m256i idx = _mm256_or_si256(t1, t3);
+
+        __m256i range = _mm256_subs_epu8(idx, _mm256_set1_epi8(51));
+        range = _mm256_sub_epi8(range, _mm256_cmpgt_epi8(idx, _mm256_set1_epi8(25)));
+        const __m256i ascii = _mm256_add_epi8(idx, _mm256_shuffle_epi8(offsets, range));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), ascii);
+        dst += 32;
+    }
+    dst += base64EncodeScalar(in + i, n - i, dst);
+    return static_cast<size_t>(dst - out);
+}
+
+const Kernels AVX2_KERNELS = {
+    "avx2",
+    sumSquaresAvx2,
+    zeroCrossingsAvx2,
+    peakAbsAvx2,
+    int16ToFloatAvx2,
+    floatToInt16Avx2,
+    removeDcAvx2,
+    dotAvx2,
+    base64EncodeAvx2
+};
+
+// ─── CPU 能力检测 ────────────────────────────────────────────────────────────
+bool cpuHasSse2()
+{
+#if defined(__x86_64__) || defined(_M_X64)
+    return true;   // x86-64 基线
+#elif defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 1);
+    return (info[3] & (1 << 26)) != 0;
+#else
+    return __builtin_cpu_supports("sse2");
+#endif
+}
+
+bool cpuHasAvx2()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return false;
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx     = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx) return false;
+    if ((_xgetbv(0) & 0x6) != 0x6) return false;   // 操作系统需保存 YMM 寄存器
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+#endif // DSP_X86
+
+#if defined(DSP_NEON)
+// ─────────────────────────────────────────────────────────────────────────────
+// NEON 实现（8 × int16 / 4 × float）
+// ─────────────────────────────────────────────────────────────────────────────
+double sumSquaresNeon(const int16_t *x, int n)
+{
+    int64x2_t acc = vdupq_n_s64(0);
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const int16x8_t v  = vld1q_s16(x + i);
+        const int32x4_t lo = vmull_s16(vget_low_s16(v),  vget_low_s16(v));
+        const int32x4_t hi = vmull_s16(vget_high_s16(v), vget_high_s16(v));
+        acc = vpadalq_s32(acc, lo);
+        acc = vpadalq_s32(acc, hi);
+    }
+    int64_t total = vgetq_lane_s64(acc, 0) + vgetq_lane_s64(acc, 1);
+    for (; i < n; ++i) {
+        total += static_cast<int32_t>(x[i]) * x[i];
+    }
+    return static_cast<double>(total);
+}
+
+int zeroCrossingsNeon(const int16_t *x, int n)
+{
+    if (n < 2) return 0;
+    const int16x8_t zero = vdupq_n_s16(0);
+    int count = 0;
+    int i = 1;
+    int iters = 0;
+    uint16x8_t acc = vdupq_n_u16(0);
+    auto flush = [&]() {
+        const uint64x2_t s = vpaddlq_u32(vpaddlq_u16(acc));
+        count += static_cast<int>(vgetq_lane_u64(s, 0) + vgetq_lane_u64(s, 1));
+        acc = vdupq_n_u16(0);
+    };
+    for (; i + 8 <= n; i += 8) {
+        const uint16x8_t ma = vcltq_s16(vld1q_s16(x + i), zero);
+        const uint16x8_t mb = vcltq_s16(vld1q_s16(x + i - 1), zero);
+        // 掩码为 0xFFFF，右移 15 位得到 0/1
+        acc = vaddq_u16(acc, vshrq_n_u16(veorq_u16(ma, mb), 15));
+        if (++iters == ZCR_FLUSH_ITERS) {
+            flush();
+            iters = 0;
+        }
+    }
+    flush();
+    for (; i < n; ++i) {
+        count += ((x[i] < 0) != (x[i - 1] < 0));
+    }
+    return count;
+}
+
+int peakAbsNeon(const int16_t *x, int n)
+{
+    int16x8_t mx = vdupq_n_s16(0);
+    int16x8_t mn = vdupq_n_s16(0);
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const int16x8_t v = vld1q_s16(x + i);
+        mx = vmaxq_s16(mx, v);
+        mn = vminq_s16(mn, v);
+    }
+    int16_t hi[8];
+    int16_t lo[8];
+    vst1q_s16(hi, mx);
+    vst1q_s16(lo, mn);
+    int peak = 0;
+    for (int k = 0; k < 8; ++k) {
+        peak = std::max(peak, std::max(static_cast<int>(hi[k]), -static_cast<int>(lo[k])));
+    }
+    for (; i < n; ++i) {
+        peak = std::max(peak, std::abs(static_cast<int>(x[i])));
+    }
+    return peak;
+}
+
+void int16ToFloatNeon(const int16_t *x, float *out, int n)
+{
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const int16x8_t v = vld1q_s16(x + i);
+        vst1q_f32(out + i,     vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(v))),  INT16_SCALE));
+        vst1q_f32(out + i + 4, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(v))), INT16_SCALE));
+    }
+    for (; i < n; ++i) {
+        out[i] = x[i] * INT16_SCALE;
+    }
+}
+
+inline int32x4_t roundToInt32Neon(float32x4_t v)
+{
+#if defined(__aarch64__) || defined(_M_ARM64)
+    return vcvtnq_s32_f32(v);
+#else
+    // ARMv7 只有截断转换：加减 0.5 后截断（四舍五入远离零）
+    const float32x4_t half = vbslq_f32(vcltq_f32(v, vdupq_n_f32(0.0f)),
+                                       vdupq_n_f32(-0.5f), vdupq_n_f32(0.5f));
+    return vcvtq_s32_f32(vaddq_f32(v, half));
+#endif
+}
+
+void floatToInt16Neon(const float *x, int16_t *out, int n)
+{
+    const float32x4_t lo = vdupq_n_f32(-32768.0f);
+    const float32x4_t hi = vdupq_n_f32(32767.0f);
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        float32x4_t a = vmulq_n_f32(vld1q_f32(x + i),     32768.0f);
+        float32x4_t b = vmulq_n_f32(vld1q_f32(x + i + 4), 32768.0f);
+        a = vminq_f32(vmaxq_f32(a, lo), hi);
+        b = vminq_f32(vmaxq_f32(b, lo), hi);
+        const int16x8_t packed = vcombine_s16(vqmovn_s32(roundToInt32Neon(a)),
+                                              vqmovn_s32(roundToInt32Neon(b)));
+        vst1q_s16(out + i, packed);
+    }
+    for (; i < n; ++i) {
+        out[i] = floatSampleToInt16(x[i]);
+    }
+}
+
+float removeDcNeon(float *x, int n)
+{
+    if (n <= 0) return 0.0f;
+    float32x4_t acc = vdupq_n_f32(0.0f);
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        acc = vaddq_f32(acc, vld1q_f32(x + i));
+    }
+    float s[4];
+    vst1q_f32(s, acc);
+    double sum = static_cast<double>(s[0]) + s[1] + s[2] + s[3];
+    for (; i < n; ++i) {
+        sum += x[i];
+    }
+    const float       mean = static_cast<float>(sum / n);
+    const float32x4_t m    = vdupq_n_f32(mean);
+    for (i = 0; i + 4 <= n; i += 4) {
+        vst1q_f32(x + i, vsubq_f32(vld1q_f32(x + i), m));
+    }
+    for (; i < n; ++i) {
+        x[i] -= mean;
+    }
+    return mean;
+}
+
+float dotNeon(const float *a, const float *b, int n)
+{
+    float32x4_t acc0 = vdupq_n_f32(0.0f);
+    float32x4_t acc1 = vdupq_n_f32(0.0f);
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        acc0 = vmlaq_f32(acc0, vld1q_f32(a + i),     vld1q_f32(b + i));
+        acc1 = vmlaq_f32(acc1, vld1q_f32(a + i + 4), vld1q_f32(b + i + 4));
+    }
+    float s[4];
+    vst1q_f32(s, vaddq_f32(acc0, acc1));
+    float acc = (s[0] + s[1]) + (s[2] + s[3]);
+    for (; i < n; ++i) {
+        acc += a[i] * b[i];
+    }
+    return acc;
+}
+
+// base64：vld3 按字节解交织 48 字节，移位拼出 4 路 6 位索引，
+// 64 字节字母表查表（vqtbl4q，仅 AArch64）后 vst4 交织写回；ARMv7 退回标量
+size_t base64EncodeNeon(const uint8_t *in, size_t n, char *out)
+{
+#if defined(__aarch64__) || defined(_M_ARM64)
+    uint8x16x4_t table;
+    for (int t = 0; t < 4; ++t) {
+        table.val[t] = vld1q_u8(reinterpret_cast<const uint8_t*>(BASE64_ALPHABET) + 16 * t);
+    }
+    const uint8x16_t mask6 = vdupq_n_u8(0x3F);
+
+    char *dst = out;
+    size_t i = 0;
+    for (; i + 48 <= n; i += 48) {
+        const uint8x16x3_t src = vld3q_u8(in + i);
+        uint8x16x4_t idx;
+        idx.val[0] = vshrq_n_u8(src.val[0], 2);
+        idx.val[1] = vandq_u8(vorrq_u8(vshrq_n_u8(src.val[1], 4), vshlq_n_u8(src.val[0], 4)), mask6);
+        idx.val[2] = vandq_u8(vorrq_u8(vshrq_n_u8(src.val[2], 6), vshlq_n_u8(src.val[1], 2)), mask6);
+        idx.val[3] = vandq_u8(src.val[2], mask6);
+
+        uint8x16x4_t ascii;
+        for (int t = 0; t < 4; ++t) {
+            ascii.val[t] = vqtbl4q_u8(table, idx.val[t]);
+        }
+        vst4q_u8(reinterpret_cast<uint8_t*>(dst), ascii);
+        dst += 64;
+    }
+    dst += base64EncodeScalar(in + i, n - i, dst);
+    return static_cast<size_t>(dst - out);
+#else
+    return base64EncodeScalar(in, n, out);
+#endif
+}
+
+const Kernels NEON_KERNELS = {
+    "neon",
+    sumSquaresNeon,
+    zeroCrossingsNeon,
+    peakAbsNeon,
+    int16ToFloatNeon,
+    floatToInt16Neon,
+    removeDcNeon,
+    dotNeon,
+    base64EncodeNeon
+};
+#endif // DSP_NEON
+
+} // namespace
+
+// ─────────────────────────────────────────────────────────────────────────────
+// 对外接口
+// ─────────────────────────────────────────────────────────────────────────────
+std::vector<const Kernels*> availableKernels()
+{
+    std::vector<const Kernels*> list{ &SCALAR_KERNELS };
+#if defined(DSP_X86)
+    if (cpuHasSse2()) list.push_back(&SSE2_KERNELS);
+    if (cpuHasAvx2()) list.push_back(&AVX2_KERNELS);
+#elif defined(DSP_NEON)
+    list.push_back(&NEON_KERNELS);
+#endif
+    return list;
+}
+
+const Kernels &kernels()
+{
+    static const Kernels &best = *availableKernels().back();
+    return best;
+}
+
+const Kernels &scalarKernels()
+{
+    return SCALAR_KERNELS;
+}
+
+float rms(const int16_t *x, int n)
+{
+    if (n <= 0) return 0.0f;
+    return static_cast<float>(std::sqrt(kernels().sumSquares(x, n) / n) / 32768.0);
+}
+
+float zeroCrossingRate(const int16_t *x, int n)
+{
+    if (n <= 1) return 0.0f;
+    return static_cast<float>(kernels().zeroCrossings(x, n)) / (n - 1);
+}
+
+} // namespace Dsp
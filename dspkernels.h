@@ -0,0 +1,59 @@
+#ifndef DSPKERNELS_H
+#define DSPKERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Dsp — 音频热路径的向量化计算内核
+//
+// 每个内核都有标量实现，以及 SSE2 / AVX2（x86）或 NEON（ARM）实现，
+// 程序启动时按 CPU 能力选出最快的一组（kernels()），调用方无需关心指令集。
+// 所有内核结果与标量版本逐位一致（浮点累加顺序不同导致的舍入差异除外）。
+// 不依赖 Qt，可在任意线程调用。
+// ─────────────────────────────────────────────────────────────────────────────
+namespace Dsp {
+
+struct Kernels
+{
+    const char *name;
+
+    // Σx²（精确整数累加，返回 double 以免溢出）
+    double (*sumSquares)(const int16_t *x, int n);
+    // 过零次数：相邻样本符号（x >= 0 / x < 0）不同的次数
+    int    (*zeroCrossings)(const int16_t *x, int n);
+    // 峰值 max|x|（-32768 记为 32768）
+    int    (*peakAbs)(const int16_t *x, int n);
+    // int16 → float，归一化到 [-1, 1)
+    void   (*int16ToFloat)(const int16_t *x, float *out, int n);
+    // float → int16，乘 32768 后四舍五入并饱和
+    void   (*floatToInt16)(const float *x, int16_t *out, int n);
+    // 去直流：减去块均值，返回被减去的均值
+    float  (*removeDc)(float *x, int n);
+    // 点积 Σa·b（重采样 FIR 内积）
+    float  (*dot)(const float *a, const float *b, int n);
+    // 标准 base64 编码（带 '=' 填充），out 至少 base64Length(n) 字节，返回写入的字符数
+    size_t (*base64Encode)(const uint8_t *in, size_t n, char *out);
+};
+
+// 运行时选出的最优内核组
+const Kernels &kernels();
+
+// 标量参考实现（用于对照和基准测试）
+const Kernels &scalarKernels();
+
+// 当前 CPU 可用的全部内核组，按从慢到快排列（第一个为标量实现）
+std::vector<const Kernels*> availableKernels();
+
+// ─── 便捷函数 ────────────────────────────────────────────────────────────────
+// 归一化 RMS（0.0 ~ 1.0）
+float rms(const int16_t *x, int n);
+// 过零率（0.0 ~ 1.0）
+float zeroCrossingRate(const int16_t *x, int n);
+// n 字节编码后的 base64 长度
+inline size_t base64Length(size_t n) { return (n + 2) / 3 * 4; }
+
+} // namespace Dsp
+
+#endif // DSPKERNELS_H
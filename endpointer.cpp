@@ -0,0 +1,154 @@
+#include "endpointer.h"
+#include <algorithm>
+#include <cmath>
+
+void Endpointer::configure(int defaultFrames, int minFrames, int maxFrames, bool adaptive)
+{
+    m_defaultFrames = std::max(1, defaultFrames);
+    m_minFrames     = std::max(1, std::min(minFrames, m_defaultFrames));
+    m_maxFrames     = std::max(maxFrames, m_defaultFrames);
+    m_adaptive      = adaptive;
+}
+
+void Endpointer::reset()
+{
+    m_pauses.fill(0);
+    m_pauseNext       = 0;
+    m_pauseCount      = 0;
+    m_speakerRate     = 0.0f;
+    m_utterances      = 0;
+    m_suspectedSplits = 0;
+    m_lastEndSilence  = 0;
+    beginUtterance(-1);
+}
+
+void Endpointer::beginUtterance(int gapFrames)
+{
+    // 上一句刚因静音断开就又开口：多半是句中停顿被误当作句末
+    if (m_lastEndSilence > 0 && gapFrames >= 0 && gapFrames < SPLIT_GAP_FRAMES) {
+        recordPause(m_lastEndSilence + gapFrames);
+        ++m_suspectedSplits;
+    }
+    m_lastEndSilence = 0;
+
+    m_frames       = 0;
+    m_voicedFrames = 0;
+    m_segments     = 0;
+    m_silence      = 0;
+    m_energySum    = 0.0f;
+    m_recentEnergy = 0.0f;
+    m_preTimeout   = float(m_defaultFrames);
+    m_punctuation  = Punctuation::None;
+    m_decision     = Decision();
+    m_decision.timeoutFrames = m_defaultFrames;
+    m_decision.baseFrames    = m_defaultFrames;
+}
+
+bool Endpointer::update(bool voiced, float rms)
+{
+    ++m_frames;
+
+    if (voiced) {
+        if (m_silence >= MIN_PAUSE_FRAMES) {
+            recordPause(m_silence);
+        }
+        if (m_silence > 0 || m_voicedFrames == 0) {
+            ++m_segments;
+        }
+        m_silence = 0;
+        m_recentEnergy = (m_voicedFrames == 0)
+                             ? rms
+                             : ENERGY_SMOOTHING * m_recentEnergy + (1.0f - ENERGY_SMOOTHING) * rms;
+        m_energySum += rms;
+        ++m_voicedFrames;
+        return false;
+    }
+
+    if (m_silence++ == 0) {
+        decide();
+    }
+    if (!m_adaptive) {
+        return m_silence >= m_defaultFrames;
+    }
+
+    // 标点随中间结果随时可能到达，每帧重新套用
+    switch (m_punctuation) {
+    case Punctuation::Final: m_decision.punctuationFactor = 0.5f;  break;
+    case Punctuation::Pause: m_decision.punctuationFactor = 1.25f; break;
+    case Punctuation::None:  m_decision.punctuationFactor = 1.0f;  break;
+    }
+    const int timeout = int(std::lround(m_preTimeout * m_decision.punctuationFactor));
+    m_decision.timeoutFrames = std::clamp(timeout, m_minFrames, m_maxFrames);
+    return m_silence >= m_decision.timeoutFrames;
+}
+
+void Endpointer::endUtterance(bool accepted)
+{
+    if (!accepted) {
+        m_lastEndSilence = 0;
+        return;
+    }
+    ++m_utterances;
+    m_lastEndSilence = m_silence;
+
+    const int speechFrames = m_frames - m_silence;
+    if (speechFrames >= RATE_MIN_FRAMES) {
+        const float rate = float(m_segments) / float(speechFrames);
+        m_speakerRate = (m_speakerRate == 0.0f)
+                            ? rate
+                            : RATE_SMOOTHING * m_speakerRate + (1.0f - RATE_SMOOTHING) * rate;
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// decide() — 每段静音开始时调用一次
+// ─────────────────────────────────────────────────────────────────────────────
+void Endpointer::decide()
+{
+    Decision &d = m_decision;
+    d = Decision();
+
+    d.baseFrames = (m_pauseCount >= MIN_PAUSE_SAMPLES)
+                       ? int(std::lround(pausePercentile(PAUSE_QUANTILE) * PAUSE_MARGIN)) + PAUSE_SLACK_FRAMES
+                       : m_defaultFrames;
+
+    // 语速：本句语音段速率与该说话人平均速率之比
+    const int speechFrames = m_frames - m_silence;
+    if (speechFrames >= RATE_MIN_FRAMES && m_speakerRate > 0.0f && m_segments > 0) {
+        const float rate = float(m_segments) / float(speechFrames);
+        d.rateFactor = std::clamp(m_speakerRate / rate, 0.85f, 1.15f);
+    }
+
+    // 能量趋势：句尾平滑能量与整句语音平均能量之比
+    if (m_voicedFrames >= ENERGY_MIN_FRAMES && m_energySum > 0.0f) {
+        const float ratio = m_recentEnergy / (m_energySum / float(m_voicedFrames));
+        if (ratio < 0.6f) {
+            d.energyFactor = 0.8f;
+        } else if (ratio > 1.1f) {
+            d.energyFactor = 1.15f;
+        }
+    }
+
+    if (m_voicedFrames < SHORT_VOICED_FRAMES && m_segments <= 1) {
+        d.shortFactor = 0.75f;
+    }
+
+    m_preTimeout = float(d.baseFrames) * d.rateFactor * d.energyFactor * d.shortFactor;
+    d.timeoutFrames = std::clamp(int(std::lround(m_preTimeout)), m_minFrames, m_maxFrames);
+}
+
+void Endpointer::recordPause(int frames)
+{
+    m_pauses[m_pauseNext] = frames;
+    m_pauseNext  = (m_pauseNext + 1) % PAUSE_HISTORY;
+    m_pauseCount = std::min(m_pauseCount + 1, PAUSE_HISTORY);
+}
+
+int Endpointer::pausePercentile(float q) const
+{
+    std::array<int, PAUSE_HISTORY> sorted = m_pauses;
+    const auto end = sorted.begin() + m_pauseCount;
+    const auto nth = sorted.begin() + std::min(m_pauseCount - 1, int(q * float(m_pauseCount)));
+    std::nth_element(sorted.begin(), nth, end);
+    return *nth;
+}
@@ -0,0 +1,94 @@
+#ifndef ENDPOINTER_H
+#define ENDPOINTER_H
+
+#include <array>
+#include <cstdint>
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Endpointer — 自适应断句：按说话人与当前句子调整结束所需的静音时长
+//
+// 固定的 minSilenceDuration 对简短回答太长，对说话中途停顿的人又太短。
+// 每次进入静音时按以下依据重新计算超时，限制在 [minFrames, maxFrames]：
+//   · 停顿统计：句中停顿（静音后又恢复语音）长度的 90 分位 × 余量，
+//     样本不足时使用配置的 minSilenceDuration；
+//   · 语速：本句语音段速率快于该说话人平均时缩短，慢时延长；
+//   · 能量趋势：句尾能量明显回落（收尾）缩短，戛然而止（话没说完）延长；
+//   · 短句：只有一段的简短回答缩短；
+//   · 标点：流式识别中间结果以句末标点结尾时大幅缩短，以逗号结尾时延长。
+// 断句后很快又开始说话视为疑似误断，把这段停顿计入统计，超时随之变长。
+// 不依赖 Qt，只在采集线程中使用。
+// ─────────────────────────────────────────────────────────────────────────────
+class Endpointer
+{
+public:
+    enum class Punctuation { None, Pause, Final };   // 无标点 / 逗号类 / 句末
+
+    // 最近一次断句判定的依据（调参用）
+    struct Decision {
+        int   timeoutFrames     = 0;      // 生效的静音超时
+        int   baseFrames        = 0;      // 停顿统计（或默认值）给出的基准
+        float rateFactor        = 1.0f;
+        float energyFactor      = 1.0f;
+        float shortFactor       = 1.0f;
+        float punctuationFactor = 1.0f;
+    };
+
+    void configure(int defaultFrames, int minFrames, int maxFrames, bool adaptive);
+    void reset();                               // 清空说话人统计
+
+    void beginUtterance(int gapFrames);         // gapFrames：距上一句结束的帧数，<0 表示没有上一句
+    bool update(bool voiced, float rms);        // 录制中逐帧调用，返回 true 表示应当断句
+    void endUtterance(bool accepted);           // 误触发或强制结束时传 false，不计入统计
+    void setPunctuation(Punctuation punctuation) { m_punctuation = punctuation; }
+
+    const Decision &decision() const { return m_decision; }
+    int      silenceFrames()   const { return m_silence; }
+    int      pauseSamples()    const { return m_pauseCount; }
+    uint64_t utterances()      const { return m_utterances; }
+    uint64_t suspectedSplits() const { return m_suspectedSplits; }
+
+private:
+    void decide();                              // 进入静音时计算除标点外的各项系数
+    void recordPause(int frames);
+    int  pausePercentile(float q) const;
+
+    static constexpr int   PAUSE_HISTORY      = 64;     // 保留最近的停顿样本数
+    static constexpr int   MIN_PAUSE_FRAMES   = 3;      // 短于 120ms 的间隙不算停顿
+    static constexpr int   MIN_PAUSE_SAMPLES  = 8;      // 样本少于此数时使用默认超时
+    static constexpr float PAUSE_QUANTILE     = 0.9f;
+    static constexpr float PAUSE_MARGIN       = 1.3f;   // 超时 = 停顿 90 分位 × 1.3 + 2 帧
+    static constexpr int   PAUSE_SLACK_FRAMES = 2;
+    static constexpr int   SPLIT_GAP_FRAMES   = 8;      // 断句后 320ms 内又开口视为疑似误断
+    static constexpr int   RATE_MIN_FRAMES    = 25;     // 至少 1s 才估计语速
+    static constexpr float RATE_SMOOTHING     = 0.8f;
+    static constexpr int   ENERGY_MIN_FRAMES  = 8;
+    static constexpr float ENERGY_SMOOTHING   = 0.6f;   // 句尾能量的一阶平滑
+    static constexpr int   SHORT_VOICED_FRAMES = 20;    // 语音少于 800ms 且只有一段视为短句
+
+    int   m_defaultFrames = 20;
+    int   m_minFrames     = 6;
+    int   m_maxFrames     = 40;
+    bool  m_adaptive      = true;
+
+    // 说话人统计（跨句保留）
+    std::array<int, PAUSE_HISTORY> m_pauses {};
+    int      m_pauseNext       = 0;
+    int      m_pauseCount      = 0;
+    float    m_speakerRate     = 0.0f;          // 每帧语音段数的平滑值，0 表示尚无估计
+    uint64_t m_utterances      = 0;
+    uint64_t m_suspectedSplits = 0;
+    int      m_lastEndSilence  = 0;             // 上一句因静音结束时的静音帧数
+
+    // 当前句子
+    int   m_frames        = 0;
+    int   m_voicedFrames  = 0;
+    int   m_segments      = 0;                  // 语音段数（静音后恢复语音算一段）
+    int   m_silence       = 0;
+    float m_energySum     = 0.0f;
+    float m_recentEnergy  = 0.0f;
+    float m_preTimeout    = 0.0f;               // 未计标点的超时（帧）
+    Punctuation m_punctuation = Punctuation::None;
+    Decision    m_decision;
+};
+
+#endif // ENDPOINTER_H
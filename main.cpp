@@ -1,112 +1,201 @@
-#include "mainwindow.h"
-#include "ConfigManager.h"
-#include "AudioCapture.h"
-#include "speechrecogniser.h"
-#include "translator.h"
-#include "solooscbroadcaster.h"
-
-#include <QApplication>
-#include <QLocale>
-#include <QTranslator>
-
-int main(int argc, char *argv[])
-{
-    QApplication a(argc, argv);
-
-    // ─── 国际化翻译文件加载 ────────────────────────────────────────────────
-    QTranslator qTranslator;
-    const QStringList uiLanguages = QLocale::system().uiLanguages();
-    for (const QString &locale : uiLanguages) {
-        const QString baseName = "VRChatEasyTrans-AI_" + QLocale(locale).name();
-        if (qTranslator.load(":/i18n/" + baseName)) {
-            a.installTranslator(&qTranslator);
-            break;
-        }
-    }
-
-    // ─── 配置管理器初始化 ──────────────────────────────────────────────────
-    // 必须在 QApplication 创建之后调用（需要 applicationDirPath()）
-    ConfigManager::getInstance().loadFileToManager();
-
-    // ─── 主窗口 ────────────────────────────────────────────────────────────
-    MainWindow w;
-
-    // ─── 工作对象创建 ──────────────────────────────────────────────────────
-    // AudioCapture 留在主线程
-    AudioCapture audioCapture;
-
-    // SpeechRecogniser 独立线程：WebSocket 收发不阻塞主线程
-    QThread recogniserThread;
-    SpeechRecogniser recogniser;
-    recogniser.moveToThread(&recogniserThread);
-
-    // Translator 独立线程：HTTP 请求不阻塞主线程
-    QThread translatorThread;
-    Translator translator;
-    translator.moveToThread(&translatorThread);
-
-    // OSC基于UDP协议，不阻塞线程，可以放进Translator线程
-    // QThread oscThread;
-    SoloOscBroadcaster oscBroadcaster;
-    oscBroadcaster.moveToThread(&translatorThread);
-
-    // ─── 信号与槽连接 ──────────────────────────────────────────────────────
-
-    // 音频采集 → 语音识别（跨线程，自动 QueuedConnection）
-    QObject::connect(&audioCapture, &AudioCapture::startRecognition,
-                     &recogniser,   &SpeechRecogniser::onStartRecognition);
-    QObject::connect(&audioCapture, &AudioCapture::sendAudioChunk,
-                     &recogniser,   &SpeechRecogniser::onSendAudioChunk);
-    QObject::connect(&audioCapture, &AudioCapture::stopRecognition,
-                     &recogniser,   &SpeechRecogniser::onStopRecognition);
-
-    // 语音识别 → 翻译（跨线程）
-    QObject::connect(&recogniser,  &SpeechRecogniser::recognitionCompleted,
-                     &translator,  &Translator::translateTextAsync);
-
-    // 翻译 → OSC 广播（跨线程）
-    QObject::connect(&translator,    &Translator::translationFinished,
-                     &oscBroadcaster, &SoloOscBroadcaster::sendToOSC);
-
-    // 错误信息 → 主窗口显示
-    QObject::connect(&audioCapture, &AudioCapture::error,  &w, &MainWindow::onError);
-    QObject::connect(&recogniser,   &SpeechRecogniser::error, &w, &MainWindow::onError);
-    QObject::connect(&translator,   &Translator::translationError, &w, &MainWindow::onError);
-
-    // 调试信息 → 主窗口显示
-    QObject::connect(&audioCapture, &AudioCapture::debug,  &w, &MainWindow::onDebug);
-    QObject::connect(&recogniser,   &SpeechRecogniser::debug, &w, &MainWindow::onDebug);
-    QObject::connect(&translator,   &Translator::debug,    &w, &MainWindow::onDebug);
-
-    // 主窗口启动按钮 → 各模块初始化
-    QObject::connect(&w, &MainWindow::__start__, &audioCapture,   &AudioCapture::initialize);
-    QObject::connect(&w, &MainWindow::__start__, &recogniser,     &SpeechRecogniser::initialize);
-    QObject::connect(&w, &MainWindow::__start__, &translator,     &Translator::initialize);
-    QObject::connect(&w, &MainWindow::__start__, &oscBroadcaster, &SoloOscBroadcaster::initialize);
-
-    // 主窗口停止按钮 → 音频采集停止
-    QObject::connect(&w, &MainWindow::__stop__, &audioCapture, &AudioCapture::stop);
-
-    // ─── 启动子线程 ────────────────────────────────────────────────────────
-    // 线程只负责提供事件循环，工作对象的初始化由 __start__ 信号触发
-    recogniserThread.start();
-    translatorThread.start();
-    // oscThread.start();
-
-    // ─── 显示主窗口 ────────────────────────────────────────────────────────
-    w.show();
-
-    // ─── 程序退出清理 ──────────────────────────────────────────────────────
-    QObject::connect(&a, &QCoreApplication::aboutToQuit, [&]() {
-        // 通知各线程退出事件循环
-        recogniserThread.quit();
-        translatorThread.quit();
-        // oscThread.quit();
-        // 等待线程完全退出（避免析构时仍有后台操作）
-        recogniserThread.wait();
-        translatorThread.wait();
-        // oscThread.wait();
-    });
-
-    return a.exec();
-}
+#include "mainwindow.h"
+#include "ConfigManager.h"
+#include "AudioCapture.h"
+#include "speechrecogniser.h"
+#include "translator.h"
+#include "solooscbroadcaster.h"
+#include "chatboxscheduler.h"
+#include "oscreceiver.h"
+#include "pushtotalkkey.h"
+
+#include <QApplication>
+#include <QLocale>
+#include <QTranslator>
+#include <QThread>
+
+int main(int argc, char *argv[])
+{
+    QApplication a(argc, argv);
+
+    // ─── 国际化翻译文件加载 ────────────────────────────────────────────────
+    QTranslator qTranslator;
+    const QStringList uiLanguages = QLocale::system().uiLanguages();
+    for (const QString &locale : uiLanguages) {
+        const QString baseName = "VRChatEasyTrans-AI_" + QLocale(locale).name();
+        if (qTranslator.load(":/i18n/" + baseName)) {
+            a.installTranslator(&qTranslator);
+            break;
+        }
+    }
+
+    // ─── 配置管理器初始化 ──────────────────────────────────────────────────
+    // 必须在 QApplication 创建之后调用（需要 applicationDirPath()）
+    ConfigManager::getInstance().loadFileToManager();
+
+    // ─── 主窗口 ────────────────────────────────────────────────────────────
+    MainWindow w;
+
+    // ─── 工作对象创建 ──────────────────────────────────────────────────────
+    // 音频帧池：采集线程取帧，识别线程发送后归还。
+    // 先于交接队列和各工作对象构造、最后析构，保证所有帧句柄都在它之前释放
+    AudioFramePool framePool;
+
+    // 采集线程 → 识别线程的有界交接队列（开始/音频/结束事件按顺序传递）
+    AudioHandoffQueue audioHandoff;
+
+    // AudioCapture 独立采集线程：界面重绘、拖动窗口、日志滚动都不会拖慢 VAD，
+    // 也不会让硬件缓冲区溢出。可选提高线程优先级（highPriorityCapture）
+    QThread captureThread;
+    AudioCapture audioCapture;
+    audioCapture.setHandoffQueue(&audioHandoff);
+    audioCapture.setFramePool(&framePool);
+    audioCapture.moveToThread(&captureThread);
+
+    // SpeechRecogniser 独立线程：WebSocket 收发不阻塞主线程
+    QThread recogniserThread;
+    SpeechRecogniser recogniser;
+    recogniser.setHandoffQueue(&audioHandoff);
+    recogniser.moveToThread(&recogniserThread);
+
+    // Translator 独立线程：HTTP 请求不阻塞主线程
+    QThread translatorThread;
+    Translator translator;
+    translator.moveToThread(&translatorThread);
+
+    // OSC基于UDP协议，不阻塞线程，可以放进Translator线程
+    // QThread oscThread;
+    SoloOscBroadcaster oscBroadcaster;
+    oscBroadcaster.moveToThread(&translatorThread);
+    ChatboxScheduler chatboxScheduler(&oscBroadcaster);
+    chatboxScheduler.moveToThread(&translatorThread);
+    OscReceiver oscReceiver;
+    oscReceiver.moveToThread(&translatorThread);
+
+    // 全局热键钩子的回调在安装线程的消息循环中执行，留在主线程
+    PushToTalkKey pushToTalkKey;
+
+    // ─── 信号与槽连接 ──────────────────────────────────────────────────────
+
+    // 音频采集 → 语音识别（跨线程，自动 QueuedConnection）
+    QObject::connect(&audioCapture, &AudioCapture::speechOnset,
+                     &recogniser,   &SpeechRecogniser::onSpeechOnset);
+    QObject::connect(&audioCapture, &AudioCapture::speechOnset,
+                     &translator,   &Translator::onSpeechOnset);
+    QObject::connect(&audioCapture, &AudioCapture::audioAvailable,
+                     &recogniser,   &SpeechRecogniser::onAudioAvailable);
+
+    // 语音识别 → 翻译（跨线程）
+    QObject::connect(&recogniser,  &SpeechRecogniser::recognitionCompleted,
+                     &translator,  &Translator::translateTextAsync);
+    // 中间结果的稳定前缀 → 推测翻译（未开启 speculativeTranslation 时直接忽略）
+    QObject::connect(&recogniser,  &SpeechRecogniser::recognitionPartial,
+                     &translator,  &Translator::onPartialText);
+
+    // 中间结果 → 主窗口实时显示 / 聊天框实时字幕（跨线程）
+    QObject::connect(&recogniser,     &SpeechRecogniser::recognitionPartial,
+                     &w,              &MainWindow::onRecognitionPartial);
+    QObject::connect(&recogniser,     &SpeechRecogniser::sessionFinished,
+                     &w,              &MainWindow::onRecognitionSessionFinished);
+    QObject::connect(&recogniser,       &SpeechRecogniser::recognitionPartial,
+                     &chatboxScheduler, &ChatboxScheduler::submitPartial);
+    // 中间结果的末尾标点 → 自适应断句提示（跨线程）
+    QObject::connect(&recogniser,   &SpeechRecogniser::recognitionPartial,
+                     &audioCapture, &AudioCapture::onRecognitionPartial);
+    QObject::connect(&recogniser,   &SpeechRecogniser::sessionStarted,
+                     &audioCapture, &AudioCapture::onRecognitionSessionStarted);
+
+    // 翻译 → 聊天框调度（分页、限速）→ OSC 广播
+    QObject::connect(&translator,       &Translator::translationFinished,
+                     &chatboxScheduler, &ChatboxScheduler::submitFinal);
+    QObject::connect(&translator,       &Translator::translationProgress,
+                     &chatboxScheduler, &ChatboxScheduler::submitProgress);
+    QObject::connect(&chatboxScheduler, &ChatboxScheduler::queueChanged,
+                     &w,                &MainWindow::onChatboxQueueChanged);
+
+    // 采集统计 → 主窗口显示
+    QObject::connect(&audioCapture, &AudioCapture::captureStats,
+                     &w,            &MainWindow::onCaptureStats);
+    QObject::connect(&audioCapture, &AudioCapture::framePoolStats,
+                     &w,            &MainWindow::onFramePoolStats);
+
+    // 噪声底 / 阈值 → 主窗口显示，校准按钮 → 音频采集
+    QObject::connect(&audioCapture, &AudioCapture::noiseFloorChanged,
+                     &w,            &MainWindow::onNoiseFloorChanged);
+    QObject::connect(&audioCapture, &AudioCapture::thresholdCalibrated,
+                     &w,            &MainWindow::onThresholdCalibrated);
+    QObject::connect(&w, &MainWindow::calibrateRequested, &audioCapture, &AudioCapture::calibrate);
+
+    // VRChat 游戏内静音 → 暂停音频处理（跨线程）
+    QObject::connect(&oscReceiver,  &OscReceiver::muteChanged,
+                     &audioCapture, &AudioCapture::setMuted);
+
+    // 按键说话：全局热键 / VRChat OSC 按钮参数 → 音频采集（跨线程）
+    QObject::connect(&pushToTalkKey, &PushToTalkKey::stateChanged,
+                     &audioCapture,  &AudioCapture::setPushToTalk);
+    QObject::connect(&oscReceiver,   &OscReceiver::pushToTalkChanged,
+                     &audioCapture,  &AudioCapture::setPushToTalk);
+
+    // 识别队列深度 → 主窗口显示
+    QObject::connect(&recogniser, &SpeechRecogniser::queueDepthChanged,
+                     &w,          &MainWindow::onRecognitionQueueChanged);
+
+    // 错误信息 → 主窗口显示
+    QObject::connect(&audioCapture, &AudioCapture::error,  &w, &MainWindow::onError);
+    QObject::connect(&recogniser,   &SpeechRecogniser::error, &w, &MainWindow::onError);
+    QObject::connect(&translator,   &Translator::translationError, &w, &MainWindow::onError);
+    QObject::connect(&oscReceiver,  &OscReceiver::error,   &w, &MainWindow::onError);
+    QObject::connect(&oscBroadcaster, &SoloOscBroadcaster::error, &w, &MainWindow::onError);
+    QObject::connect(&pushToTalkKey, &PushToTalkKey::error, &w, &MainWindow::onError);
+
+    // 调试信息 → 主窗口显示
+    QObject::connect(&audioCapture, &AudioCapture::debug,  &w, &MainWindow::onDebug);
+    QObject::connect(&recogniser,   &SpeechRecogniser::debug, &w, &MainWindow::onDebug);
+    QObject::connect(&translator,   &Translator::debug,    &w, &MainWindow::onDebug);
+    QObject::connect(&oscReceiver,  &OscReceiver::debug,   &w, &MainWindow::onDebug);
+    QObject::connect(&oscBroadcaster, &SoloOscBroadcaster::debug, &w, &MainWindow::onDebug);
+    QObject::connect(&pushToTalkKey, &PushToTalkKey::debug, &w, &MainWindow::onDebug);
+
+    // 主窗口启动按钮 → 各模块初始化
+    QObject::connect(&w, &MainWindow::__start__, &audioCapture,   &AudioCapture::initialize);
+    QObject::connect(&w, &MainWindow::__start__, &recogniser,     &SpeechRecogniser::initialize);
+    QObject::connect(&w, &MainWindow::__start__, &translator,     &Translator::initialize);
+    QObject::connect(&w, &MainWindow::__start__, &oscBroadcaster, &SoloOscBroadcaster::initialize);
+    QObject::connect(&w, &MainWindow::__start__, &chatboxScheduler, &ChatboxScheduler::initialize);
+    QObject::connect(&w, &MainWindow::__start__, &oscReceiver,    &OscReceiver::initialize);
+    QObject::connect(&w, &MainWindow::__start__, &pushToTalkKey,  &PushToTalkKey::initialize);
+
+    // 主窗口停止按钮 → 音频采集停止
+    QObject::connect(&w, &MainWindow::__stop__, &audioCapture, &AudioCapture::stop);
+
+    // ─── 启动子线程 ────────────────────────────────────────────────────────
+    // 线程只负责提供事件循环，工作对象的初始化由 __start__ 信号触发
+    captureThread.start(ConfigManager::getInstance().getHighPriorityCapture()
+                            ? QThread::TimeCriticalPriority
+                            : QThread::InheritPriority);
+    recogniserThread.start();
+    translatorThread.start();
+    // oscThread.start();
+
+    // ─── 显示主窗口 ────────────────────────────────────────────────────────
+    w.show();
+
+    // ─── 程序退出清理 ──────────────────────────────────────────────────────
+    QObject::connect(&a, &QCoreApplication::aboutToQuit, [&]() {
+        // 音频设备必须在所属的采集线程中关闭
+        QMetaObject::invokeMethod(&audioCapture, &AudioCapture::stop,
+                                  Qt::BlockingQueuedConnection);
+
+        // 通知各线程退出事件循环
+        captureThread.quit();
+        recogniserThread.quit();
+        translatorThread.quit();
+        // oscThread.quit();
+        // 等待线程完全退出（避免析构时仍有后台操作）
+        captureThread.wait();
+        recogniserThread.wait();
+        translatorThread.wait();
+        // oscThread.wait();
+    });
+
+    return a.exec();
+}
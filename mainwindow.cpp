@@ -1,104 +1,179 @@
-#include "mainwindow.h"
-#include "./ui_mainwindow.h"
-#include <QMediaDevices>
-#include <QDebug>
-#include <QTimer>
-#include <QDateTime>
-#include <QDir>
-
-#include <QUdpSocket>
-
-#define MAX_LANGUAGE_COUNT 7
-QString language[] = {"英语", "日语", "韩语", "俄语", "法语", "德语", "西班牙语" };
-
-MainWindow::MainWindow(QWidget *parent)
-    : QMainWindow(parent)
-    , ui(new Ui::MainWindow)
-    , is_running(false)
-    //, audioTimer(new QTimer(this))
-{
-    ui->setupUi(this);
-
-    config.loadFileToManager();             // 从配置文件读取配置到管理类
-    applyConfigToUi();                      // 将配置从管理类应用到UI
-}
-
-MainWindow::~MainWindow(){}
-
-void MainWindow::on_launchButton_clicked()
-{
-    if(is_running){
-        ui->debug->append("\n结束\n");
-
-        is_running = false;
-        ui->launchButton->setText("启动!");
-        emit __stop__();
-    }
-    else{
-        if(ui->ApiKeyInput->text().isEmpty() ||
-            ui->AppIdInput->text().isEmpty() ||
-            ui->SecretKeyInput->text().isEmpty() ||
-            ui->DeepseekApiKeyInput->text().isEmpty()
-            ){
-            ui->debug->append("未配置 API 信息，请访问GitHub页面或查看使用说明");
-            return ;
-        }
-
-        applyUiToConfig();                  // 将UI修改应用到管理类
-        config.loadManagerToFile();         // 将管理类里面的配置写入配置文件（注意！要先更新配置再启动）
-        is_running = true;
-
-        ui->launchButton->setText("停止");
-        ui->debug->clear();
-        ui->debug->append("程序启动\n正在使用设备"+config.getDevice());
-
-        emit __start__();                   // 启动  （注意！要先更新配置再启动）
-    }
-}
-
-// 从ConfigManager初始化UI
-void MainWindow::applyConfigToUi(){
-    int tmpId = 0;
-    QList<QAudioDevice> devicelist = QMediaDevices::audioInputs();
-    for (int i=0;i<devicelist.size();i++) {
-        ui->deviceCombo->addItem(devicelist[i].description());
-        if(devicelist[i].isDefault())
-            tmpId = i;
-    }
-    ui->deviceCombo->setCurrentIndex(tmpId);
-    ui->ApiKeyInput->setText(config.getXunFeiApiKey());
-    ui->SecretKeyInput->setText(config.getXunFeiApiSecret());
-    ui->AppIdInput->setText(config.getXunFeiAppId());
-    ui->DeepseekApiKeyInput->setText(config.getDeepseekApiKey());
-    ui->oscHostInput->setText(config.getTargetHost());
-    ui->oscPortInput->setText(QString::number(config.getTargetPort()));
-    ui->silentTimeInput->setText(QString::number(config.getMinSilenceDuration()));
-    ui->vadInput->setText(QString::number(config.getVadThreshold()*100));
-    for(int i=0;i<MAX_LANGUAGE_COUNT;i++)
-        if(config.getTargetLanguage()[0] == language[i][0])
-            tmpId = i;
-    ui->languageCombo->setCurrentIndex(tmpId);
-}
-
-// 将UI应用到ConfigManager
-void MainWindow::applyUiToConfig(){
-    config.setDevice(ui->deviceCombo->currentText());
-    config.setXunFeiApiKey(ui->ApiKeyInput->text());
-    config.setXunFeiApiSecret(ui->SecretKeyInput->text());
-    config.setXunFeiAppId(ui->AppIdInput->text());
-    config.setDeepseekApiKey(ui->DeepseekApiKeyInput->text());
-    config.setTargetHost(ui->oscHostInput->text());
-    config.setTargetPort(ui->oscPortInput->text().toInt());
-    config.setMinSilenceDuration(ui->silentTimeInput->text().toInt());
-    config.setVadThreshold(ui->vadInput->text().toFloat()/100);
-    config.setTargetLanguage(ui->languageCombo->currentText());
-}
-
-void MainWindow::onError(const QString& errorMessage){
-    qDebug() << errorMessage;
-    ui->debug->append("[ERROR]" + errorMessage);
-}
-
-void MainWindow::onDebug(const QString& debugMessage){
-    ui->debug->append(debugMessage);
-}
+#include "mainwindow.h"
+#include "./ui_mainwindow.h"
+#include <QMediaDevices>
+#include <QDebug>
+#include <QTimer>
+#include <QDateTime>
+#include <QDir>
+#include <QFontMetrics>
+
+#include <QUdpSocket>
+
+#define MAX_LANGUAGE_COUNT 7
+QString language[] = {"英语", "日语", "韩语", "俄语", "法语", "德语", "西班牙语" };
+
+MainWindow::MainWindow(QWidget *parent)
+    : QMainWindow(parent)
+    , ui(new Ui::MainWindow)
+    , is_running(false)
+    //, audioTimer(new QTimer(this))
+{
+    ui->setupUi(this);
+
+    config.loadFileToManager();             // 从配置文件读取配置到管理类
+    applyConfigToUi();                      // 将配置从管理类应用到UI
+}
+
+MainWindow::~MainWindow(){}
+
+void MainWindow::on_launchButton_clicked()
+{
+    if(is_running){
+        ui->debug->append("\n结束\n");
+
+        is_running = false;
+        ui->launchButton->setText("启动!");
+        m_partialSessionId = 0;
+        ui->partialLabel->clear();
+        emit __stop__();
+    }
+    else{
+        if(ui->ApiKeyInput->text().isEmpty() ||
+            ui->AppIdInput->text().isEmpty() ||
+            ui->SecretKeyInput->text().isEmpty() ||
+            ui->DeepseekApiKeyInput->text().isEmpty()
+            ){
+            ui->debug->append("未配置 API 信息，请访问GitHub页面或查看使用说明");
+            return ;
+        }
+
+        applyUiToConfig();                  // 将UI修改应用到管理类
+        config.loadManagerToFile();         // 将管理类里面的配置写入配置文件（注意！要先更新配置再启动）
+        is_running = true;
+
+        ui->launchButton->setText("停止");
+        ui->debug->clear();
+        ui->debug->append("程序启动\n正在使用设备"+config.getDevice());
+
+        emit __start__();                   // 启动  （注意！要先更新配置再启动）
+    }
+}
+
+void MainWindow::on_calibrateButton_clicked()
+{
+    if(!is_running){
+        ui->debug->append("请先启动再校准");
+        return;
+    }
+    emit calibrateRequested();
+}
+
+// 从ConfigManager初始化UI
+void MainWindow::applyConfigToUi(){
+    int tmpId = 0;
+    QList<QAudioDevice> devicelist = QMediaDevices::audioInputs();
+    for (int i=0;i<devicelist.size();i++) {
+        ui->deviceCombo->addItem(devicelist[i].description());
+        if(devicelist[i].isDefault())
+            tmpId = i;
+    }
+    ui->deviceCombo->setCurrentIndex(tmpId);
+    ui->ApiKeyInput->setText(config.getXunFeiApiKey());
+    ui->SecretKeyInput->setText(config.getXunFeiApiSecret());
+    ui->AppIdInput->setText(config.getXunFeiAppId());
+    ui->DeepseekApiKeyInput->setText(config.getDeepseekApiKey());
+    ui->oscHostInput->setText(config.getTargetHost());
+    ui->oscPortInput->setText(QString::number(config.getTargetPort()));
+    ui->silentTimeInput->setText(QString::number(config.getMinSilenceDuration()));
+    ui->vadInput->setText(QString::number(config.getVadThreshold()*100));
+    ui->autoVadCheck->setChecked(config.getAutoVadThreshold());
+    ui->partialOscCheck->setChecked(config.getPartialToChatbox());
+    for(int i=0;i<MAX_LANGUAGE_COUNT;i++)
+        if(config.getTargetLanguage()[0] == language[i][0])
+            tmpId = i;
+    ui->languageCombo->setCurrentIndex(tmpId);
+}
+
+// 将UI应用到ConfigManager
+void MainWindow::applyUiToConfig(){
+    config.setDevice(ui->deviceCombo->currentText());
+    config.setXunFeiApiKey(ui->ApiKeyInput->text());
+    config.setXunFeiApiSecret(ui->SecretKeyInput->text());
+    config.setXunFeiAppId(ui->AppIdInput->text());
+    config.setDeepseekApiKey(ui->DeepseekApiKeyInput->text());
+    config.setTargetHost(ui->oscHostInput->text());
+    config.setTargetPort(ui->oscPortInput->text().toInt());
+    config.setMinSilenceDuration(ui->silentTimeInput->text().toInt());
+    config.setVadThreshold(ui->vadInput->text().toFloat()/100);
+    config.setAutoVadThreshold(ui->autoVadCheck->isChecked());
+    config.setPartialToChatbox(ui->partialOscCheck->isChecked());
+    config.setTargetLanguage(ui->languageCombo->currentText());
+}
+
+void MainWindow::onError(const QString& errorMessage){
+    qDebug() << errorMessage;
+    ui->debug->append("[ERROR]" + errorMessage);
+}
+
+void MainWindow::onDebug(const QString& debugMessage){
+    ui->debug->append(debugMessage);
+}
+
+void MainWindow::onCaptureStats(quint64 frames, quint64 ringDropped, quint64 handoffDropped,
+                                quint64 lateReads, int maxReadGapMs, quint64 wakeups){
+    // 丢弃/超时计数始终为 0 即说明采集未受界面操作影响
+    ui->captureStatsLabel->setText(QString("采集: %1帧  丢弃: %2B/%3帧  超时读取: %4  最大间隔: %5ms  唤醒: %6")
+                                       .arg(frames).arg(ringDropped).arg(handoffDropped)
+                                       .arg(lateReads).arg(maxReadGapMs).arg(wakeups));
+}
+
+void MainWindow::onFramePoolStats(int inUse, int peakInUse, int capacity, quint64 exhausted){
+    // 耗尽计数为 0 即说明帧池足够，稳态下每帧音频没有堆分配
+    ui->framePoolLabel->setText(QString("帧池: %1/%2  峰值: %3  耗尽: %4")
+                                    .arg(inUse).arg(capacity).arg(peakInUse).arg(exhausted));
+}
+
+void MainWindow::onRecognitionPartial(quint64 sessionId, const QString &text, int stableLength){
+    // 只显示末尾部分；尚可能被动态修正替换的末尾以灰色显示
+    m_partialSessionId = sessionId;
+    const QFontMetrics metrics(ui->partialLabel->font());
+    const QString shown = metrics.elidedText(QString("#%1 %2").arg(sessionId).arg(text),
+                                             Qt::ElideLeft, ui->partialLabel->width());
+    const qsizetype tentative = qMin<qsizetype>(text.size() - stableLength, shown.size());
+    ui->partialLabel->setTextFormat(Qt::RichText);
+    ui->partialLabel->setText(shown.left(shown.size() - tentative).toHtmlEscaped()
+                              + "<span style=\"color: gray;\">"
+                              + shown.right(tentative).toHtmlEscaped() + "</span>");
+}
+
+// 显示中的会话已完成或被取消：清掉它的中间结果，不让过期的灰色尾巴一直留着
+void MainWindow::onRecognitionSessionFinished(quint64 sessionId){
+    if (sessionId == m_partialSessionId) {
+        m_partialSessionId = 0;
+        ui->partialLabel->clear();
+    }
+}
+
+void MainWindow::onRecognitionQueueChanged(int inFlight, int pending){
+    ui->recognitionQueueLabel->setText(QString("识别中: %1  待输出: %2").arg(inFlight).arg(pending));
+}
+
+void MainWindow::onChatboxQueueChanged(int pendingPages, bool live, quint64 merged, quint64 dropped){
+    ui->chatboxQueueLabel->setText(QString("聊天框: 待发 %1页%2  合并: %3  丢弃: %4页")
+                                       .arg(pendingPages).arg(live ? "+字幕" : "")
+                                       .arg(merged).arg(dropped));
+}
+
+void MainWindow::onNoiseFloorChanged(double floor, double threshold){
+    // 与静音阈值输入框一致，以百分比显示
+    ui->noiseFloorLabel->setText(QString("噪声底: %1%  阈值: %2%")
+                                     .arg(floor * 100, 0, 'f', 2)
+                                     .arg(threshold * 100, 0, 'f', 2));
+}
+
+void MainWindow::onThresholdCalibrated(double threshold){
+    // 写回输入框和配置，下次启动沿用校准结果
+    ui->vadInput->setText(QString::number(threshold * 100, 'f', 2));
+    config.setVadThreshold(threshold);
+    config.loadManagerToFile();
+}
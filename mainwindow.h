@@ -1,44 +1,56 @@
-#ifndef MAINWINDOW_H
-#define MAINWINDOW_H
-
-#include <QMainWindow>
-#include <QThreadPool>
-#include <QAtomicInt>
-#include "ConfigManager.h"
-
-QT_BEGIN_NAMESPACE
-namespace Ui {
-class MainWindow;
-}
-QT_END_NAMESPACE
-
-class MainWindow : public QMainWindow
-{
-    Q_OBJECT
-
-private:
-    Ui::MainWindow *ui;
-
-    ConfigManager &config = ConfigManager::getInstance();
-
-    bool is_running;
-
-    void applyConfigToUi();
-    void applyUiToConfig();
-
-private slots:
-    void on_launchButton_clicked();
-
-public:
-    MainWindow(QWidget *parent = nullptr);
-    ~MainWindow();
-public slots:
-    void onError(const QString& errorMessage);
-    void onDebug(const QString& debugMessage);
-
-signals:
-    void __start__();
-    void __stop__();
-};
-
-#endif // MAINWINDOW_H
+#ifndef MAINWINDOW_H
+#define MAINWINDOW_H
+
+#include <QMainWindow>
+#include <QThreadPool>
+#include <QAtomicInt>
+#include "ConfigManager.h"
+
+QT_BEGIN_NAMESPACE
+namespace Ui {
+class MainWindow;
+}
+QT_END_NAMESPACE
+
+class MainWindow : public QMainWindow
+{
+    Q_OBJECT
+
+private:
+    Ui::MainWindow *ui;
+
+    ConfigManager &config = ConfigManager::getInstance();
+
+    bool is_running;
+    quint64 m_partialSessionId = 0;     // partialLabel 当前显示的会话
+
+    void applyConfigToUi();
+    void applyUiToConfig();
+
+private slots:
+    void on_launchButton_clicked();
+    void on_calibrateButton_clicked();
+
+public:
+    MainWindow(QWidget *parent = nullptr);
+    ~MainWindow();
+public slots:
+    void onError(const QString& errorMessage);
+    void onDebug(const QString& debugMessage);
+    void onRecognitionQueueChanged(int inFlight, int pending);
+    void onChatboxQueueChanged(int pendingPages, bool live, quint64 merged, quint64 dropped);
+    void onRecognitionPartial(quint64 sessionId, const QString &text, int stableLength);
+    void onRecognitionSessionFinished(quint64 sessionId);
+    void onFramePoolStats(int inUse, int peakInUse, int capacity, quint64 exhausted);
+    void onCaptureStats(quint64 frames, quint64 ringDropped, quint64 handoffDropped,
+                        quint64 lateReads, int maxReadGapMs, quint64 wakeups);
+    void onNoiseFloorChanged(double floor, double threshold);
+    void onThresholdCalibrated(double threshold);
+
+signals:
+    void __start__();
+    void __stop__();
+    void calibrateRequested();
+};
+
+#endif // MAINWINDOW_H
@@ -0,0 +1,46 @@
+#include "noisefloorestimator.h"
+#include <algorithm>
+
+NoiseFloorEstimator::NoiseFloorEstimator(int subWindows)
+    : m_subMinima(std::max(1, subWindows), 0.0f)
+{
+}
+
+void NoiseFloorEstimator::reset()
+{
+    std::fill(m_subMinima.begin(), m_subMinima.end(), 0.0f);
+    m_next     = 0;
+    m_filled   = 0;
+    m_subCount = 0;
+    m_subMin   = 0.0f;
+    m_smoothed = 0.0f;
+    m_primed   = false;
+    m_floor    = 0.0f;
+}
+
+void NoiseFloorEstimator::update(float rms)
+{
+    if (!m_primed) {
+        m_smoothed = rms;
+        m_subMin   = rms;
+        m_primed   = true;
+    } else {
+        m_smoothed = SMOOTHING * m_smoothed + (1.0f - SMOOTHING) * rms;
+    }
+
+    m_subMin = (m_subCount == 0) ? m_smoothed : std::min(m_subMin, m_smoothed);
+
+    if (++m_subCount >= SUB_WINDOW_FRAMES) {
+        m_subMinima[m_next] = m_subMin;
+        m_next   = (m_next + 1) % static_cast<int>(m_subMinima.size());
+        m_filled = std::min(m_filled + 1, static_cast<int>(m_subMinima.size()));
+        m_subCount = 0;
+    }
+
+    // 已完成的子窗口最小值与当前子窗口的最小值一起取最小
+    float minimum = m_subMin;
+    for (int i = 0; i < m_filled; ++i) {
+        minimum = std::min(minimum, m_subMinima[i]);
+    }
+    m_floor = minimum * MIN_BIAS;
+}
@@ -0,0 +1,41 @@
+#ifndef NOISEFLOORESTIMATOR_H
+#define NOISEFLOORESTIMATOR_H
+
+#include <vector>
+
+// ─────────────────────────────────────────────────────────────────────────────
+// NoiseFloorEstimator — 最小值统计法估计背景噪声电平
+//
+// 输入为逐帧的归一化 RMS。先做一阶平滑，再在 SUB_WINDOW_FRAMES 帧的子窗口内
+// 取最小值，保留最近 m_subWindows 个子窗口的最小值，整体最小值乘以偏置系数
+// 即为噪声底。说话时总有停顿，窗口（默认约 6s）内的最小值落在停顿处，
+// 因此不需要知道哪些帧是语音；环境变吵时最多一个窗口后跟上，变安静时立即下降。
+// 不依赖 Qt，只在采集线程中使用。
+// ─────────────────────────────────────────────────────────────────────────────
+class NoiseFloorEstimator
+{
+public:
+    explicit NoiseFloorEstimator(int subWindows = 6);
+
+    void  reset();
+    void  update(float rms);
+
+    float floor() const { return m_floor; }
+    bool  isReady() const { return m_filled > 0; }   // 至少完成一个子窗口
+
+private:
+    static constexpr int   SUB_WINDOW_FRAMES = 25;     // 子窗口长度（1s）
+    static constexpr float SMOOTHING         = 0.8f;   // 一阶平滑系数
+    static constexpr float MIN_BIAS          = 1.25f;  // 平滑后取最小值会低估均值，乘以偏置补偿
+
+    std::vector<float> m_subMinima;   // 最近若干子窗口的最小值（环形）
+    int   m_next      = 0;
+    int   m_filled    = 0;
+    int   m_subCount  = 0;            // 当前子窗口已累计帧数
+    float m_subMin    = 0.0f;
+    float m_smoothed  = 0.0f;
+    bool  m_primed    = false;
+    float m_floor     = 0.0f;
+};
+
+#endif // NOISEFLOORESTIMATOR_H
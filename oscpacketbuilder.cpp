@@ -0,0 +1,101 @@
+#include "oscpacketbuilder.h"
+#include <QtEndian>
+#include <cstring>
+
+OscPacketBuilder::OscPacketBuilder(int reserveBytes)
+{
+    m_buffer.reserve(reserveBytes);
+}
+
+QByteArray OscPacketBuilder::messagePrefix(const char *address, const char *typeTags)
+{
+    QByteArray prefix;
+    for (const char *part : { address, typeTags }) {
+        prefix.append(part);
+        prefix.append(4 - prefix.size() % 4, '\0');    // 结束符 + 补齐
+    }
+    return prefix;
+}
+
+// 只清空内容，保留容量
+void OscPacketBuilder::clear()
+{
+    m_buffer.resize(0);
+    m_inBundle     = false;
+    m_elementStart = -1;
+}
+
+void OscPacketBuilder::beginBundle(quint64 timeTag)
+{
+    std::memcpy(grow(8), "#bundle", 8);
+    qToBigEndian<quint64>(timeTag, grow(8));
+    m_inBundle = true;
+}
+
+void OscPacketBuilder::beginMessage(const QByteArray &prefix)
+{
+    if (m_inBundle) {
+        m_elementStart = m_buffer.size();
+        grow(4);                                       // 元素长度，endMessage() 回填
+    } else {
+        m_buffer.resize(0);
+    }
+    std::memcpy(grow(prefix.size()), prefix.constData(), size_t(prefix.size()));
+}
+
+void OscPacketBuilder::endMessage()
+{
+    if (!m_inBundle || m_elementStart < 0)
+        return;
+    const qint32 elementBytes = qint32(m_buffer.size() - m_elementStart - 4);
+    qToBigEndian<qint32>(elementBytes, m_buffer.data() + m_elementStart);
+    m_elementStart = -1;
+}
+
+void OscPacketBuilder::addInt(qint32 value)
+{
+    qToBigEndian<qint32>(value, grow(4));
+}
+
+void OscPacketBuilder::addFloat(float value)
+{
+    quint32 bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    qToBigEndian<quint32>(bits, grow(4));
+}
+
+void OscPacketBuilder::addString(QStringView text)
+{
+    // 先按最坏情况（每个 UTF-16 单元 3 字节）扩展，编码后再截到实际长度
+    const qsizetype start = m_buffer.size();
+    char *out = grow(m_utf8.requiredSpace(text.size()));
+    char *end = m_utf8.appendToBuffer(out, text);
+    m_buffer.resize(start + (end - out));
+    padString();
+}
+
+void OscPacketBuilder::addBlob(const char *data, int size)
+{
+    addInt(size);
+    std::memcpy(grow(size), data, size_t(size));
+    padTo4();
+}
+
+char *OscPacketBuilder::grow(qsizetype bytes)
+{
+    const qsizetype at = m_buffer.size();
+    m_buffer.resize(at + bytes);
+    return m_buffer.data() + at;
+}
+
+void OscPacketBuilder::padString()
+{
+    const qsizetype pad = 4 - m_buffer.size() % 4;
+    std::memset(grow(pad), 0, size_t(pad));
+}
+
+void OscPacketBuilder::padTo4()
+{
+    const qsizetype pad = (4 - m_buffer.size() % 4) % 4;
+    std::memset(grow(pad), 0, size_t(pad));
+}
@@ -0,0 +1,59 @@
+#ifndef OSCPACKETBUILDER_H
+#define OSCPACKETBUILDER_H
+
+#include <QByteArray>
+#include <QString>
+#include <QStringView>
+#include <QStringEncoder>
+
+// ─────────────────────────────────────────────────────────────────────────────
+// OscPacketBuilder — OSC 1.0 报文编码器
+//
+// 原做法每条消息 new 一个 QByteArray，地址、类型标签、参数逐段 append，
+// 再用 while 循环一个字节一个字节补齐 4 字节对齐。
+// 这里地址 + 类型标签作为"前缀"预先编码好（messagePrefix），每条消息只需
+// 拷贝前缀、按大端写入参数；字符串直接 UTF-8 编码进复用缓冲区，稳态下没有堆分配。
+//
+// 支持 int32 / float32 / string / blob 参数（T/F/N/I 只占类型标签，无需写入），
+// 以及 OSC bundle：beginBundle() 之后的每条消息自动带上长度前缀。
+// 参数必须与前缀里的类型标签一致，编码器不做检查。
+// 返回的 data() 在下一次 clear()/beginMessage() 前有效。
+// ─────────────────────────────────────────────────────────────────────────────
+class OscPacketBuilder
+{
+public:
+    static constexpr quint64 TIME_TAG_IMMEDIATELY = 1;
+
+    explicit OscPacketBuilder(int reserveBytes = 1024);
+
+    // 预先编码 "地址\0 补齐 + 类型标签\0 补齐"，如 messagePrefix("/chatbox/input", ",sTT")
+    static QByteArray messagePrefix(const char *address, const char *typeTags);
+
+    void clear();
+
+    // bundle：clear() 后调用，之后的消息都成为 bundle 的元素
+    void beginBundle(quint64 timeTag = TIME_TAG_IMMEDIATELY);
+
+    // 单条消息；在 bundle 内时需配对调用 endMessage() 回填元素长度
+    void beginMessage(const QByteArray &prefix);
+    void endMessage();
+
+    void addInt(qint32 value);
+    void addFloat(float value);
+    void addString(QStringView text);
+    void addBlob(const char *data, int size);
+
+    const QByteArray &data() const { return m_buffer; }
+
+private:
+    char *grow(qsizetype bytes);            // 扩展 bytes 字节并返回写入位置
+    void  padString();                      // 字符串结束符 + 补齐（至少 1 字节）
+    void  padTo4();                         // 补齐到 4 字节（可能为 0 字节）
+
+    QByteArray     m_buffer;
+    QStringEncoder m_utf8 { QStringEncoder::Utf8 };
+    bool           m_inBundle     = false;
+    qsizetype      m_elementStart = -1;     // bundle 元素长度字段的位置
+};
+
+#endif // OSCPACKETBUILDER_H
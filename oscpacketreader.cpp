@@ -0,0 +1,125 @@
+#include "oscpacketreader.h"
+#include <QtEndian>
+#include <cstring>
+
+bool OscPacketReader::decode(const QByteArray &packet, QList<OscMessage> *messages)
+{
+    messages->clear();
+    return decodeElement(packet.constData(), packet.size(), 0, messages);
+}
+
+bool OscPacketReader::decodeElement(const char *data, qsizetype size, int depth,
+                                    QList<OscMessage> *messages)
+{
+    if (size < 4 || size % 4 != 0)
+        return false;
+
+    if (data[0] == '/') {
+        OscMessage message;
+        if (!decodeMessage(data, size, &message))
+            return false;
+        messages->append(message);
+        return true;
+    }
+
+    // bundle："#bundle\0" + 8 字节时间标签 + 若干 (int32 长度 + 元素)
+    if (size < 16 || std::memcmp(data, "#bundle", 8) != 0 || depth >= MAX_BUNDLE_DEPTH)
+        return false;
+    qsizetype pos = 16;
+    while (pos < size) {
+        if (size - pos < 4)
+            return false;
+        const qint32 elementBytes = qFromBigEndian<qint32>(data + pos);
+        pos += 4;
+        if (elementBytes <= 0 || elementBytes > size - pos)
+            return false;
+        if (!decodeElement(data + pos, elementBytes, depth + 1, messages))
+            return false;
+        pos += elementBytes;
+    }
+    return true;
+}
+
+qsizetype OscPacketReader::readString(const char *data, qsizetype size, qsizetype pos, QByteArray *out)
+{
+    const void *terminator = std::memchr(data + pos, '\0', size_t(size - pos));
+    if (!terminator)
+        return -1;
+    const qsizetype length = static_cast<const char*>(terminator) - (data + pos);
+    if (out)
+        *out = QByteArray(data + pos, length);
+    const qsizetype next = pos + ((length / 4) + 1) * 4;   // 结束符 + 补齐
+    return next <= size ? next : -1;
+}
+
+bool OscPacketReader::decodeMessage(const char *data, qsizetype size, OscMessage *message)
+{
+    qsizetype pos = readString(data, size, 0, &message->address);
+    if (pos < 0)
+        return false;
+
+    // 类型标签可省略（旧实现），此时视为无参数
+    if (pos == size)
+        return true;
+    QByteArray typeTags;
+    pos = readString(data, size, pos, &typeTags);
+    if (pos < 0 || typeTags.isEmpty() || typeTags[0] != ',')
+        return false;
+
+    for (qsizetype t = 1; t < typeTags.size(); ++t) {
+        const char type = typeTags[t];
+        switch (type) {
+        case 'i':
+        case 'f':
+            if (size - pos < 4) return false;
+            if (type == 'i') {
+                message->arguments.append(qFromBigEndian<qint32>(data + pos));
+            } else {
+                const quint32 bits = qFromBigEndian<quint32>(data + pos);
+                float value;
+                std::memcpy(&value, &bits, sizeof(value));
+                message->arguments.append(value);
+            }
+            pos += 4;
+            break;
+        case 'h':
+        case 'd':
+            if (size - pos < 8) return false;
+            if (type == 'h') {
+                message->arguments.append(qFromBigEndian<qint64>(data + pos));
+            } else {
+                const quint64 bits = qFromBigEndian<quint64>(data + pos);
+                double value;
+                std::memcpy(&value, &bits, sizeof(value));
+                message->arguments.append(value);
+            }
+            pos += 8;
+            break;
+        case 's':
+        case 'S': {
+            QByteArray text;
+            pos = readString(data, size, pos, &text);
+            if (pos < 0) return false;
+            message->arguments.append(QString::fromUtf8(text));
+            break;
+        }
+        case 'b': {
+            if (size - pos < 4) return false;
+            const qint32 blobBytes = qFromBigEndian<qint32>(data + pos);
+            pos += 4;
+            const qsizetype padded = (qsizetype(blobBytes) + 3) / 4 * 4;
+            if (blobBytes < 0 || padded > size - pos) return false;
+            message->arguments.append(QByteArray(data + pos, blobBytes));
+            pos += padded;
+            break;
+        }
+        case 'T': message->arguments.append(true);  break;
+        case 'F': message->arguments.append(false); break;
+        case 'N':
+        case 'I': message->arguments.append(QVariant()); break;
+        default:
+            return false;                       // 未知类型无法确定长度
+        }
+    }
+    return pos == size;
+}
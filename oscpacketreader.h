@@ -0,0 +1,39 @@
+#ifndef OSCPACKETREADER_H
+#define OSCPACKETREADER_H
+
+#include <QByteArray>
+#include <QList>
+#include <QString>
+#include <QVariant>
+
+// 一条解码后的 OSC 消息
+// 参数类型：i → int，h → qint64，f → float，d → double，s/S → QString，b → QByteArray，
+// T/F → bool，N/I → 空 QVariant
+struct OscMessage
+{
+    QByteArray   address;
+    QVariantList arguments;
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+// OscPacketReader — OSC 1.0 报文解码器（OscPacketBuilder 的逆过程）
+//
+// 解码一个 UDP 数据报：单条消息，或（可嵌套的）bundle，bundle 展开为消息列表，
+// 时间标签忽略（VRChat 发出的都是立即执行）。
+// 长度、对齐、字符串结束符、类型标签任何一处不合法都返回 false，不读越界。
+// ─────────────────────────────────────────────────────────────────────────────
+class OscPacketReader
+{
+public:
+    static bool decode(const QByteArray &packet, QList<OscMessage> *messages);
+
+private:
+    static bool decodeElement(const char *data, qsizetype size, int depth, QList<OscMessage> *messages);
+    static bool decodeMessage(const char *data, qsizetype size, OscMessage *message);
+    // 读取以 '\0' 结束并补齐到 4 字节的字符串，返回下一个字段的位置，失败返回 -1
+    static qsizetype readString(const char *data, qsizetype size, qsizetype pos, QByteArray *out);
+
+    static constexpr int MAX_BUNDLE_DEPTH = 8;
+};
+
+#endif // OSCPACKETREADER_H
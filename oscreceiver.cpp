@@ -0,0 +1,118 @@
+#include "oscreceiver.h"
+#include "ConfigManager.h"
+#include <QUdpSocket>
+
+namespace {
+const QByteArray MUTE_SELF_ADDRESS = "/avatar/parameters/MuteSelf";
+}
+
+OscReceiver::OscReceiver(QObject *parent)
+    : QObject(parent)
+{}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// initialize() — 按配置（重新）绑定监听端口；套接字在所在线程中创建
+// ─────────────────────────────────────────────────────────────────────────────
+void OscReceiver::initialize()
+{
+    ConfigManager& config = ConfigManager::getInstance();
+    m_enabled = config.getMuteGating();
+    m_port    = quint16(config.getOscListenPort());
+    m_pttAddress = config.getPushToTalk() ? config.getPttOscParameter().trimmed().toUtf8() : QByteArray();
+
+    if (m_muted) {
+        m_muted = false;                        // 重新启动后按未静音处理，等待 VRChat 下一次通知
+        emit muteChanged(false);
+    }
+    if (m_pttHeld) {
+        m_pttHeld = false;
+        emit pushToTalkChanged(false);
+    }
+    if (m_socket) {
+        m_socket->close();
+    } else {
+        m_socket = new QUdpSocket(this);
+        connect(m_socket, &QUdpSocket::readyRead, this, &OscReceiver::onReadyRead);
+    }
+    if (!m_enabled && m_pttAddress.isEmpty()) {
+        return;
+    }
+
+    // 独占绑定：UDP 单播在共享端口上只会交给其中一个进程，共享绑定会让
+    // 静音 / 按键说话的参数被别的 OSC 工具悄悄吞掉，宁可启动时明确报错
+    if (!m_socket->bind(QHostAddress::LocalHost, m_port, QUdpSocket::DefaultForPlatform)) {
+        if (m_socket->error() == QAbstractSocket::AddressInUseError) {
+            emit error(QString("OSC receiver: port %1 is already in use by another program "
+                               "(another OSC tool?). Close it, route VRChat's OSC output "
+                               "through an OSC router, or change oscListenPort.")
+                           .arg(m_port));
+        } else {
+            emit error(QString("OSC receiver: cannot listen on port %1: %2")
+                           .arg(m_port).arg(m_socket->errorString()));
+        }
+        return;
+    }
+    emit debug(QString("正在监听 VRChat OSC 输出端口 %1").arg(m_port));
+    if (m_enabled) {
+        emit debug("游戏内静音时暂停识别");
+    }
+    if (!m_pttAddress.isEmpty()) {
+        emit debug(QString("按键说话：OSC 参数 %1").arg(QString::fromUtf8(m_pttAddress)));
+    }
+}
+
+void OscReceiver::onReadyRead()
+{
+    while (m_socket->hasPendingDatagrams()) {
+        m_datagram.resize(qMax<qint64>(0, m_socket->pendingDatagramSize()));
+        const qint64 received = m_socket->readDatagram(m_datagram.data(), m_datagram.size());
+        if (received < 0) {
+            continue;
+        }
+        m_datagram.resize(received);
+
+        if (!OscPacketReader::decode(m_datagram, &m_messages)) {
+            continue;                           // 不是合法的 OSC 报文，忽略
+        }
+        for (const OscMessage &message : std::as_const(m_messages)) {
+            handleMessage(message);
+        }
+    }
+}
+
+void OscReceiver::handleMessage(const OscMessage &message)
+{
+    if (message.arguments.isEmpty()) {
+        return;
+    }
+    if (!m_pttAddress.isEmpty() && message.address == m_pttAddress) {
+        const bool held = toBool(message.arguments.first());
+        if (held != m_pttHeld) {
+            m_pttHeld = held;
+            emit pushToTalkChanged(held);
+        }
+        return;
+    }
+    if (!m_enabled || message.address != MUTE_SELF_ADDRESS) {
+        return;
+    }
+    const bool muted = toBool(message.arguments.first());
+    if (muted == m_muted) {
+        return;
+    }
+    m_muted = muted;
+    emit muteChanged(muted);
+    emit debug(muted ? "游戏内已静音，暂停识别" : "游戏内已取消静音，恢复识别");
+}
+
+bool OscReceiver::toBool(const QVariant &value)
+{
+    switch (value.typeId()) {
+    case QMetaType::Bool:   return value.toBool();
+    case QMetaType::Int:
+    case QMetaType::LongLong: return value.toLongLong() != 0;
+    case QMetaType::Float:
+    case QMetaType::Double: return value.toDouble() > 0.5;
+    default:                return false;
+    }
+}
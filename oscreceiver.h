@@ -0,0 +1,53 @@
+#ifndef OSCRECEIVER_H
+#define OSCRECEIVER_H
+
+#include <QObject>
+#include <QList>
+#include "oscpacketreader.h"
+
+class QUdpSocket;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// OscReceiver — 监听 VRChat 的 OSC 输出端口（默认 9001）
+//
+// VRChat 在参数变化时发出 /avatar/parameters/MuteSelf 等消息。
+// 游戏内静音时没人听得到，这时继续断句、识别、翻译只会浪费 CPU 和接口额度，
+// 还会把没人听到的话发进聊天框；muteChanged 通知 AudioCapture 暂停处理。
+// 启动时假定未静音，只在状态变化时发出信号。
+// 按键说话模式下还监听 pttOscParameter 指定的按钮参数（如手势菜单里的开关），
+// 由 pushToTalkChanged 驱动录音，非 Windows 平台或不想用全局热键时使用。
+// ─────────────────────────────────────────────────────────────────────────────
+class OscReceiver : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit OscReceiver(QObject *parent = nullptr);
+
+public slots:
+    void initialize();
+
+signals:
+    void muteChanged(bool muted);
+    void pushToTalkChanged(bool held);
+    void error(const QString &message);
+    void debug(const QString &message);
+
+private slots:
+    void onReadyRead();
+
+private:
+    void handleMessage(const OscMessage &message);
+    static bool toBool(const QVariant &value);     // T/F，或 VRChat 以 int/float 表示的布尔参数
+
+    QUdpSocket        *m_socket = nullptr;
+    QList<OscMessage>  m_messages;                 // 复用的解码结果
+    QByteArray         m_datagram;                 // 复用的接收缓冲区
+    bool    m_enabled   = true;                    // 配置 muteGating
+    quint16 m_port      = 9001;                    // 配置 oscListenPort
+    bool    m_muted     = false;
+    QByteArray m_pttAddress;                       // 配置 pttOscParameter，按键说话关闭时为空
+    bool    m_pttHeld   = false;
+};
+
+#endif // OSCRECEIVER_H
@@ -0,0 +1,130 @@
+#include "pushtotalkkey.h"
+#include "ConfigManager.h"
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+
+namespace {
+// 低级键盘钩子的回调没有用户参数，只能经由静态指针找回对象；同一时刻只安装一个钩子
+PushToTalkKey *s_instance = nullptr;
+
+LRESULT CALLBACK keyboardProc(int code, WPARAM wParam, LPARAM lParam)
+{
+    if (code == HC_ACTION && s_instance) {
+        const auto *info = reinterpret_cast<const KBDLLHOOKSTRUCT*>(lParam);
+        const bool down = (wParam == WM_KEYDOWN || wParam == WM_SYSKEYDOWN);
+        const bool up   = (wParam == WM_KEYUP   || wParam == WM_SYSKEYUP);
+        if (down || up) {
+            s_instance->handleKey(info->vkCode, down);
+        }
+    }
+    return CallNextHookEx(nullptr, code, wParam, lParam);   // 不吞掉按键
+}
+}
+#endif
+
+PushToTalkKey::PushToTalkKey(QObject *parent)
+    : QObject(parent)
+{}
+
+PushToTalkKey::~PushToTalkKey()
+{
+#ifdef Q_OS_WIN
+    if (m_hook) {
+        UnhookWindowsHookEx(static_cast<HHOOK>(m_hook));
+        s_instance = nullptr;
+    }
+#endif
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// initialize() — 按键说话开启且配置了热键时安装钩子，否则卸载
+// ─────────────────────────────────────────────────────────────────────────────
+void PushToTalkKey::initialize()
+{
+    ConfigManager& config = ConfigManager::getInstance();
+    uninstall();
+
+    const QString hotkey = config.getPttHotkey().trimmed();
+    if (!config.getPushToTalk() || hotkey.isEmpty()) {
+        return;
+    }
+    m_virtualKey = virtualKeyFromName(hotkey);
+    if (m_virtualKey == 0) {
+        emit error(QString("Push-to-talk: unknown hotkey \"%1\"").arg(hotkey));
+        return;
+    }
+
+#ifdef Q_OS_WIN
+    s_instance = this;
+    m_hook = SetWindowsHookExW(WH_KEYBOARD_LL, keyboardProc, GetModuleHandleW(nullptr), 0);
+    if (!m_hook) {
+        s_instance = nullptr;
+        emit error(QString("Push-to-talk: cannot install keyboard hook (error %1)").arg(GetLastError()));
+        return;
+    }
+    emit debug(QString("按键说话：按住 %1 说话").arg(hotkey));
+#else
+    emit error("Push-to-talk: global hotkey is only supported on Windows, use pttOscParameter instead");
+#endif
+}
+
+void PushToTalkKey::uninstall()
+{
+#ifdef Q_OS_WIN
+    if (m_hook) {
+        UnhookWindowsHookEx(static_cast<HHOOK>(m_hook));
+        s_instance = nullptr;
+    }
+#endif
+    m_hook = nullptr;
+    if (m_held) {
+        m_held = false;                         // 卸载时按键仍按着：视为松开，结束当前句子
+        emit stateChanged(false);
+    }
+}
+
+void PushToTalkKey::handleKey(unsigned long virtualKey, bool down)
+{
+    if (virtualKey != m_virtualKey || down == m_held) {
+        return;                                 // 其他按键，或按住时的自动重复
+    }
+    m_held = down;
+    emit stateChanged(down);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// virtualKeyFromName() — 键名 → Windows 虚拟键码
+// 支持 F1–F24、A–Z、0–9 以及常用的修饰键 / 功能键名称（不区分大小写）
+// ─────────────────────────────────────────────────────────────────────────────
+unsigned long PushToTalkKey::virtualKeyFromName(const QString &name)
+{
+    const QString key = name.toUpper();
+
+    if (key.size() == 1) {
+        const QChar c = key.at(0);
+        if ((c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9'))
+            return c.unicode();                 // 字母和数字的虚拟键码就是其 ASCII 码
+    }
+    if (key.startsWith('F') && key.size() <= 3) {
+        bool ok = false;
+        const int n = key.mid(1).toInt(&ok);
+        if (ok && n >= 1 && n <= 24)
+            return 0x70 + (n - 1);              // VK_F1 … VK_F24
+    }
+
+    static const struct { const char *name; unsigned long vk; } NAMED_KEYS[] = {
+        { "SPACE",    0x20 }, { "CAPSLOCK", 0x14 }, { "TAB",      0x09 },
+        { "INSERT",   0x2D }, { "DELETE",   0x2E }, { "HOME",     0x24 },
+        { "END",      0x23 }, { "PAGEUP",   0x21 }, { "PAGEDOWN", 0x22 },
+        { "PAUSE",    0x13 }, { "SCROLLLOCK", 0x91 },
+        { "LSHIFT",   0xA0 }, { "RSHIFT",   0xA1 },
+        { "LCTRL",    0xA2 }, { "RCTRL",    0xA3 },
+        { "LALT",     0xA4 }, { "RALT",     0xA5 },
+    };
+    for (const auto &entry : NAMED_KEYS) {
+        if (key == QLatin1String(entry.name))
+            return entry.vk;
+    }
+    return 0;
+}
@@ -0,0 +1,44 @@
+#ifndef PUSHTOTALKKEY_H
+#define PUSHTOTALKKEY_H
+
+#include <QObject>
+#include <QString>
+
+// ─────────────────────────────────────────────────────────────────────────────
+// PushToTalkKey — 按键说话的全局热键（配置 pttHotkey，如 F8、CapsLock、RCtrl）
+//
+// 游戏窗口在前台时本程序收不到普通键盘事件，Windows 下用低级键盘钩子
+// （WH_KEYBOARD_LL）监听按下/松开，不吞掉按键，游戏照常收到。
+// 钩子回调在安装它的线程（主线程）的消息循环中执行，只比较键码并发信号。
+// 按住时系统的自动重复按下会被过滤，stateChanged 只在状态变化时发出。
+// 其他平台没有全局钩子，可改用 VRChat 的 OSC 按钮参数（pttOscParameter）。
+// ─────────────────────────────────────────────────────────────────────────────
+class PushToTalkKey : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit PushToTalkKey(QObject *parent = nullptr);
+    ~PushToTalkKey() override;
+
+    // 由键盘钩子回调调用（主线程）
+    void handleKey(unsigned long virtualKey, bool down);
+
+public slots:
+    void initialize();      // 按配置安装 / 卸载钩子
+
+signals:
+    void stateChanged(bool held);
+    void error(const QString &message);
+    void debug(const QString &message);
+
+private:
+    void uninstall();
+    static unsigned long virtualKeyFromName(const QString &name);   // 不认识的键名返回 0
+
+    void          *m_hook       = nullptr;      // HHOOK
+    unsigned long  m_virtualKey = 0;
+    bool           m_held       = false;
+};
+
+#endif // PUSHTOTALKKEY_H
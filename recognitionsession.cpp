@@ -0,0 +1,357 @@
+#include "recognitionsession.h"
+#include "xunfeiconnectionpool.h"
+#include "xunfeiframeencoder.h"
+
+RecognitionSession::RecognitionSession(quint64 id, const Settings &settings,
+                                       XunFeiConnectionPool *pool, XunFeiFrameEncoder *encoder,
+                                       QObject *parent)
+    : QObject(parent)
+    , m_id(id)
+    , m_pool(pool)
+    , m_encoder(encoder)
+    , m_streaming(settings.streaming)
+{
+    m_connectTimer = new QTimer(this);
+    m_connectTimer->setSingleShot(true);
+    connect(m_connectTimer, &QTimer::timeout, this, &RecognitionSession::onTimeout);
+
+    m_resultTimer = new QTimer(this);
+    m_resultTimer->setSingleShot(true);
+    connect(m_resultTimer, &QTimer::timeout, this, &RecognitionSession::onTimeout);
+
+    m_paceTimer = new QTimer(this);
+    m_paceTimer->setTimerType(Qt::PreciseTimer);
+    connect(m_paceTimer, &QTimer::timeout,
+            this, &RecognitionSession::pumpStreamingAudio);
+
+    // 缓冲区在会话创建时一次性预留，逐帧收集时不再分配
+    if (m_streaming) {
+        m_pendingFrames.reserve(PENDING_RESERVE);
+    } else {
+        m_accumulatedAudio.reserve(AudioFramePool::FRAME_BYTES * AudioFramePool::MAX_UTTERANCE_FRAMES);
+    }
+}
+
+RecognitionSession::~RecognitionSession()
+{
+    releaseSocket();
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// start() - 获得在途名额：取得连接，流式模式下开始发送积压的音频
+// ─────────────────────────────────────────────────────────────────────────────
+void RecognitionSession::start()
+{
+    if (m_started || m_completed) {
+        return;
+    }
+    m_started = true;
+    connectToServer();
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// appendAudio() - 收集音频分片
+// 整句模式拷入预留缓冲区后立即归还帧；流式模式排队持有引用直到发出
+// ─────────────────────────────────────────────────────────────────────────────
+void RecognitionSession::appendAudio(const AudioFrameRef &frame)
+{
+    if (m_endRequested || m_completed) {
+        return;
+    }
+
+    if (!m_streaming) {
+        m_accumulatedAudio.append(frame.constData(), frame.size());
+        return;
+    }
+
+    m_pendingFrames.enqueue(frame);
+
+    // 已连接且节拍器空闲（队列曾被发空）时立即发送，不必等下一拍
+    if (m_isConnected && !m_paceTimer->isActive()) {
+        pumpStreamingAudio();
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// finish() - 本句结束
+// 流式模式：剩余帧由节拍器继续发送，发完后自动补发尾帧
+// 整句模式：等待调度器分配名额后一次性发送
+// ─────────────────────────────────────────────────────────────────────────────
+void RecognitionSession::finish()
+{
+    if (m_endRequested || m_completed) {
+        return;
+    }
+    m_endRequested = true;
+
+    const bool hasAudio = !m_accumulatedAudio.isEmpty()
+                          || !m_pendingFrames.isEmpty() || m_firstFrameSent;
+    if (!hasAudio) {
+        complete(QString());
+        return;
+    }
+
+    if (m_streaming && m_isConnected && !m_paceTimer->isActive()) {
+        pumpStreamingAudio();
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// cancel() - 放弃本句：不发送尾帧，直接关闭连接（讯飞不会返回结果）
+// ─────────────────────────────────────────────────────────────────────────────
+void RecognitionSession::cancel()
+{
+    if (m_completed) {
+        return;
+    }
+    m_endRequested = true;
+    emit debug(QString("识别会话 #%1: 已取消").arg(m_id));
+    complete(QString());
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// connectToServer() - 从连接池取得本会话的连接
+// ─────────────────────────────────────────────────────────────────────────────
+void RecognitionSession::connectToServer()
+{
+    if (m_webSocket) {
+        return;
+    }
+
+    m_webSocket = m_pool->acquire(this);
+    connect(m_webSocket, &QWebSocket::connected,
+            this, &RecognitionSession::onWebSocketConnected);
+    connect(m_webSocket, &QWebSocket::textMessageReceived,
+            this, &RecognitionSession::onTextMessageReceived);
+    connect(m_webSocket, &QWebSocket::disconnected,
+            this, &RecognitionSession::onWebSocketDisconnected);
+    connect(m_webSocket, QOverload<QAbstractSocket::SocketError>::of(&QWebSocket::error),
+            this, &RecognitionSession::onWebSocketError);
+
+    if (m_webSocket->state() == QAbstractSocket::ConnectedState) {
+        // 预热连接已就绪，跳过建连
+        onWebSocketConnected();
+        return;
+    }
+
+    m_connectTimer->start(CONNECT_TIMEOUT_MS);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// releaseSocket() - 释放连接（讯飞连接只承载一次会话，不放回连接池）
+// ─────────────────────────────────────────────────────────────────────────────
+void RecognitionSession::releaseSocket()
+{
+    if (!m_webSocket) {
+        return;
+    }
+    m_webSocket->disconnect(this);
+    m_webSocket->close();
+    m_webSocket->deleteLater();
+    m_webSocket = nullptr;
+    m_isConnected = false;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// onWebSocketConnected()
+// ─────────────────────────────────────────────────────────────────────────────
+void RecognitionSession::onWebSocketConnected()
+{
+    m_connectTimer->stop();
+    m_isConnected = true;
+
+    if (m_streaming) {
+        // 连接期间积压的帧先补发，随后进入实时节拍
+        pumpStreamingAudio();
+        return;
+    }
+
+    if (m_endRequested) {
+        sendFullAudio();
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// pumpStreamingAudio() - 流式发送一个节拍的音频
+//
+// 关键点：
+//   1. 第一帧 status=0 携带 common + business，之后均为 status=1
+//   2. 正常情况下每拍发送一帧（40ms 音频），与实时速率一致；
+//      积压较多（如预积累帧、连接建立期间的帧）时每拍补发多帧
+//   3. 收到 stopRecognition 且队列发空后发送 status=2 尾帧
+// ─────────────────────────────────────────────────────────────────────────────
+void RecognitionSession::pumpStreamingAudio()
+{
+    if (!m_webSocket || m_webSocket->state() != QAbstractSocket::ConnectedState) {
+        m_paceTimer->stop();
+        return;
+    }
+
+    const int budget = (m_pendingFrames.size() > STREAM_BACKLOG_FRAMES)
+                           ? STREAM_CATCHUP_FRAMES : 1;
+    for (int i = 0; i < budget && !m_pendingFrames.isEmpty(); ++i) {
+        const AudioFrameRef frame = m_pendingFrames.dequeue();
+        sendAudioFrame(m_firstFrameSent ? 1 : 0, frame.constData(), frame.size());
+        m_firstFrameSent = true;
+    }
+
+    if (!m_pendingFrames.isEmpty()) {
+        if (!m_paceTimer->isActive()) {
+            m_paceTimer->start(STREAM_FRAME_MS);
+        }
+        return;
+    }
+
+    // 队列已发空：尚在说话则停拍等待下一帧到来，已结束则发送尾帧
+    m_paceTimer->stop();
+    if (m_endRequested && m_firstFrameSent) {
+        sendEndFrame();
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// sendAudioFrame() / sendEndFrame() - 构造并发送讯飞协议帧
+// ─────────────────────────────────────────────────────────────────────────────
+void RecognitionSession::sendAudioFrame(int status, const char *audio, int size)
+{
+    // JSON 外壳与 base64 直接写入编码器的复用缓冲区，不经过 QJsonObject
+    m_webSocket->sendTextMessage(
+        XunFeiFrameEncoder::toMessage(m_encoder->encodeAudio(status, audio, size)));
+}
+
+void RecognitionSession::sendEndFrame()
+{
+    // 根据讯飞文档，尾帧只包含 data.status=2
+    m_webSocket->sendTextMessage(XunFeiFrameEncoder::toMessage(m_encoder->encodeEnd()));
+
+    // 尾帧发出后开始等待最终结果
+    m_resultTimer->start(RESULT_TIMEOUT_MS);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// sendFullAudio() - 一次性发送完整音频（参考旧版本逻辑）
+//
+// 关键点：
+//   1. 所有音频数据放在第一帧（status=0）的 data.audio 中
+//   2. 立即发送尾帧（status=2）结束识别
+//   3. 不分片发送，避免讯飞返回空结果
+// ─────────────────────────────────────────────────────────────────────────────
+void RecognitionSession::sendFullAudio()
+{
+    // ─── 第一帧（status=0）：携带 common + business + 全部音频 ───
+    sendAudioFrame(0, m_accumulatedAudio.constData(), static_cast<int>(m_accumulatedAudio.size()));
+    m_accumulatedAudio.clear();
+
+    // ─── 尾帧（status=2） ───
+    sendEndFrame();
+
+    // 注意：不要立即关闭连接，等待识别结果返回后再关闭
+    // 识别结果会在 onTextMessageReceived 中处理
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// onTextMessageReceived() - 处理讯飞返回的消息
+// ─────────────────────────────────────────────────────────────────────────────
+void RecognitionSession::onTextMessageReceived(const QString &message)
+{
+    if (m_completed) return;
+
+    // 拉取式解析：直接扫描 UTF-16 消息，不构造 QJsonDocument
+    if (!m_parser.parse(message, &m_result)) {
+        return;
+    }
+
+    // 检查错误码
+    if (m_result.code != 0) {
+        emit error(QString("SpeechRecogniser: XunFei API error [%1]: %2")
+                       .arg(m_result.code)
+                       .arg(m_result.message.isEmpty() ? QString("Unknown error") : m_result.message));
+        complete(QString());
+        return;
+    }
+
+    if (m_result.status < 0) {
+        return;   // 不含 data
+    }
+
+    // 写入分片表：pgs=rpl 时替换 rg 范围内的旧分片，否则追加
+    if (m_result.hasResult) {
+        m_segments.apply(m_result);
+        if (m_result.status != 2) {
+            const QString full = m_segments.text();
+            const QString text = full.trimmed();
+            // trimmed() 去掉的前导空白不计入稳定前缀
+            qsizetype leading = 0;
+            while (leading < full.size() && full.at(leading).isSpace()) {
+                ++leading;
+            }
+            const qsizetype stable = qBound<qsizetype>(0, m_segments.stableLength() - leading, text.size());
+            emit partial(m_id, text, int(stable));
+        }
+    }
+
+    // 最终结果（status=2）
+    if (m_result.status == 2) {
+        complete(m_segments.text().trimmed());
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// onWebSocketDisconnected() - 最终结果之前连接被断开：交付已收到的部分文本
+// ─────────────────────────────────────────────────────────────────────────────
+void RecognitionSession::onWebSocketDisconnected()
+{
+    if (!m_completed) {
+        emit debug(QString("识别会话 #%1: 连接在结果返回前断开").arg(m_id));
+    }
+    complete(m_segments.text().trimmed());
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// onWebSocketError()
+// ─────────────────────────────────────────────────────────────────────────────
+void RecognitionSession::onWebSocketError(QAbstractSocket::SocketError socketError)
+{
+    QString errorMsg;
+    switch (socketError) {
+    case QAbstractSocket::ConnectionRefusedError: errorMsg = "connection refused"; break;
+    case QAbstractSocket::RemoteHostClosedError:  errorMsg = "remote host closed"; break;
+    case QAbstractSocket::HostNotFoundError:      errorMsg = "host not found"; break;
+    case QAbstractSocket::SocketTimeoutError:     errorMsg = "socket timeout"; break;
+    default:                                      errorMsg = m_webSocket->errorString(); break;
+    }
+    emit error(QString("SpeechRecogniser: WebSocket error: %1").arg(errorMsg));
+
+    complete(QString());
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// onTimeout() - 连接超时或等待结果超时，放弃本句以免阻塞后续句子的按序输出
+// ─────────────────────────────────────────────────────────────────────────────
+void RecognitionSession::onTimeout()
+{
+    emit error(QString("SpeechRecogniser: session #%1 %2 timeout")
+                   .arg(m_id)
+                   .arg(m_isConnected ? "result" : "connect"));
+    complete(m_segments.text().trimmed());
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// complete() - 结束会话
+// ─────────────────────────────────────────────────────────────────────────────
+void RecognitionSession::complete(const QString &text)
+{
+    if (m_completed) {
+        return;
+    }
+    m_completed = true;
+
+    m_connectTimer->stop();
+    m_resultTimer->stop();
+    m_paceTimer->stop();
+    releaseSocket();
+    m_accumulatedAudio.clear();
+    m_pendingFrames.clear();
+
+    emit completed(m_id, text);
+}
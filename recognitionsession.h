@@ -0,0 +1,125 @@
+#ifndef RECOGNITIONSESSION_H
+#define RECOGNITIONSESSION_H
+
+#include <QObject>
+#include <QWebSocket>
+#include <QTimer>
+#include <QByteArray>
+#include <QQueue>
+#include "audioframepool.h"
+#include "xunfeiresultparser.h"
+
+class XunFeiConnectionPool;
+class XunFeiFrameEncoder;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// RecognitionSession — 一句话（一次 start/stop）对应的讯飞识别会话
+//
+// 每个会话独立持有自己的音频缓冲、WebSocket 连接和识别文本，
+// 由 SpeechRecogniser 统一调度，多个会话可以同时在途。
+// 会话结束（成功、失败或超时）时恰好发出一次 completed()。
+// ─────────────────────────────────────────────────────────────────────────────
+class RecognitionSession : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Settings {
+        bool    streaming  = true;   // 流式（边说边传）或整句模式
+    };
+
+    // encoder 由 SpeechRecogniser 持有并按 appId / 采样率配置，同线程的会话共用一块缓冲区
+    RecognitionSession(quint64 id, const Settings &settings,
+                       XunFeiConnectionPool *pool, XunFeiFrameEncoder *encoder,
+                       QObject *parent = nullptr);
+    ~RecognitionSession();
+
+    quint64 id() const { return m_id; }
+
+    // 是否已获准建立连接（占用一个在途名额）
+    bool isStarted() const { return m_started; }
+
+    // 是否需要连接：流式模式从一开始就需要，整句模式在收集结束后才需要
+    bool wantsConnection() const { return m_streaming || m_endRequested; }
+
+    void start();                              // 获得在途名额，取连接并开始发送
+    void appendAudio(const AudioFrameRef &frame); // 收到一帧音频
+    void finish();                             // 本句结束（stopRecognition）
+    void cancel();                             // 误触发：立即关闭连接，以空结果结束
+
+private slots:
+    void onWebSocketConnected();
+    void onTextMessageReceived(const QString &message);
+    void onWebSocketDisconnected();
+    void onWebSocketError(QAbstractSocket::SocketError error);
+    void onTimeout();          // 连接或等待结果超时
+
+private:
+    void connectToServer();
+    void releaseSocket();
+
+    // 一次性发送所有音频（非分片方式，整句模式使用）
+    void sendFullAudio();
+
+    // 流式发送：由节拍定时器驱动，按实时速率发送 status=0/1 帧，收尾时发送 status=2
+    void pumpStreamingAudio();
+
+    // 发送一个音频数据帧；status=0 时附带 common/business 参数
+    void sendAudioFrame(int status, const char *audio, int size);
+    void sendEndFrame();
+
+    // 结束会话并发出 completed()，重复调用无效
+    void complete(const QString &text);
+
+private:
+    const quint64 m_id;
+    XunFeiConnectionPool *m_pool = nullptr;
+    XunFeiFrameEncoder   *m_encoder = nullptr;
+    QWebSocket *m_webSocket = nullptr;     // 本会话持有的连接（从连接池取得）
+    QTimer     *m_connectTimer = nullptr;  // 连接超时定时器
+    QTimer     *m_paceTimer    = nullptr;  // 流式发送节拍定时器（每 STREAM_FRAME_MS 一次）
+    QTimer     *m_resultTimer  = nullptr;  // 尾帧发出后等待最终结果的超时
+
+    bool    m_streaming;
+
+    // 状态标志
+    bool m_started         = false;  // 已获得在途名额
+    bool m_isConnected     = false;
+    bool m_firstFrameSent  = false;  // 已发送 status=0 首帧
+    bool m_endRequested    = false;  // 已收到 stopRecognition
+    bool m_completed       = false;
+
+    // 收集的完整音频数据（PCM格式，16kHz/16bit/单声道），仅整句模式使用；
+    // 按单句最长时长一次性预留，收集过程中不再扩容
+    QByteArray m_accumulatedAudio;
+
+    // 流式模式下等待发送的音频帧（连接建立前或发送速率受限时在此排队），
+    // 持有帧池引用，发送后即归还
+    QQueue<AudioFrameRef> m_pendingFrames;
+
+    // 识别结果：解析器与结果对象在会话内复用，分片表按 sn 保存（支持动态修正替换）
+    XunFeiResultParser m_parser;
+    XunFeiResult       m_result;
+    XunFeiSegmentTable m_segments;
+
+    // ─── 常量 ────────────────────────────────────────────────────────────────
+    // 讯飞建议每 40ms 发送 1280 字节；积压超过 STREAM_BACKLOG_FRAMES 时
+    // 每拍最多补发 STREAM_CATCHUP_FRAMES 帧，以便尽快追上实时。
+    static constexpr int STREAM_FRAME_MS       = 40;
+    static constexpr int STREAM_BACKLOG_FRAMES = 2;
+    static constexpr int STREAM_CATCHUP_FRAMES = 4;
+    static constexpr int PENDING_RESERVE       = 256;   // 排队句柄的预留容量（约 10s）
+    static constexpr int CONNECT_TIMEOUT_MS    = 5000;
+    static constexpr int RESULT_TIMEOUT_MS     = 15000;
+
+signals:
+    // text 为空表示本句没有可用结果（无文本、出错或超时）
+    void completed(quint64 id, const QString &text);
+    // 中间结果：text 为到目前为止的完整文本；
+    // stableLength 为其中不会再被动态修正替换的前缀长度（未开启动态修正时等于 text 长度）
+    void partial(quint64 id, const QString &text, int stableLength);
+    void error(const QString &message);
+    void debug(const QString &message);
+};
+
+#endif // RECOGNITIONSESSION_H
@@ -1,46 +1,39 @@
-#include "solooscbroadcaster.h"
-#include <QUdpSocket>
-#include "ConfigManager.h"
-
-SoloOscBroadcaster::SoloOscBroadcaster() {}
-
-void SoloOscBroadcaster::initialize(){
-    ConfigManager& config = ConfigManager::getInstance();
-    targetHost = QHostAddress(config.getTargetHost());
-    targetPort = (quint16)config.getTargetPort();
-}
-void SoloOscBroadcaster::sendToOSC(const QString& text)
-{
-    const QString oscAddress = "/chatbox/input";
-
-    // OSC协议格式：地址路径 + 类型标签 + 数据）
-    QByteArray oscData;
-
-    // 地址路径
-    oscData.append(oscAddress.toUtf8());
-    oscData.append('\0');   // 类型标签结束符
-
-    // OSC协议要求补齐4字节对齐
-    while (oscData.size() % 4 != 0) {
-        oscData.append('\0');
-    }
-
-    // 类型标签,",sT" 表示：字符串 + 布尔值true
-    oscData.append(",sT");
-    oscData.append('\0');  // 类型标签结束符
-    while (oscData.size() % 4 != 0) {
-        oscData.append('\0');
-    }
-
-    // 字符串数据,null结尾，4字节对齐
-    QByteArray textBytes = text.toUtf8();
-    oscData.append(textBytes);
-    oscData.append('\0');  // 字符串结束符
-    while (oscData.size() % 4 != 0) {
-        oscData.append('\0');
-    }
-
-    // 发送UDP数据
-    QUdpSocket udpSocket;
-    qint64 bytesSent = udpSocket.writeDatagram(oscData, targetHost, targetPort);
-}
+#include "solooscbroadcaster.h"
+#include <QUdpSocket>
+#include "ConfigManager.h"
+
+namespace {
+// 类型标签 ",sTT" 表示：字符串 + 立即发送(true) + 提示音；中间结果为 ",sTF"（不提示）
+const QByteArray CHATBOX_NOTIFY = OscPacketBuilder::messagePrefix("/chatbox/input", ",sTT");
+const QByteArray CHATBOX_QUIET  = OscPacketBuilder::messagePrefix("/chatbox/input", ",sTF");
+}
+
+SoloOscBroadcaster::SoloOscBroadcaster() {}
+
+void SoloOscBroadcaster::initialize(){
+    ConfigManager& config = ConfigManager::getInstance();
+    targetHost = QHostAddress(config.getTargetHost());
+    targetPort = (quint16)config.getTargetPort();
+
+    if (!udpSocket) {
+        udpSocket = new QUdpSocket(this);
+        udpSocket->bind(QHostAddress::AnyIPv4, 0);   // 固定源端口，不再每条消息新建套接字
+    }
+}
+
+void SoloOscBroadcaster::sendChatbox(const QString& text, bool notify)
+{
+    packet.beginMessage(notify ? CHATBOX_NOTIFY : CHATBOX_QUIET);
+    packet.addString(text);
+    sendPacket(packet.data());
+}
+
+void SoloOscBroadcaster::sendPacket(const QByteArray& data)
+{
+    if (!udpSocket) {
+        return;                                     // 尚未 initialize
+    }
+    if (udpSocket->writeDatagram(data, targetHost, targetPort) < 0) {
+        emit error(QString("OSC send failed: %1").arg(udpSocket->errorString()));
+    }
+}
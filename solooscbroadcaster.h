@@ -1,21 +1,36 @@
-#ifndef SOLOOSCBROADCASTER_H
-#define SOLOOSCBROADCASTER_H
-
-#include <QString>
-#include <QObject>
-#include <QUdpSocket>
-
-class SoloOscBroadcaster : public QObject
-{
-private:
-    QHostAddress targetHost;
-    quint16 targetPort;
-public:
-    SoloOscBroadcaster();
-
-public slots:
-    void initialize();
-    void sendToOSC(const QString& text);
-};
-
-#endif // SOLOOSCBROADCASTER_H
+#ifndef SOLOOSCBROADCASTER_H
+#define SOLOOSCBROADCASTER_H
+
+#include <QString>
+#include <QObject>
+#include <QUdpSocket>
+#include "oscpacketbuilder.h"
+
+class SoloOscBroadcaster : public QObject
+{
+    Q_OBJECT
+
+private:
+    QHostAddress targetHost;
+    quint16 targetPort;
+
+    // 长期持有、只绑定一次的发送套接字（在所在线程中创建）和复用的报文编码器
+    QUdpSocket       *udpSocket = nullptr;
+    OscPacketBuilder  packet;
+
+    void sendPacket(const QByteArray& data);
+public:
+    SoloOscBroadcaster();
+
+    // 发送一条聊天框消息（notify: 是否提示音）；分页、限速由 ChatboxScheduler 负责
+    void sendChatbox(const QString& text, bool notify);
+
+public slots:
+    void initialize();
+
+signals:
+    void error(const QString &message);
+    void debug(const QString &message);
+};
+
+#endif // SOLOOSCBROADCASTER_H
@@ -1,70 +1,95 @@
-#ifndef SPEECHRECOGNISER_H
-#define SPEECHRECOGNISER_H
-
-#include <QObject>
-#include <QWebSocket>
-#include <QTimer>
-#include <QByteArray>
-#include <QQueue>
-
-class SpeechRecogniser : public QObject
-{
-    Q_OBJECT
-
-public:
-    explicit SpeechRecogniser(QObject *parent = nullptr);
-    ~SpeechRecogniser();
-
-public slots:
-    void initialize();
-    void onStartRecognition();
-    void onSendAudioChunk(const QByteArray &chunk);
-    void onStopRecognition();
-
-private slots:
-    void onWebSocketConnected();
-    void onTextMessageReceived(const QString &message);
-    void onWebSocketDisconnected();
-    void onWebSocketError(QAbstractSocket::SocketError error);
-
-private:
-    void connectToServer();
-    QString generateAuthUrl();
-    QString formatTimestamp();
-
-    // 一次性发送所有音频（非分片方式）
-    void sendFullAudio();
-
-    void resetState();
-
-private:
-    QWebSocket *m_webSocket = nullptr;
-    QTimer     *m_connectTimer = nullptr;  // 连接超时定时器
-
-    QString m_appId;
-    QString m_apiKey;
-    QString m_apiSecret;
-    QString m_host       = "iat-api.xfyun.cn";
-    QString m_path       = "/v2/iat";
-    int     m_sampleRate = 16000;
-
-    // 状态标志
-    bool m_isConnected   = false;
-    bool m_isRecognising = false;
-    bool m_isCollecting  = false;   // 是否正在收集音频
-    bool m_completed     = false;
-
-    // 收集的完整音频数据（PCM格式，16kHz/16bit/单声道）
-    QByteArray m_accumulatedAudio;
-
-    // 识别结果
-    QString m_partialText;
-    QString m_finalText;
-
-signals:
-    void recognitionCompleted(const QString &text);
-    void error(const QString &message);
-    void debug(const QString &message);
-};
-
-#endif // SPEECHRECOGNISER_H
+#ifndef SPEECHRECOGNISER_H
+#define SPEECHRECOGNISER_H
+
+#include <QObject>
+#include <QByteArray>
+#include "audioframepool.h"
+#include "xunfeiframeencoder.h"
+#include <QMap>
+
+class XunFeiConnectionPool;
+class RecognitionSession;
+class AudioHandoffQueue;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// SpeechRecogniser — 识别会话调度器
+//
+// 每次 startRecognition 创建一个带编号的 RecognitionSession，
+// 最多 m_maxInFlight 个会话同时占用连接，其余排队等待名额（不会丢句）。
+// 各会话完成顺序不定，结果按说话顺序发出 recognitionCompleted。
+// ─────────────────────────────────────────────────────────────────────────────
+class SpeechRecogniser : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit SpeechRecogniser(QObject *parent = nullptr);
+    ~SpeechRecogniser();
+
+    // 设置来自采集线程的交接队列（moveToThread 之前调用）
+    void setHandoffQueue(AudioHandoffQueue *queue);
+
+public slots:
+    void initialize();
+
+    // 交接队列中有新事件：按顺序取出并分发
+    void onAudioAvailable();
+
+    // 检测到语音起点（AudioCapture 进入 Buffering）：提前预热讯飞连接
+    void onSpeechOnset();
+
+private slots:
+    void onSessionCompleted(quint64 id, const QString &text);
+
+private:
+    void onStartRecognition(quint64 utterance);
+    void onSendAudioChunk(const AudioFrameRef &frame);
+    void onStopRecognition();
+    void onCancelRecognition();
+
+    // 按编号顺序为等待中的会话分配在途名额
+    void scheduleSessions();
+    // 按说话顺序发出已完成的结果
+    void deliverInOrder();
+    void reportQueueDepth();
+    void clearSessions();
+
+private:
+    XunFeiConnectionPool *m_pool = nullptr;
+    AudioHandoffQueue    *m_handoff = nullptr;
+    XunFeiFrameEncoder    m_encoder;   // 所有会话共用的协议帧编码器
+
+    QString m_appId;
+    QString m_apiKey;
+    QString m_apiSecret;
+    QString m_host       = "iat-api.xfyun.cn";
+    QString m_path       = "/v2/iat";
+    int     m_sampleRate = 16000;
+    bool    m_streaming  = true;   // 流式模式（边说边传）；false 时退回整句模式
+    int     m_maxInFlight = 3;     // 同时占用连接的最大会话数
+
+    // 尚未完成的会话（按编号即说话顺序排列）
+    QMap<quint64, RecognitionSession*> m_sessions;
+    // 已完成但前面还有未完成会话、暂不能发出的结果
+    QMap<quint64, QString> m_completedResults;
+
+    RecognitionSession *m_collecting = nullptr;  // 正在接收音频的会话
+    quint64 m_nextSessionId = 1;
+    quint64 m_nextToDeliver = 1;
+
+signals:
+    void recognitionCompleted(quint64 sessionId, const QString &text);
+    // 说话过程中的中间结果（按会话编号区分，可能乱序到达）
+    // stableLength：text 中不会再被动态修正替换的前缀长度
+    void recognitionPartial(quint64 sessionId, const QString &text, int stableLength);
+    // 为采集端的第 utterance 句创建了会话 sessionId（采集端据此认领本句的中间结果）
+    void sessionStarted(quint64 utterance, quint64 sessionId);
+    // 会话结束（完成、取消或出错），之后不会再有该会话的 recognitionPartial
+    void sessionFinished(quint64 sessionId);
+    // inFlight: 正在识别的会话数；pending: 尚未发出结果的句子总数
+    void queueDepthChanged(int inFlight, int pending);
+    void error(const QString &message);
+    void debug(const QString &message);
+};
+
+#endif // SPEECHRECOGNISER_H
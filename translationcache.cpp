@@ -0,0 +1,262 @@
+#include "translationcache.h"
+
+#include <QElapsedTimer>
+#include <cstring>
+
+namespace {
+// 记录头与文件头均按小端原样写入（程序只在 x86 / ARM 小端平台运行）
+template <typename T>
+T readValue(const uchar *p)
+{
+    T value;
+    std::memcpy(&value, p, sizeof(T));
+    return value;
+}
+
+template <typename T>
+void appendValue(QByteArray &out, T value)
+{
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+}
+
+TranslationCache::TranslationCache(int memoryCapacity)
+    : m_memory(memoryCapacity)
+{}
+
+TranslationCache::~TranslationCache()
+{
+    close();
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// open() — 打开磁盘层并建立索引；文件头不符时清空重建
+// ─────────────────────────────────────────────────────────────────────────────
+bool TranslationCache::open(const QString& path, QString* errorMessage)
+{
+    close();
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadWrite)) {
+        if (errorMessage) *errorMessage = m_file.errorString();
+        return false;
+    }
+
+    m_fileSize = m_file.size();
+    bool valid = m_fileSize >= HEADER_BYTES;
+    if (valid) {
+        const QByteArray header = m_file.read(HEADER_BYTES);
+        valid = readValue<quint32>(reinterpret_cast<const uchar*>(header.constData())) == FILE_MAGIC
+             && readValue<quint32>(reinterpret_cast<const uchar*>(header.constData()) + 4) == FILE_VERSION;
+    }
+    if (!valid) {
+        QByteArray header;
+        appendValue<quint32>(header, FILE_MAGIC);
+        appendValue<quint32>(header, FILE_VERSION);
+        appendValue<quint64>(header, 0);
+        if (!m_file.resize(0) || m_file.write(header) != HEADER_BYTES) {
+            if (errorMessage) *errorMessage = m_file.errorString();
+            m_file.close();
+            return false;
+        }
+        m_file.flush();
+        m_fileSize = HEADER_BYTES;
+    }
+
+    if (!loadIndex()) {
+        if (errorMessage) *errorMessage = m_file.errorString();
+        close();
+        return false;
+    }
+    return true;
+}
+
+void TranslationCache::close()
+{
+    unmapFile();
+    if (m_file.isOpen())
+        m_file.close();
+    m_diskIndex.clear();
+    m_fileSize = 0;
+}
+
+// 扫描全部记录建立索引；遇到越界的记录视为写入中断，截断到上一条完整记录
+bool TranslationCache::loadIndex()
+{
+    m_diskIndex.clear();
+    if (!mapFile())
+        return false;
+
+    qint64 offset = HEADER_BYTES;
+    while (offset + RECORD_HEAD_BYTES <= m_mapSize) {
+        const quint32 keyBytes   = readValue<quint32>(m_map + offset);
+        const quint32 valueBytes = readValue<quint32>(m_map + offset + 4);
+        const quint64 hash       = readValue<quint64>(m_map + offset + 8);
+        const qint64  end = offset + RECORD_HEAD_BYTES + qint64(keyBytes) + qint64(valueBytes);
+        if (end > m_mapSize)
+            break;
+        m_diskIndex.insert(hash, offset);
+        offset = end;
+    }
+
+    if (offset != m_fileSize) {
+        unmapFile();
+        if (!m_file.resize(offset))
+            return false;
+        m_fileSize = offset;
+    }
+    return true;
+}
+
+bool TranslationCache::mapFile()
+{
+    unmapFile();
+    m_map = m_file.map(0, m_fileSize);
+    if (!m_map)
+        return false;
+    m_mapSize = m_fileSize;
+    return true;
+}
+
+void TranslationCache::unmapFile()
+{
+    if (m_map) {
+        m_file.unmap(m_map);
+        m_map = nullptr;
+    }
+    m_mapSize = 0;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// lookup() — 先查内存层，再查磁盘层；磁盘命中的条目提升进内存层
+// ─────────────────────────────────────────────────────────────────────────────
+bool TranslationCache::lookup(const QString& text, const QString& targetLang, int promptVersion,
+                              QString* translation)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    const QString key = makeKey(text, targetLang, promptVersion);
+    bool hit = false;
+    if (const QString* cached = m_memory.object(key)) {
+        *translation = *cached;
+        ++m_stats.memoryHits;
+        hit = true;
+    } else if (m_file.isOpen()) {
+        const QByteArray keyUtf8 = key.toUtf8();
+        if (lookupDisk(keyUtf8, hashKey(keyUtf8), translation)) {
+            m_memory.insert(key, new QString(*translation));
+            ++m_stats.diskHits;
+            hit = true;
+        }
+    }
+    if (!hit)
+        ++m_stats.misses;
+
+    const qint64 elapsed = timer.nsecsElapsed();
+    m_stats.totalLookupNs += elapsed;
+    m_stats.maxLookupNs    = qMax(m_stats.maxLookupNs, elapsed);
+    return hit;
+}
+
+bool TranslationCache::lookupDisk(const QByteArray& key, quint64 hash, QString* translation)
+{
+    const QList<qint64> offsets = m_diskIndex.values(hash);
+    for (const qint64 offset : offsets) {
+        // 追加写入前会解除映射，这里按需重新映射到当前文件长度
+        if (!m_map || offset + RECORD_HEAD_BYTES > m_mapSize) {
+            if (!mapFile())
+                return false;
+        }
+        const quint32 keyBytes   = readValue<quint32>(m_map + offset);
+        const quint32 valueBytes = readValue<quint32>(m_map + offset + 4);
+        const uchar  *keyData    = m_map + offset + RECORD_HEAD_BYTES;
+        if (keyBytes != quint32(key.size()) || std::memcmp(keyData, key.constData(), keyBytes) != 0)
+            continue;                                   // 哈希碰撞
+        *translation = QString::fromUtf8(reinterpret_cast<const char*>(keyData) + keyBytes,
+                                         qsizetype(valueBytes));
+        return true;
+    }
+    return false;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// insert() — 写入内存层，并追加到磁盘层（已存在或文件已满时跳过）
+// ─────────────────────────────────────────────────────────────────────────────
+void TranslationCache::insert(const QString& text, const QString& targetLang, int promptVersion,
+                              const QString& translation)
+{
+    if (translation.isEmpty())
+        return;
+
+    const QString key = makeKey(text, targetLang, promptVersion);
+    m_memory.insert(key, new QString(translation));
+    ++m_stats.inserts;
+
+    if (!m_file.isOpen())
+        return;
+
+    const QByteArray keyUtf8 = key.toUtf8();
+    const quint64 hash = hashKey(keyUtf8);
+    QString existing;
+    if (lookupDisk(keyUtf8, hash, &existing))
+        return;
+
+    const QByteArray valueUtf8 = translation.toUtf8();
+    QByteArray record;
+    record.reserve(RECORD_HEAD_BYTES + keyUtf8.size() + valueUtf8.size());
+    appendValue<quint32>(record, quint32(keyUtf8.size()));
+    appendValue<quint32>(record, quint32(valueUtf8.size()));
+    appendValue<quint64>(record, hash);
+    record.append(keyUtf8);
+    record.append(valueUtf8);
+    if (m_fileSize + record.size() > MAX_DISK_BYTES)
+        return;
+
+    // 部分平台不允许在映射存在时扩展文件，先解除映射，下次查磁盘时再映射
+    unmapFile();
+    if (!m_file.seek(m_fileSize) || m_file.write(record) != record.size()) {
+        m_file.resize(m_fileSize);                      // 丢弃写了一半的记录
+        return;
+    }
+    m_file.flush();
+    m_diskIndex.insert(hash, m_fileSize);
+    m_fileSize += record.size();
+}
+
+QString TranslationCache::normalize(const QString& text)
+{
+    QString normalized = text.normalized(QString::NormalizationForm_KC).simplified();
+    static const QString trailing = QStringLiteral("。.！!～~ ");
+    while (!normalized.isEmpty() && trailing.contains(normalized.back()))
+        normalized.chop(1);
+    return normalized.toCaseFolded();
+}
+
+QString TranslationCache::makeKey(const QString& text, const QString& targetLang, int promptVersion)
+{
+    // 字段间用单元分隔符（U+001F）隔开，原文里不会出现
+    return QString::number(promptVersion) + QChar(0x1F) + targetLang + QChar(0x1F) + normalize(text);
+}
+
+// FNV-1a 64 位
+quint64 TranslationCache::hashKey(const QByteArray& key)
+{
+    quint64 hash = 14695981039346656037ULL;
+    for (const char c : key) {
+        hash ^= quint8(c);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+QString TranslationCache::statsReport() const
+{
+    const quint64 lookups = m_stats.memoryHits + m_stats.diskHits + m_stats.misses;
+    const double  hitRate = lookups ? 100.0 * (m_stats.memoryHits + m_stats.diskHits) / lookups : 0.0;
+    const double  avgUs   = lookups ? m_stats.totalLookupNs / 1000.0 / lookups : 0.0;
+    return QString("译文缓存: 命中 %1% (内存 %2 / 磁盘 %3 / 未命中 %4)  平均查找 %5us  最长 %6us  磁盘 %7 条 %8KB")
+        .arg(hitRate, 0, 'f', 1)
+        .arg(m_stats.memoryHits).arg(m_stats.diskHits).arg(m_stats.misses)
+        .arg(avgUs, 0, 'f', 1).arg(m_stats.maxLookupNs / 1000.0, 0, 'f', 1)
+        .arg(m_diskIndex.size()).arg(m_fileSize / 1024);
+}
@@ -0,0 +1,78 @@
+#ifndef TRANSLATIONCACHE_H
+#define TRANSLATIONCACHE_H
+
+#include <QCache>
+#include <QFile>
+#include <QMultiHash>
+#include <QString>
+
+// ─────────────────────────────────────────────────────────────────────────────
+// TranslationCache — 译文缓存（内存 LRU + 磁盘内存映射两级）
+//
+// 键为 (规范化后的原文, 目标语言, 提示词版本)。常说的"你好""谢谢""听得到吗"
+// 命中后不再走一次 DeepSeek 往返，查找耗时为微秒级。
+//
+// 内存层：QCache，按条数限定容量，最久未用的先淘汰。
+// 磁盘层：只追加的记录文件，启动时整体 map 进内存并建立 哈希 → 偏移 索引，
+// 查找直接在映射区上比较键、解码值，程序重启后仍然有效。
+// 文件超过 MAX_DISK_BYTES 后不再追加；文件尾部不完整的记录（写入中途退出）在打开时截掉。
+// 只在翻译线程中使用，不加锁。
+// ─────────────────────────────────────────────────────────────────────────────
+class TranslationCache
+{
+public:
+    struct Stats
+    {
+        quint64 memoryHits = 0;
+        quint64 diskHits   = 0;
+        quint64 misses     = 0;
+        quint64 inserts    = 0;
+        qint64  totalLookupNs = 0;
+        qint64  maxLookupNs   = 0;
+    };
+
+    explicit TranslationCache(int memoryCapacity = 256);
+    ~TranslationCache();
+
+    TranslationCache(const TranslationCache&) = delete;
+    TranslationCache& operator=(const TranslationCache&) = delete;
+
+    // 打开（或新建）磁盘缓存文件；失败时返回 false，只使用内存层
+    bool open(const QString& path, QString* errorMessage);
+    void close();
+    bool isOpen() const { return m_file.isOpen(); }
+
+    bool lookup(const QString& text, const QString& targetLang, int promptVersion, QString* translation);
+    void insert(const QString& text, const QString& targetLang, int promptVersion, const QString& translation);
+
+    // 规范化原文：兼容字符统一（NFKC）、空白合并、去掉句末的句号/感叹号、英文小写
+    static QString normalize(const QString& text);
+
+    const Stats& stats() const { return m_stats; }
+    QString statsReport() const;
+
+private:
+    static QString makeKey(const QString& text, const QString& targetLang, int promptVersion);
+    static quint64 hashKey(const QByteArray& key);
+
+    bool lookupDisk(const QByteArray& key, quint64 hash, QString* translation);
+    bool mapFile();
+    void unmapFile();
+    bool loadIndex();
+
+    QCache<QString, QString>   m_memory;
+    QFile                      m_file;
+    uchar                     *m_map     = nullptr;
+    qint64                     m_mapSize = 0;
+    qint64                     m_fileSize = 0;
+    QMultiHash<quint64, qint64> m_diskIndex;   // 键哈希 → 记录偏移
+    Stats                      m_stats;
+
+    static constexpr quint32 FILE_MAGIC   = 0x43544556;   // "VETC"
+    static constexpr quint32 FILE_VERSION = 1;
+    static constexpr qint64  HEADER_BYTES = 16;           // magic, version, 保留 8 字节
+    static constexpr qint64  RECORD_HEAD_BYTES = 16;      // keyBytes, valueBytes, keyHash
+    static constexpr qint64  MAX_DISK_BYTES = 16 * 1024 * 1024;
+};
+
+#endif // TRANSLATIONCACHE_H
@@ -1,182 +1,753 @@
-#include "Translator.h"
-#include "ConfigManager.h"
-
-#include <QNetworkRequest>
-#include <QNetworkReply>
-#include <QJsonDocument>
-#include <QJsonObject>
-#include <QJsonArray>
-#include <QUrl>
-
-namespace {
-const QString API_URL           = "https://api.deepseek.com/v1/chat/completions";
-const int     REQUEST_TIMEOUT_MS = 30000;  // 请求超时时间（毫秒）
-}
-
-// ─────────────────────────────────────────────────────────────────────────────
-// 构造函数
-// ─────────────────────────────────────────────────────────────────────────────
-Translator::Translator(QObject *parent)
-    : QObject(parent)
-    , m_networkManager(new QNetworkAccessManager(this))
-{
-    // 将网络请求完成信号连接到处理槽
-    connect(m_networkManager, &QNetworkAccessManager::finished,
-            this, &Translator::onReplyFinished);
-}
-
-// ─────────────────────────────────────────────────────────────────────────────
-// initialize() — 从 ConfigManager 加载目标语言和 API Key
-// 由主窗口 __start__ 信号触发
-// ─────────────────────────────────────────────────────────────────────────────
-void Translator::initialize()
-{
-    targetLanguage = ConfigManager::getInstance().getTargetLanguage();
-    apiKey         = ConfigManager::getInstance().getDeepseekApiKey();
-    emit debug(QString("Translator initialized, target language: %1").arg(targetLanguage));
-}
-
-// ─────────────────────────────────────────────────────────────────────────────
-// translateTextAsync() — 发起异步翻译请求
-// ─────────────────────────────────────────────────────────────────────────────
-void Translator::translateTextAsync(const QString& text)
-{
-    if (text.isEmpty()) {
-        emit translationError("Translator: text is empty");
-        return;
-    }
-    if (apiKey.isEmpty()) {
-        emit translationError("Translator: DeepSeek API key not configured");
-        return;
-    }
-
-    // 如果上一个请求还没完成，先中止它，避免 m_pendingReply 悬挂。
-    // 例如：用户说话非常快，前一句话的翻译还没返回，下一句已经来了。
-    if (m_pendingReply) {
-        m_pendingReply->abort();   // 触发 finished 信号，onReplyFinished 里会处理
-        m_pendingReply = nullptr;
-    }
-
-    m_originalText = text;          // 保存原文用于后面组合输出
-
-    QNetworkRequest request;
-    request.setUrl(QUrl(API_URL));
-    request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
-    request.setRawHeader("Authorization",
-                         QString("Bearer %1").arg(apiKey).toUtf8());
-
-    const QByteArray body = buildRequestJson(text, targetLanguage).toUtf8();
-
-    // 保存 reply 指针，用于后续识别回调归属
-    m_pendingReply = m_networkManager->post(request, body);
-}
-
-// ─────────────────────────────────────────────────────────────────────────────
-// buildRequestJson() — 构造发往 DeepSeek API 的 JSON 请求体
-// ─────────────────────────────────────────────────────────────────────────────
-QString Translator::buildRequestJson(const QString& text, const QString& targetLang) const
-{
-    // 【修复】原代码在函数内部构建了两套 messages，最终使用的那套
-    // system content 是 QString("...").arg(targetLanguage)，
-    // 其中 "..." 是字面量而非真正的提示词，导致 DeepSeek 收到的系统提示完全无效。
-    // 现在只构建一套，且提示词内容完整。
-
-    // 系统提示：告诉 DeepSeek 它的角色和输出格式
-    const QString systemContent = QString(
-                                      "你是一个专业的翻译助手。"
-                                      "请将用户输入的内容翻译成%1，"
-                                      "只返回翻译结果，不要添加任何解释、标注或额外内容。"
-                                      ).arg(targetLang);
-
-    // 构造 messages 数组
-    QJsonArray messages;
-    messages.append(QJsonObject{
-        {"role",    "system"},
-        {"content", systemContent}
-    });
-    messages.append(QJsonObject{
-        {"role",    "user"},
-        {"content", text}
-    });
-
-    // 构造完整请求体
-    QJsonObject requestObj{
-        {"model",       "deepseek-chat"},
-        {"messages",    messages},         // 使用上面构造的 messages，不重复定义
-        {"temperature", 0.3},              // 较低的温度，翻译结果更稳定
-        {"max_tokens",  2000},
-        {"stream",      false}
-    };
-
-    return QJsonDocument(requestObj).toJson(QJsonDocument::Compact);
-}
-
-// ─────────────────────────────────────────────────────────────────────────────
-// parseTranslationResponse() — 从 API 返回的 JSON 中提取翻译文本
-// ─────────────────────────────────────────────────────────────────────────────
-QString Translator::parseTranslationResponse(const QByteArray& responseData) const
-{
-    const QJsonDocument doc = QJsonDocument::fromJson(responseData);
-    if (doc.isNull()) {
-        return "Error: invalid JSON response";
-    }
-
-    const QJsonObject rootObj = doc.object();
-
-    // 检查 API 层面的错误（如 key 无效、余额不足等）
-    if (rootObj.contains("error")) {
-        const QString errMsg = rootObj["error"].toObject()["message"].toString("unknown error");
-        return QString("API Error: %1").arg(errMsg);
-    }
-
-    // 提取 choices[0].message.content
-    const QJsonArray choices = rootObj["choices"].toArray();
-    if (!choices.isEmpty()) {
-        const QString content = choices.first().toObject()
-        ["message"].toObject()
-            ["content"].toString().trimmed();
-        if (!content.isEmpty()) return content;
-    }
-
-    return "Error: no translation result found";
-}
-
-// ─────────────────────────────────────────────────────────────────────────────
-// onReplyFinished() — 网络请求完成回调
-// ─────────────────────────────────────────────────────────────────────────────
-void Translator::onReplyFinished(QNetworkReply* reply)
-{
-    // 延迟删除 reply 对象（Qt 要求在槽函数里不能直接 delete sender 相关对象）
-    reply->deleteLater();
-
-    if (reply != m_pendingReply) {
-        return;
-    }
-    // 清空 pendingReply，允许下一次请求
-    m_pendingReply = nullptr;
-
-    // 处理网络层错误（连接超时、abort 等）
-    if (reply->error() != QNetworkReply::NoError) {
-        // 用户主动 abort 的请求不需要报错
-        if (reply->error() != QNetworkReply::OperationCanceledError) {
-            emit translationError(QString("Translator: network error: %1")
-                                      .arg(reply->errorString()));
-        }
-        return;
-    }
-
-    // 解析 API 响应
-    const QByteArray responseData  = reply->readAll();
-    const QString    translatedText = parseTranslationResponse(responseData);
-
-    if (translatedText.startsWith("Error:") || translatedText.startsWith("API Error:")) {
-        emit translationError(translatedText);
-    } else {
-        // 组合原文和译文
-        const QString result = m_originalText + "\n" + translatedText;
-
-        emit translationFinished(result);  // 发送组合后的字符串
-
-        emit debug(QString("翻译结果: %1").arg(translatedText)); // debug
-    }
-}
+#include "Translator.h"
+#include "ConfigManager.h"
+
+#include <QNetworkRequest>
+#include <QNetworkReply>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QTimer>
+#include <QUrl>
+#include <QDir>
+#include <QCoreApplication>
+#if QT_CONFIG(ssl)
+#include <QSslConfiguration>
+#endif
+
+namespace {
+const QString API_URL           = "https://api.deepseek.com/v1/chat/completions";
+const int     REQUEST_TIMEOUT_MS = 30000;  // 请求超时时间（毫秒），队首任务超过即放弃
+
+// 分句边界：中英文句读标点，标点留在分句末尾
+bool isClausePunct(QChar c)
+{
+    static const QString punct = QStringLiteral("，。？！、；,.?!;…");
+    return punct.contains(c);
+}
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// 构造函数
+// ─────────────────────────────────────────────────────────────────────────────
+Translator::Translator(QObject *parent)
+    : QObject(parent)
+    , m_networkManager(new QNetworkAccessManager(this))
+{
+    // 将网络请求完成信号连接到处理槽
+    connect(m_networkManager, &QNetworkAccessManager::finished,
+            this, &Translator::onReplyFinished);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// initialize() — 从 ConfigManager 加载目标语言和 API Key
+// 由主窗口 __start__ 信号触发
+// ─────────────────────────────────────────────────────────────────────────────
+void Translator::initialize()
+{
+    targetLanguage = ConfigManager::getInstance().getTargetLanguage();
+    apiKey         = ConfigManager::getInstance().getDeepseekApiKey();
+    m_speculative  = ConfigManager::getInstance().getSpeculativeTranslation();
+    m_streaming    = ConfigManager::getInstance().getStreamTranslation();
+    m_maxInFlight  = qMax(1, ConfigManager::getInstance().getTranslationMaxInFlight());
+    m_cacheEnabled = ConfigManager::getInstance().getTranslationCache();
+
+    // 磁盘缓存与 config.ini 放在同一目录；打不开时只用内存层
+    if (m_cacheEnabled && !m_cache.isOpen()) {
+        const QString cachePath = QDir(QCoreApplication::applicationDirPath())
+                                      .absoluteFilePath("translation_cache.bin");
+        QString cacheError;
+        if (!m_cache.open(cachePath, &cacheError)) {
+            emit debug(QString("译文缓存文件无法打开，仅使用内存缓存: %1").arg(cacheError));
+        }
+    }
+
+    // 定时器在所在线程（initialize 经排队调用执行）中创建
+    if (!m_headTimer) {
+        m_headTimer = new QTimer(this);
+        m_headTimer->setSingleShot(true);
+        connect(m_headTimer, &QTimer::timeout, this, &Translator::onHeadTimeout);
+    }
+    if (!m_keepAliveTimer) {
+        m_keepAliveTimer = new QTimer(this);
+        m_keepAliveTimer->setInterval(KEEPALIVE_INTERVAL_MS);
+        connect(m_keepAliveTimer, &QTimer::timeout, this, &Translator::onKeepAlive);
+    }
+    clearJobs();
+
+    // 目标语言可能已改变，旧的推测结果不再可用
+    m_clauseCache.clear();
+    m_clauseOwners.clear();
+    m_statSpecRequests = m_statSpecWasted = m_statClauses = m_statClauseHits = 0;
+
+    m_keepAliveMs  = qMax(0, ConfigManager::getInstance().getTranslationKeepAliveSec()) * 1000;
+
+    emit debug(QString("Translator initialized, target language: %1%2")
+                   .arg(targetLanguage, m_speculative ? "，推测翻译已开启" : ""));
+
+    // 第一句话之前就完成握手
+    m_lastActivity.start();
+    warmConnection();
+    m_keepAliveTimer->start();
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// onSpeechOnset() — 语音起点，预热翻译连接
+// 一句话从开口到识别出结果至少要几百毫秒，握手在这段时间内完成，不占用翻译延迟
+// ─────────────────────────────────────────────────────────────────────────────
+void Translator::onSpeechOnset()
+{
+    if (!m_keepAliveTimer)
+        return;                             // 尚未 initialize
+    m_lastActivity.restart();
+    warmConnection();
+    if (!m_keepAliveTimer->isActive())
+        m_keepAliveTimer->start();
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// warmConnection() — 预先建立到翻译接口的加密连接
+// 连接已存在时 QNetworkAccessManager 直接复用，不会重复握手
+// ─────────────────────────────────────────────────────────────────────────────
+void Translator::warmConnection()
+{
+    if (apiKey.isEmpty())
+        return;
+
+    const QUrl url(API_URL);
+#if QT_CONFIG(ssl)
+    QSslConfiguration ssl = QSslConfiguration::defaultConfiguration();
+    ssl.setAllowedNextProtocols({ QSslConfiguration::ALPNProtocolHTTP2,
+                                  QSslConfiguration::NextProtocolHttp1_1 });
+    m_networkManager->connectToHostEncrypted(url.host(), quint16(url.port(443)), ssl);
+#else
+    m_networkManager->connectToHost(url.host(), quint16(url.port(80)));
+#endif
+}
+
+// 有界保活：空闲超过 m_keepAliveMs 就停止预热，让连接自然关闭
+void Translator::onKeepAlive()
+{
+    if (m_lastActivity.elapsed() > m_keepAliveMs) {
+        m_keepAliveTimer->stop();
+        return;
+    }
+    warmConnection();
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// translateTextAsync() — 新的一句加入翻译队列
+// 原做法是中止上一句的请求，说话快时前一句永远翻译不出来；
+// 现在每句一个任务，在并发窗口内同时请求，结果仍按说话顺序发出。
+// ─────────────────────────────────────────────────────────────────────────────
+void Translator::translateTextAsync(quint64 sessionId, const QString& text)
+{
+    if (text.isEmpty()) {
+        emit translationError("Translator: text is empty");
+        return;
+    }
+    if (apiKey.isEmpty()) {
+        emit translationError("Translator: DeepSeek API key not configured");
+        return;
+    }
+
+    TranslationJob job;
+    job.seq      = m_nextSeq++;
+    job.original = text;             // 每个任务保存自己的原文，用于后面组合输出
+    job.request  = text;
+    job.timer.start();
+
+    // 缓存命中：不发请求，轮到这一句时立即发出
+    if (m_cacheEnabled && m_cache.lookup(text, targetLanguage, PROMPT_VERSION, &job.result)) {
+        job.fromCache     = true;
+        job.finished      = true;
+        job.remainderDone = true;
+        if (m_speculative)
+            settleSpeculation(sessionId, QStringList());
+        m_jobs.append(job);
+        completeJobs();
+        return;
+    }
+
+    if (m_speculative) {
+        // 开头连续的、已推测（完成或进行中）的分句直接复用，只翻译剩下的部分
+        job.clauses = splitClauses(text);
+        while (job.prefix < job.clauses.size()) {
+            const QString& clause = job.clauses.at(job.prefix);
+            if (!m_clauseCache.contains(clause) && !m_clauseReplies.key(clause))
+                break;
+            ++job.prefix;
+        }
+        job.request = job.clauses.mid(job.prefix).join(QString());
+        settleSpeculation(sessionId, job.clauses.mid(0, job.prefix));
+    }
+    job.remainderDone = job.request.trimmed().isEmpty();
+
+    m_jobs.append(job);
+    startQueuedJobs();
+    completeJobs();
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// onPartialText() — 推测翻译
+// 只看中间结果的稳定前缀（stableLength，由识别分片表判断不会再被动态修正替换的部分），
+// 末尾仍可能被 rpl 改写的分片不推测，免得为马上就会变的文字白发请求。
+// 前缀中以标点结尾的分句视为说完，提前单独翻译并缓存；
+// 最后一个分句若还没有标点，说明还在说，不推测。
+// ─────────────────────────────────────────────────────────────────────────────
+void Translator::onPartialText(quint64 sessionId, const QString& text, int stableLength)
+{
+    if (!m_speculative || stableLength <= 0 || apiKey.isEmpty())
+        return;
+
+    const QStringList clauses = splitClauses(text.left(stableLength));
+    for (const QString& clause : clauses) {
+        if (m_clauseReplies.size() >= MAX_SPECULATIVE_IN_FLIGHT)
+            break;
+        if (!isClausePunct(clause.back()))
+            break;                                  // 未完成的分句
+        if (clause.size() - 1 < MIN_CLAUSE_CHARS)
+            continue;
+        if (m_clauseCache.contains(clause) || m_clauseReplies.key(clause))
+            continue;
+
+        QString cached;
+        if (m_cacheEnabled && m_cache.lookup(clause, targetLanguage, PROMPT_VERSION, &cached)) {
+            m_clauseCache.insert(clause, cached);
+            continue;
+        }
+
+        m_clauseReplies.insert(postTranslation(clause), clause);
+        m_clauseOwners.insert(clause, sessionId);
+        ++m_statSpecRequests;
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// postTranslation() — 发出一个翻译请求
+// ─────────────────────────────────────────────────────────────────────────────
+QNetworkReply* Translator::postTranslation(const QString& text, bool stream)
+{
+    m_lastActivity.restart();
+    if (m_keepAliveTimer && !m_keepAliveTimer->isActive())
+        m_keepAliveTimer->start();
+
+    QNetworkRequest request;
+    request.setUrl(QUrl(API_URL));
+    request.setAttribute(QNetworkRequest::Http2AllowedAttribute, true);   // 与预热连接协商的协议一致
+    request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
+    request.setRawHeader("Authorization",
+                         QString("Bearer %1").arg(apiKey).toUtf8());
+
+    const QByteArray body = buildRequestJson(text, targetLanguage, stream).toUtf8();
+    return m_networkManager->post(request, body);
+}
+
+Translator::TranslationJob* Translator::findJob(QNetworkReply* reply)
+{
+    for (TranslationJob& job : m_jobs) {
+        if (job.reply == reply)
+            return &job;
+    }
+    return nullptr;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// startQueuedJobs() — 按顺序发出排队的任务，同时进行的请求不超过 m_maxInFlight
+// ─────────────────────────────────────────────────────────────────────────────
+void Translator::startQueuedJobs()
+{
+    int inFlight = 0;
+    for (const TranslationJob& job : std::as_const(m_jobs)) {
+        if (job.reply)
+            ++inFlight;
+    }
+    for (TranslationJob& job : m_jobs) {
+        if (inFlight >= m_maxInFlight)
+            break;
+        if (job.finished || job.remainderDone || job.reply)
+            continue;
+        startJob(job);
+        ++inFlight;
+    }
+    armHeadTimeout();
+}
+
+// 流式模式下每收到一批数据就解析，队首任务发出 translationProgress，
+// 聊天框上看到的延迟从"整段生成完"变为"首个片段到达"
+void Translator::startJob(TranslationJob& job)
+{
+    job.translation.clear();
+    job.sseBuffer.clear();
+    job.streamOther.clear();
+    job.firstTokenMs = -1;
+    job.timer.start();
+
+    QNetworkReply* reply = postTranslation(job.request, m_streaming);
+    job.reply = reply;
+    if (m_streaming) {
+        connect(reply, &QNetworkReply::readyRead, this, [this, reply]() {
+            if (TranslationJob* owner = findJob(reply))
+                consumeStream(*owner, false);
+        });
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// consumeStream() — 解析 SSE：每个事件一行 "data: {json}"，以 "data: [DONE]" 结束
+// 只有完整的行才解析，半行留到下一次 readyRead；flush 时连同末尾不完整的行一起处理
+// ─────────────────────────────────────────────────────────────────────────────
+void Translator::consumeStream(TranslationJob& job, bool flush)
+{
+    job.sseBuffer += job.reply->readAll();
+    if (flush && !job.sseBuffer.isEmpty() && !job.sseBuffer.endsWith('\n'))
+        job.sseBuffer += '\n';
+
+    const qsizetype before = job.translation.size();
+    qsizetype start = 0;
+    qsizetype newline;
+    while ((newline = job.sseBuffer.indexOf('\n', start)) >= 0) {
+        const QByteArray line = job.sseBuffer.mid(start, newline - start).trimmed();
+        start = newline + 1;
+
+        if (line.isEmpty() || line.startsWith(':'))
+            continue;                                   // 事件分隔 / keep-alive 注释
+        if (!line.startsWith("data:")) {
+            job.streamOther += line;
+            continue;
+        }
+        const QByteArray payload = line.mid(5).trimmed();
+        if (payload == "[DONE]")
+            continue;
+
+        const QJsonArray choices = QJsonDocument::fromJson(payload).object()["choices"].toArray();
+        if (!choices.isEmpty()) {
+            job.translation += choices.first().toObject()
+            ["delta"].toObject()
+                ["content"].toString();
+        }
+    }
+    job.sseBuffer.remove(0, start);
+
+    if (job.translation.size() != before) {
+        if (job.firstTokenMs < 0)
+            job.firstTokenMs = job.timer.elapsed();
+        if (!flush)
+            emitProgress(job);
+    }
+}
+
+// 只有队首任务发进度（后面的句子还不能显示）；推测复用的分句都已就绪时，
+// 才把"复用部分 + 已生成部分"作为进度发出
+void Translator::emitProgress(const TranslationJob& job)
+{
+    if (&job != &m_jobs.constFirst())
+        return;
+
+    QStringList parts;
+    for (int i = 0; i < job.prefix; ++i) {
+        const auto it = m_clauseCache.constFind(job.clauses.at(i));
+        if (it == m_clauseCache.constEnd())
+            return;
+        parts.append(it.value());
+    }
+    parts.append(job.translation);
+    emit translationProgress(job.original + "\n" + joinTranslations(parts));
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// splitClauses() — 按标点切分，连续的标点归入前一个分句
+// 例："你好，今天天气不错。我们" → ["你好，", "今天天气不错。", "我们"]
+// ─────────────────────────────────────────────────────────────────────────────
+QStringList Translator::splitClauses(const QString& text)
+{
+    QStringList clauses;
+    qsizetype start = 0;
+    for (qsizetype i = 0; i < text.size(); ++i) {
+        const bool endOfRun = isClausePunct(text.at(i))
+                              && (i + 1 == text.size() || !isClausePunct(text.at(i + 1)));
+        if (endOfRun) {
+            clauses.append(text.mid(start, i + 1 - start));
+            start = i + 1;
+        }
+    }
+    if (start < text.size())
+        clauses.append(text.mid(start));
+    return clauses;
+}
+
+void Translator::completeJobs()
+{
+    for (TranslationJob& job : m_jobs)
+        tryCompleteJob(job);
+    deliverInOrder();
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// tryCompleteJob() — 复用的分句和剩余部分都已译好时，拼出译文
+// ─────────────────────────────────────────────────────────────────────────────
+bool Translator::tryCompleteJob(TranslationJob& job)
+{
+    if (job.finished || !job.remainderDone)
+        return false;
+
+    QStringList parts;
+    for (int i = 0; i < job.prefix; ++i) {
+        const auto it = m_clauseCache.constFind(job.clauses.at(i));
+        if (it == m_clauseCache.constEnd())
+            return false;                           // 推测请求还没回来
+        parts.append(it.value());
+    }
+    if (!job.translation.isEmpty())
+        parts.append(job.translation);
+
+    job.result   = joinTranslations(parts);
+    job.finished = true;
+    return true;
+}
+
+void Translator::failJob(TranslationJob& job, const QString& message)
+{
+    if (job.reply) {
+        QNetworkReply* stale = job.reply;
+        job.reply = nullptr;                // 先解除归属，回调里直接忽略
+        stale->abort();
+    }
+    job.finished = true;
+    job.failed   = true;
+    emit translationError(message);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// deliverInOrder() — 从队首起依次发出已完成的任务，遇到未完成的就停下
+// ─────────────────────────────────────────────────────────────────────────────
+void Translator::deliverInOrder()
+{
+    while (!m_jobs.isEmpty() && m_jobs.front().finished) {
+        const TranslationJob job = m_jobs.takeFirst();
+        if (job.failed)
+            continue;                               // 错误已在失败时报告
+
+        emit translationFinished(job.original + "\n" + job.result);
+        emit debug(QString("翻译结果: %1%2").arg(job.result, job.fromCache ? "（缓存）" : "")); // debug
+        if (m_cacheEnabled) {
+            if (!job.fromCache)
+                m_cache.insert(job.original, targetLanguage, PROMPT_VERSION, job.result);
+            emit debug(m_cache.statsReport());
+        }
+        if (m_streaming && job.firstTokenMs >= 0) {
+            emit debug(QString("翻译首个片段 %1ms，完成 %2ms").arg(job.firstTokenMs).arg(job.timer.elapsed()));
+        }
+
+        for (int i = 0; i < job.prefix; ++i) {
+            const QString& clause = job.clauses.at(i);
+            if (!clauseNeeded(clause))
+                m_clauseCache.remove(clause);       // 已用到，不计入浪费
+        }
+        if (m_speculative) {
+            m_statClauses    += job.clauses.size();
+            m_statClauseHits += job.prefix;
+            reportSpeculationStats();
+        }
+    }
+    armHeadTimeout();
+}
+
+// 队首任务从发出（或入队）起超过 REQUEST_TIMEOUT_MS 仍未完成即放弃
+void Translator::armHeadTimeout()
+{
+    if (!m_headTimer)
+        return;
+    if (m_jobs.isEmpty()) {
+        m_headTimer->stop();
+        return;
+    }
+    const qint64 remaining = REQUEST_TIMEOUT_MS - m_jobs.front().timer.elapsed();
+    m_headTimer->start(static_cast<int>(qMax<qint64>(0, remaining)));
+}
+
+void Translator::onHeadTimeout()
+{
+    if (m_jobs.isEmpty())
+        return;
+    TranslationJob& head = m_jobs.front();
+    if (head.timer.elapsed() < REQUEST_TIMEOUT_MS) {
+        armHeadTimeout();                           // 队首已换成新发出的任务
+        return;
+    }
+    failJob(head, QString("Translator: request timed out after %1 ms: %2")
+                      .arg(REQUEST_TIMEOUT_MS).arg(head.original));
+    deliverInOrder();
+    startQueuedJobs();
+}
+
+void Translator::clearJobs()
+{
+    for (TranslationJob& job : m_jobs) {
+        if (job.reply) {
+            QNetworkReply* stale = job.reply;
+            job.reply = nullptr;
+            stale->abort();
+        }
+    }
+    m_jobs.clear();
+    if (m_headTimer)
+        m_headTimer->stop();
+}
+
+QString Translator::joinTranslations(const QStringList& parts) const
+{
+    // 日语不以空格分词，其余目标语言分句之间补一个空格
+    const QString separator = targetLanguage == "日语" ? QString() : QStringLiteral(" ");
+    QString result;
+    for (const QString& part : parts) {
+        const QString trimmed = part.trimmed();
+        if (trimmed.isEmpty())
+            continue;
+        if (!result.isEmpty())
+            result += separator;
+        result += trimmed;
+    }
+    return result;
+}
+
+bool Translator::clauseNeeded(const QString& clause) const
+{
+    for (const TranslationJob& job : m_jobs) {
+        if (!job.finished && job.clauses.mid(0, job.prefix).contains(clause))
+            return true;
+    }
+    return false;
+}
+
+void Translator::evictClauseCache()
+{
+    for (auto it = m_clauseCache.begin(); it != m_clauseCache.end(); ) {
+        if (clauseNeeded(it.key())) {
+            ++it;
+        } else {
+            if (m_clauseOwners.remove(it.key()))
+                ++m_statSpecWasted;                 // 所属会话还没有最终原文就被清出
+            it = m_clauseCache.erase(it);
+        }
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// settleSpeculation() — 结算推测请求
+// 识别结果按会话顺序到达，会话 sessionId 的最终原文到达时，它及之前的会话
+// （包括被取消、没有最终原文的会话）都不会再有新的稳定前缀：
+// 这些会话推测的分句要么进入了本句的复用前缀，要么再也不会被用到。
+// 后面仍在说的会话发起的推测不在此结算。
+// ─────────────────────────────────────────────────────────────────────────────
+void Translator::settleSpeculation(quint64 sessionId, const QStringList& used)
+{
+    for (auto it = m_clauseOwners.begin(); it != m_clauseOwners.end(); ) {
+        const QString clause = it.key();
+        if (it.value() == USED_IN_FLIGHT || it.value() > sessionId) {
+            ++it;
+            continue;
+        }
+        if (used.contains(clause)) {
+            if (m_clauseReplies.key(clause)) {
+                it.value() = USED_IN_FLIGHT;        // 等回复：失败时仍算浪费
+                ++it;
+            } else {
+                it = m_clauseOwners.erase(it);
+            }
+            continue;
+        }
+
+        ++m_statSpecWasted;
+        it = m_clauseOwners.erase(it);
+        if (!clauseNeeded(clause))
+            m_clauseCache.remove(clause);
+    }
+}
+
+void Translator::reportSpeculationStats()
+{
+    const double hitRate   = m_statClauses ? 100.0 * m_statClauseHits / m_statClauses : 0.0;
+    const double wasteRate = m_statSpecRequests ? 100.0 * m_statSpecWasted / m_statSpecRequests : 0.0;
+    emit debug(QString("推测翻译: 分句命中 %1/%2 (%3%)  推测请求 %4  浪费 %5 (%6%)")
+                   .arg(m_statClauseHits).arg(m_statClauses).arg(hitRate, 0, 'f', 1)
+                   .arg(m_statSpecRequests).arg(m_statSpecWasted).arg(wasteRate, 0, 'f', 1));
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// buildRequestJson() — 构造发往 DeepSeek API 的 JSON 请求体
+// ─────────────────────────────────────────────────────────────────────────────
+QString Translator::buildRequestJson(const QString& text, const QString& targetLang, bool stream) const
+{
+    // 【修复】原代码在函数内部构建了两套 messages，最终使用的那套
+    // system content 是 QString("...").arg(targetLanguage)，
+    // 其中 "..." 是字面量而非真正的提示词，导致 DeepSeek 收到的系统提示完全无效。
+    // 现在只构建一套，且提示词内容完整。
+
+    // 系统提示：告诉 DeepSeek 它的角色和输出格式
+    const QString systemContent = QString(
+                                      "你是一个专业的翻译助手。"
+                                      "请将用户输入的内容翻译成%1，"
+                                      "只返回翻译结果，不要添加任何解释、标注或额外内容。"
+                                      ).arg(targetLang);
+
+    // 构造 messages 数组
+    QJsonArray messages;
+    messages.append(QJsonObject{
+        {"role",    "system"},
+        {"content", systemContent}
+    });
+    messages.append(QJsonObject{
+        {"role",    "user"},
+        {"content", text}
+    });
+
+    // 构造完整请求体
+    QJsonObject requestObj{
+        {"model",       "deepseek-chat"},
+        {"messages",    messages},         // 使用上面构造的 messages，不重复定义
+        {"temperature", 0.3},              // 较低的温度，翻译结果更稳定
+        {"max_tokens",  2000},
+        {"stream",      stream}            // true 时以 server-sent events 逐段返回
+    };
+
+    return QJsonDocument(requestObj).toJson(QJsonDocument::Compact);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// parseTranslationResponse() — 从 API 返回的 JSON 中提取翻译文本
+// ─────────────────────────────────────────────────────────────────────────────
+QString Translator::parseTranslationResponse(const QByteArray& responseData) const
+{
+    const QJsonDocument doc = QJsonDocument::fromJson(responseData);
+    if (doc.isNull()) {
+        return "Error: invalid JSON response";
+    }
+
+    const QJsonObject rootObj = doc.object();
+
+    // 检查 API 层面的错误（如 key 无效、余额不足等）
+    if (rootObj.contains("error")) {
+        const QString errMsg = rootObj["error"].toObject()["message"].toString("unknown error");
+        return QString("API Error: %1").arg(errMsg);
+    }
+
+    // 提取 choices[0].message.content
+    const QJsonArray choices = rootObj["choices"].toArray();
+    if (!choices.isEmpty()) {
+        const QString content = choices.first().toObject()
+        ["message"].toObject()
+            ["content"].toString().trimmed();
+        if (!content.isEmpty()) return content;
+    }
+
+    return "Error: no translation result found";
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// onReplyFinished() — 网络请求完成回调
+// ─────────────────────────────────────────────────────────────────────────────
+void Translator::onReplyFinished(QNetworkReply* reply)
+{
+    // 延迟删除 reply 对象（Qt 要求在槽函数里不能直接 delete sender 相关对象）
+    reply->deleteLater();
+
+    const auto speculative = m_clauseReplies.constFind(reply);
+    if (speculative != m_clauseReplies.constEnd()) {
+        const QString clause = speculative.value();
+        m_clauseReplies.erase(speculative);
+        onSpeculativeReply(reply, clause);
+        return;
+    }
+
+    // 已超时放弃或已清空的任务，直接忽略
+    TranslationJob* job = findJob(reply);
+    if (!job) {
+        return;
+    }
+
+    // 处理网络层错误（连接超时、abort 等）
+    if (reply->error() != QNetworkReply::NoError) {
+        job->reply = nullptr;
+        job->finished = true;
+        job->failed   = true;
+        // 用户主动 abort 的请求不需要报错
+        if (reply->error() != QNetworkReply::OperationCanceledError) {
+            emit translationError(QString("Translator: network error: %1")
+                                      .arg(reply->errorString()));
+        }
+    } else {
+        // 解析 API 响应
+        QString translatedText;
+        if (m_streaming) {
+            consumeStream(*job, true);
+            translatedText = job->translation.trimmed();
+            if (translatedText.isEmpty()) {
+                translatedText = job->streamOther.isEmpty() ? QString("Error: no translation result found")
+                                                            : parseTranslationResponse(job->streamOther);
+            }
+        } else {
+            translatedText = parseTranslationResponse(reply->readAll());
+        }
+        job->reply = nullptr;
+
+        if (translatedText.startsWith("Error:") || translatedText.startsWith("API Error:")) {
+            failJob(*job, translatedText);
+        } else {
+            // 与复用的推测分句组合后按顺序发出
+            job->translation   = translatedText;
+            job->remainderDone = true;
+        }
+    }
+
+    completeJobs();
+    startQueuedJobs();
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// onSpeculativeReply() — 推测请求完成
+// 成功则写入缓存；若有任务正等着这个分句，失败时该任务退回整句重译
+// ─────────────────────────────────────────────────────────────────────────────
+void Translator::onSpeculativeReply(QNetworkReply* reply, const QString& clause)
+{
+    QString translatedText;
+    if (reply->error() == QNetworkReply::NoError) {
+        translatedText = parseTranslationResponse(reply->readAll());
+        if (translatedText.startsWith("Error:") || translatedText.startsWith("API Error:"))
+            translatedText.clear();
+    }
+
+    if (!translatedText.isEmpty()) {
+        if (m_clauseCache.size() >= MAX_CACHED_CLAUSES)
+            evictClauseCache();
+        m_clauseCache.insert(clause, translatedText);
+        if (m_cacheEnabled)
+            m_cache.insert(clause, targetLanguage, PROMPT_VERSION, translatedText);
+        const auto owner = m_clauseOwners.constFind(clause);
+        if (owner != m_clauseOwners.constEnd() && owner.value() == USED_IN_FLIGHT)
+            m_clauseOwners.erase(owner);            // 已被复用，结算完毕
+        completeJobs();
+        return;
+    }
+
+    if (m_clauseOwners.remove(clause))
+        ++m_statSpecWasted;                         // 已按未复用结算过的不重复计
+    bool fallback = false;
+    for (TranslationJob& job : m_jobs) {
+        if (job.finished || !job.clauses.mid(0, job.prefix).contains(clause))
+            continue;
+
+        emit debug(QString("推测翻译失败，整句重译: %1").arg(clause));
+        if (job.reply) {
+            QNetworkReply* stale = job.reply;
+            job.reply = nullptr;            // 先解除归属，回调里直接忽略
+            stale->abort();
+        }
+        job.prefix        = 0;
+        job.request       = job.original;
+        job.translation.clear();
+        job.remainderDone = false;
+        fallback = true;
+    }
+    if (fallback)
+        startQueuedJobs();
+}
@@ -1,56 +1,163 @@
-#ifndef TRANSLATOR_H
-#define TRANSLATOR_H
-
-#include <QObject>
-#include <QString>
-#include <QNetworkAccessManager>
-#include <QNetworkReply>
-
-class Translator : public QObject
-{
-    Q_OBJECT
-
-public:
-    explicit Translator(QObject *parent = nullptr);
-
-public slots:
-    // 初始化：从 ConfigManager 加载目标语言和 API Key
-    void initialize();
-
-    // 发起异步翻译请求（由 SpeechRecogniser::recognitionCompleted 触发）
-    void translateTextAsync(const QString& text);
-
-signals:
-    // 翻译完成，发出翻译结果（由 SoloOscBroadcaster::sendToOSC 接收）
-    void translationFinished(const QString& translatedText);
-
-    // 翻译出错
-    void translationError(const QString& errorMessage);
-
-    void debug(const QString& debugMessage);
-
-private slots:
-    // QNetworkAccessManager::finished 信号的回调
-    void onReplyFinished(QNetworkReply* reply);
-
-private:
-    // 构造 DeepSeek API 请求 JSON 体
-    QString buildRequestJson(const QString& text, const QString& targetLang) const;
-
-    // 从 API 响应 JSON 中提取翻译文本
-    QString parseTranslationResponse(const QByteArray& responseData) const;
-
-    QNetworkAccessManager* m_networkManager = nullptr;
-
-    // 用指针追踪当前进行中的请求，替代原来的 bool m_asyncMode。
-    // 原 m_asyncMode 在多个并发请求时会导致后续结果被丢弃。
-    // 现在通过比对 reply 指针判断回调归属，旧的（已 abort）请求直接忽略。
-    QNetworkReply* m_pendingReply = nullptr;
-
-    QString m_originalText;  // 保存原文，用于和译文组合输出
-
-    QString targetLanguage;  // 目标翻译语言（如 "英语"、"日语"）
-    QString apiKey;          // DeepSeek API Key
-};
-
-#endif // TRANSLATOR_H
+#ifndef TRANSLATOR_H
+#define TRANSLATOR_H
+
+#include <QObject>
+#include <QString>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QHash>
+#include <QStringList>
+#include <QElapsedTimer>
+#include <QList>
+#include "translationcache.h"
+
+class QTimer;
+
+class Translator : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit Translator(QObject *parent = nullptr);
+
+public slots:
+    // 初始化：从 ConfigManager 加载目标语言和 API Key
+    void initialize();
+
+    // 发起异步翻译请求（由 SpeechRecogniser::recognitionCompleted 触发）
+    // sessionId 为识别会话编号，用于结算该会话及之前会话发出的推测请求
+    void translateTextAsync(quint64 sessionId, const QString& text);
+
+    // 推测翻译：说话过程中先翻译中间结果稳定前缀里已说完的分句（由 recognitionPartial 触发）
+    void onPartialText(quint64 sessionId, const QString& text, int stableLength);
+
+    // 语音起点：趁用户还在说话时预热到翻译接口的 HTTPS 连接（由 AudioCapture::speechOnset 触发）
+    void onSpeechOnset();
+
+signals:
+    // 翻译完成，发出翻译结果（由 ChatboxScheduler::submitFinal 分页后发往聊天框）
+    void translationFinished(const QString& translatedText);
+
+    // 流式翻译进行中：原文 + 目前已生成的译文（由 ChatboxScheduler::submitProgress 合并、限速后转发）
+    void translationProgress(const QString& partialText);
+
+    // 翻译出错
+    void translationError(const QString& errorMessage);
+
+    void debug(const QString& debugMessage);
+
+private slots:
+    // QNetworkAccessManager::finished 信号的回调
+    void onReplyFinished(QNetworkReply* reply);
+
+private:
+    // ─── 翻译任务 ────────────────────────────────────────────────────────────
+    // 每句原文一个任务，按到达顺序排队；最多 m_maxInFlight 个同时请求，
+    // 结果按顺序发出，先完成的后句等前句
+    struct TranslationJob
+    {
+        quint64        seq = 0;
+        QString        original;            // 原文，与译文组合输出
+        QStringList    clauses;             // 推测模式下的分句
+        int            prefix = 0;          // 开头复用推测结果的分句数
+        QString        request;             // 需要请求翻译的部分（推测未覆盖的剩余）
+        QNetworkReply* reply = nullptr;     // 进行中的请求；未发出或已结束时为空
+        bool           remainderDone = false;
+        QString        translation;         // request 的译文（流式时逐步增长）
+        QByteArray     sseBuffer;           // 尚未凑成完整一行的 SSE 数据
+        QByteArray     streamOther;         // 非 data: 行（出错时服务端可能直接返回 JSON）
+        QElapsedTimer  timer;               // 发出（或入队）时刻，用于队首超时和首字延迟
+        qint64         firstTokenMs = -1;   // 首个译文片段到达耗时
+        bool           finished = false;    // 译文已拼好或已失败，等待按序发出
+        bool           failed = false;
+        bool           fromCache = false;   // 译文来自缓存，无需再写回
+        QString        result;              // 拼好的译文
+    };
+
+    // 构造 DeepSeek API 请求 JSON 体
+    QString buildRequestJson(const QString& text, const QString& targetLang, bool stream = false) const;
+
+    // 从 API 响应 JSON 中提取翻译文本
+    QString parseTranslationResponse(const QByteArray& responseData) const;
+
+    QNetworkReply* postTranslation(const QString& text, bool stream = false);
+    TranslationJob* findJob(QNetworkReply* reply);
+    // 在并发窗口内按顺序发出排队的任务
+    void startQueuedJobs();
+    void startJob(TranslationJob& job);
+    // 推测分句与剩余译文都齐备的任务拼出结果，再按顺序发出
+    void completeJobs();
+    bool tryCompleteJob(TranslationJob& job);
+    void failJob(TranslationJob& job, const QString& message);
+    void deliverInOrder();
+    void armHeadTimeout();
+    void onHeadTimeout();
+    void clearJobs();
+
+    // 预先完成 TCP + TLS 握手（ALPN 协商 HTTP/2），后续 post() 直接复用该连接
+    void warmConnection();
+    void onKeepAlive();
+
+    // 解析已收到的 SSE 事件，把 delta.content 追加到 job.translation
+    void consumeStream(TranslationJob& job, bool flush);
+    void emitProgress(const TranslationJob& job);
+    void onSpeculativeReply(QNetworkReply* reply, const QString& clause);
+
+    // ─── 推测翻译 ────────────────────────────────────────────────────────────
+    // 按句读标点切分，标点保留在分句末尾
+    static QStringList splitClauses(const QString& text);
+    QString joinTranslations(const QStringList& parts) const;
+    // 未完成任务仍要复用的分句
+    bool clauseNeeded(const QString& clause) const;
+    // 推测缓存满时清掉未完成任务用不到的条目，尚未结算的计入浪费
+    void evictClauseCache();
+    // 会话 sessionId 的最终原文已分好句：它及之前会话推测的分句，
+    // 没有进入本句复用前缀的计为浪费
+    void settleSpeculation(quint64 sessionId, const QStringList& used);
+    void reportSpeculationStats();
+
+    QNetworkAccessManager* m_networkManager = nullptr;
+
+    QList<TranslationJob> m_jobs;           // 按顺序排列的未发出任务
+    quint64 m_nextSeq     = 1;
+    int     m_maxInFlight = 2;              // 配置 translationMaxInFlight
+    QTimer* m_headTimer   = nullptr;        // 队首任务超时，避免一句卡住后面所有句子
+
+    bool m_streaming = true;                // 配置 streamTranslation
+
+    // ─── 连接预热 ────────────────────────────────────────────────────────────
+    // 空闲期间每 KEEPALIVE_INTERVAL_MS 重新预热一次，服务端关掉的连接会被重新建立；
+    // 距上次真正的翻译请求超过 m_keepAliveMs 后停止，不无限占用连接
+    QTimer*       m_keepAliveTimer = nullptr;
+    QElapsedTimer m_lastActivity;           // 上次发出翻译请求或语音起点的时刻
+    int           m_keepAliveMs = 180000;   // 配置 translationKeepAliveSec
+
+    static constexpr int KEEPALIVE_INTERVAL_MS = 25000;
+
+    // 译文缓存：键中包含提示词版本，修改 buildRequestJson 的提示词时须递增 PROMPT_VERSION
+    TranslationCache m_cache;
+    bool             m_cacheEnabled = true; // 配置 translationCache
+    static constexpr int PROMPT_VERSION = 1;
+
+    bool m_speculative = false;                     // 配置 speculativeTranslation
+    QHash<QString, QString>        m_clauseCache;   // 分句 → 推测译文
+    QHash<QNetworkReply*, QString> m_clauseReplies; // 进行中的推测请求 → 分句
+    QHash<QString, quint64>        m_clauseOwners;  // 尚未结算的推测请求：分句 → 发起它的识别会话
+    static constexpr quint64 USED_IN_FLIGHT = 0;    // 已被复用但回复未到：失败时仍计入浪费
+
+    // 推测统计：命中率 = 最终分句中复用推测结果的比例，
+    // 浪费率 = 失败、或所属会话的最终原文没有复用的推测请求比例
+    quint64 m_statSpecRequests = 0;
+    quint64 m_statSpecWasted   = 0;
+    quint64 m_statClauses    = 0;
+    quint64 m_statClauseHits = 0;
+
+    static constexpr int MAX_CACHED_CLAUSES = 64;
+    static constexpr int MAX_SPECULATIVE_IN_FLIGHT = 4;
+    static constexpr int MIN_CLAUSE_CHARS   = 2;   // 过短的分句（语气词）不单独推测
+
+    QString targetLanguage;  // 目标翻译语言（如 "英语"、"日语"）
+    QString apiKey;          // DeepSeek API Key
+};
+
+#endif // TRANSLATOR_H
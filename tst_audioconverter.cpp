@@ -0,0 +1,202 @@
+#include <QtTest>
+#include "audioconverter.h"
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+// ─────────────────────────────────────────────────────────────────────────────
+// AudioConverter 单元测试：常见设备格式（44.1k / 48k 立体声）转 16kHz 单声道
+// 检查输出长度、声道混合、通带增益与频率、阻带抑制，以及分块处理与整块处理一致
+// ─────────────────────────────────────────────────────────────────────────────
+class TestAudioConverter : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void outputLengthMatchesRate();
+    void stereoIsAveragedToMono();
+    void passbandToneKeepsGainAndFrequency();
+    void stopbandToneIsRejected();
+    void blockSizeDoesNotChangeOutput();
+    void int16InputMatchesFloatInput();
+
+private:
+    // 生成 seconds 秒交错 float 立体声，left/right 为各声道的 (时间 → 样本) 函数
+    template <typename Left, typename Right>
+    static std::vector<float> stereo(int rate, double seconds, Left left, Right right);
+    // 以 blockFrames 帧一块转换全部输入
+    static std::vector<int16_t> convert(const std::vector<float> &interleaved, int rate,
+                                        AudioConverter::Quality quality, int blockFrames);
+    static double rms(const int16_t *x, size_t n);
+    static int    zeroCrossings(const int16_t *x, size_t n);
+};
+
+namespace {
+constexpr double PI       = 3.14159265358979323846;
+constexpr int    OUT_RATE = 16000;
+constexpr int    SETTLE   = 400;    // 跳过滤波器起始的暂态（25ms）
+const int        RATES[]  = { 44100, 48000 };
+}
+
+template <typename Left, typename Right>
+std::vector<float> TestAudioConverter::stereo(int rate, double seconds, Left left, Right right)
+{
+    const int frames = int(rate * seconds);
+    std::vector<float> out(static_cast<size_t>(frames) * 2);
+    for (int i = 0; i < frames; ++i) {
+        const double t = double(i) / rate;
+        out[2 * i]     = float(left(t));
+        out[2 * i + 1] = float(right(t));
+    }
+    return out;
+}
+
+std::vector<int16_t> TestAudioConverter::convert(const std::vector<float> &interleaved, int rate,
+                                                 AudioConverter::Quality quality, int blockFrames)
+{
+    AudioConverter conv;
+    conv.configure({ rate, 2, AudioConverter::SampleFormat::Float }, OUT_RATE, quality, blockFrames);
+
+    const char *bytes = reinterpret_cast<const char*>(interleaved.data());
+    const int   total = int(interleaved.size() * sizeof(float));
+    const int   step  = blockFrames * conv.bytesPerFrame();
+
+    std::vector<int16_t> out;
+    std::vector<int16_t> block(static_cast<size_t>(conv.maxOutputSamples(blockFrames)));
+    for (int pos = 0; pos < total; pos += step) {
+        const int n = conv.process(bytes + pos, std::min(step, total - pos), block.data());
+        out.insert(out.end(), block.begin(), block.begin() + n);
+    }
+    return out;
+}
+
+double TestAudioConverter::rms(const int16_t *x, size_t n)
+{
+    double sum = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        sum += double(x[i]) * x[i];
+    }
+    return n ? std::sqrt(sum / n) : 0.0;
+}
+
+int TestAudioConverter::zeroCrossings(const int16_t *x, size_t n)
+{
+    int count = 0;
+    for (size_t i = 1; i < n; ++i) {
+        count += ((x[i] < 0) != (x[i - 1] < 0));
+    }
+    return count;
+}
+
+// 1 秒输入正好产生 16000 个输出样本（10ms 一块，块边界不丢不重）
+void TestAudioConverter::outputLengthMatchesRate()
+{
+    for (int rate : RATES) {
+        const std::vector<float> input = stereo(rate, 1.0, [](double) { return 0.0; },
+                                                           [](double) { return 0.0; });
+        QCOMPARE(convert(input, rate, AudioConverter::Quality::Medium, rate / 100).size(), size_t(OUT_RATE));
+    }
+}
+
+// 两声道取平均：同相信号保持幅度，反相信号抵消
+void TestAudioConverter::stereoIsAveragedToMono()
+{
+    for (int rate : RATES) {
+        auto tone = [](double t) { return 0.5 * std::sin(2 * PI * 440.0 * t); };
+        auto inverted = [&](double t) { return -tone(t); };
+        auto silent = [](double) { return 0.0; };
+
+        const std::vector<int16_t> same = convert(stereo(rate, 0.5, tone, tone), rate,
+                                                  AudioConverter::Quality::Medium, rate / 100);
+        const std::vector<int16_t> opposite = convert(stereo(rate, 0.5, tone, inverted), rate,
+                                                      AudioConverter::Quality::Medium, rate / 100);
+        const std::vector<int16_t> oneSide = convert(stereo(rate, 0.5, tone, silent), rate,
+                                                     AudioConverter::Quality::Medium, rate / 100);
+
+        const size_t n = same.size() - SETTLE;
+        const double full = rms(same.data() + SETTLE, n);
+        QVERIFY(std::fabs(full - 0.5 * 32768 / std::sqrt(2.0)) < 0.02 * full);
+        QVERIFY(rms(opposite.data() + SETTLE, n) < 2.0);
+        QVERIFY(std::fabs(rms(oneSide.data() + SETTLE, n) - full / 2) < 0.02 * full);
+    }
+}
+
+// 1kHz 单音：各质量预设的通带增益在 ±0.5dB 内，频率不变
+void TestAudioConverter::passbandToneKeepsGainAndFrequency()
+{
+    const AudioConverter::Quality qualities[] = { AudioConverter::Quality::Low,
+                                                  AudioConverter::Quality::Medium,
+                                                  AudioConverter::Quality::High };
+    for (int rate : RATES) {
+        auto tone = [](double t) { return 0.5 * std::sin(2 * PI * 1000.0 * t); };
+        const std::vector<float> input = stereo(rate, 1.0, tone, tone);
+        for (AudioConverter::Quality q : qualities) {
+            const std::vector<int16_t> out = convert(input, rate, q, rate / 100);
+            const size_t n = out.size() - SETTLE;
+            const double gainDb = 20 * std::log10(rms(out.data() + SETTLE, n) / (0.5 * 32768 / std::sqrt(2.0)));
+            QVERIFY2(std::fabs(gainDb) < 0.5, AudioConverter::qualityName(q));
+
+            // 1kHz 每秒 2000 次过零
+            const double crossingsPerSec = zeroCrossings(out.data() + SETTLE, n) * double(OUT_RATE) / n;
+            QVERIFY2(std::fabs(crossingsPerSec - 2000.0) < 10.0, AudioConverter::qualityName(q));
+        }
+    }
+}
+
+// 高于 8kHz 的成分必须被滤除，不能混叠回语音频段
+void TestAudioConverter::stopbandToneIsRejected()
+{
+    for (int rate : RATES) {
+        auto tone = [](double t) { return 0.5 * std::sin(2 * PI * 12000.0 * t); };
+        const std::vector<int16_t> out = convert(stereo(rate, 0.5, tone, tone), rate,
+                                                 AudioConverter::Quality::Low, rate / 100);
+        const size_t n = out.size() - SETTLE;
+        const double levelDb = 20 * std::log10(std::max(rms(out.data() + SETTLE, n), 1e-3)
+                                               / (0.5 * 32768 / std::sqrt(2.0)));
+        QVERIFY(levelDb < -40.0);
+    }
+}
+
+// 滤波器历史跨块延续：不同块长的输出逐样本一致
+void TestAudioConverter::blockSizeDoesNotChangeOutput()
+{
+    for (int rate : RATES) {
+        auto left  = [](double t) { return 0.3 * std::sin(2 * PI * 300.0 * t) + 0.1 * std::sin(2 * PI * 3100.0 * t); };
+        auto right = [](double t) { return 0.2 * std::sin(2 * PI * 700.0 * t); };
+        const std::vector<float> input = stereo(rate, 0.3, left, right);
+
+        const std::vector<int16_t> whole = convert(input, rate, AudioConverter::Quality::Medium,
+                                                   int(input.size() / 2));
+        for (int block : { 1, 7, 441, rate / 100 }) {
+            QVERIFY(convert(input, rate, AudioConverter::Quality::Medium, block) == whole);
+        }
+    }
+}
+
+// int16 与 float 输入表示同一信号时输出一致（整数格式的解码路径）
+void TestAudioConverter::int16InputMatchesFloatInput()
+{
+    for (int rate : RATES) {
+        auto tone = [](double t) { return std::round(16000.0 * std::sin(2 * PI * 500.0 * t)) / 32768.0; };
+        const std::vector<float> floats = stereo(rate, 0.2, tone, tone);
+        std::vector<int16_t> ints(floats.size());
+        for (size_t i = 0; i < floats.size(); ++i) {
+            ints[i] = int16_t(std::lround(floats[i] * 32768.0));
+        }
+
+        const int frames = int(floats.size() / 2);
+        AudioConverter conv;
+        conv.configure({ rate, 2, AudioConverter::SampleFormat::Int16 }, OUT_RATE,
+                       AudioConverter::Quality::Medium, frames);
+        std::vector<int16_t> out(static_cast<size_t>(conv.maxOutputSamples(frames)));
+        const int n = conv.process(reinterpret_cast<const char*>(ints.data()),
+                                   int(ints.size() * sizeof(int16_t)), out.data());
+        out.resize(static_cast<size_t>(n));
+
+        QVERIFY(out == convert(floats, rate, AudioConverter::Quality::Medium, frames));
+    }
+}
+
+QTEST_APPLESS_MAIN(TestAudioConverter)
+
+#include "tst_audioconverter.moc"
@@ -0,0 +1,181 @@
+#include <QtTest>
+#include "audiohandoffqueue.h"
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+// ─────────────────────────────────────────────────────────────────────────────
+// AudioHandoffQueue 单元测试：顺序、控制事件预留槽位，以及批量唤醒的不变式——
+// 生产者按 push → armWake()、消费者按 clearWake() → pop 直到空 的约定使用时，
+// 任何已入队的事件都不会在没有后续唤醒的情况下滞留在队列里
+// ─────────────────────────────────────────────────────────────────────────────
+class TestAudioHandoffQueue : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void popsInPushOrder();
+    void controlEventsUseReservedSlots();
+    void armWakeOnlyOncePerDrain();
+    void eventPushedDuringDrainRearms();
+    void noEventStrandedWithoutWakeup();
+};
+
+// 事件按入队顺序取出，utterance 原样带过线程边界
+void TestAudioHandoffQueue::popsInPushOrder()
+{
+    AudioHandoffQueue queue(16);
+    for (int round = 0; round < 5; ++round) {   // 多轮绕过环形缓冲区末尾
+        for (uint64_t i = 0; i < 10; ++i) {
+            QVERIFY(queue.push(AudioEvent::Type::Chunk, AudioFrameRef(), round * 100 + i));
+        }
+        QCOMPARE(queue.size(), 10);
+        AudioEvent event;
+        for (uint64_t i = 0; i < 10; ++i) {
+            QVERIFY(queue.pop(&event));
+            QCOMPARE(event.utterance, uint64_t(round * 100 + i));
+        }
+        QVERIFY(!queue.pop(&event));
+    }
+    QCOMPARE(queue.highWaterMark(), 10);
+}
+
+// 音频帧在剩余 4 个槽位时开始被丢弃并计数，开始/结束事件仍能入队
+void TestAudioHandoffQueue::controlEventsUseReservedSlots()
+{
+    AudioHandoffQueue queue(16);
+    QVERIFY(queue.push(AudioEvent::Type::Start));
+    int accepted = 0;
+    while (queue.push(AudioEvent::Type::Chunk)) {
+        ++accepted;
+    }
+    QCOMPARE(accepted, 16 - 4 - 1);
+    QCOMPARE(queue.overruns(), uint64_t(1));
+
+    QVERIFY(queue.push(AudioEvent::Type::Stop));
+    QVERIFY(queue.push(AudioEvent::Type::Cancel));
+    QVERIFY(queue.push(AudioEvent::Type::Start));
+    QVERIFY(queue.push(AudioEvent::Type::Stop));
+    QCOMPARE(queue.size(), 16);
+    QVERIFY(!queue.push(AudioEvent::Type::Stop));   // 真正满了才拒绝控制事件
+
+    AudioEvent event;
+    QVERIFY(queue.pop(&event));
+    QVERIFY(event.type == AudioEvent::Type::Start);
+}
+
+// 唤醒在途时 armWake() 返回 false，消费者 clearWake() 后恢复
+void TestAudioHandoffQueue::armWakeOnlyOncePerDrain()
+{
+    AudioHandoffQueue queue(16);
+    QVERIFY(queue.push(AudioEvent::Type::Chunk));
+    QVERIFY(queue.armWake());
+    for (int i = 0; i < 5; ++i) {
+        QVERIFY(queue.push(AudioEvent::Type::Chunk));
+        QVERIFY(!queue.armWake());
+    }
+    QCOMPARE(queue.wakeups(), uint64_t(1));
+
+    queue.clearWake();
+    AudioEvent event;
+    int drained = 0;
+    while (queue.pop(&event)) {
+        ++drained;
+    }
+    QCOMPARE(drained, 6);
+
+    QVERIFY(queue.push(AudioEvent::Type::Chunk));
+    QVERIFY(queue.armWake());
+    QCOMPARE(queue.wakeups(), uint64_t(2));
+}
+
+// 消费者清除标志后、取空之前入队的事件：要么被本轮取走，要么重新触发唤醒
+void TestAudioHandoffQueue::eventPushedDuringDrainRearms()
+{
+    AudioHandoffQueue queue(16);
+    QVERIFY(queue.push(AudioEvent::Type::Chunk, AudioFrameRef(), 1));
+    QVERIFY(queue.armWake());
+
+    queue.clearWake();
+    AudioEvent event;
+    QVERIFY(queue.pop(&event));
+    QVERIFY(!queue.pop(&event));
+
+    // 消费者已经看到队列为空，此时到达的事件必须拿到新的唤醒
+    QVERIFY(queue.push(AudioEvent::Type::Chunk, AudioFrameRef(), 2));
+    QVERIFY(queue.armWake());
+}
+
+// 双线程压力：生产者只在 armWake() 返回 true 时投递唤醒，消费者每次唤醒
+// 先 clearWake() 再取空；生产者结束且唤醒全部处理完后，队列必须为空、
+// 全部事件按序到达，且唤醒次数不超过事件数
+void TestAudioHandoffQueue::noEventStrandedWithoutWakeup()
+{
+    constexpr int EVENTS = 200000;
+
+    for (int trial = 0; trial < 4; ++trial) {
+        AudioHandoffQueue queue(64);
+
+        std::mutex              mutex;
+        std::condition_variable cv;
+        int                     pendingWakes = 0;
+        bool                    producerDone = false;
+
+        uint64_t expected = 0;
+        bool     ordered  = true;
+
+        std::thread consumer([&] {
+            for (;;) {
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    cv.wait(lock, [&] { return pendingWakes > 0 || producerDone; });
+                    if (pendingWakes == 0) {
+                        return;   // 生产者已结束且没有在途唤醒
+                    }
+                    --pendingWakes;
+                }
+                queue.clearWake();
+                AudioEvent event;
+                while (queue.pop(&event)) {
+                    ordered = ordered && event.utterance == expected;
+                    ++expected;
+                }
+            }
+        });
+
+        // 队列满时等消费者取走，不丢事件；事件滞留会让队列一直满，超时即判失败
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        bool stalled = false;
+        for (uint64_t i = 0; i < uint64_t(EVENTS) && !stalled; ++i) {
+            while (!queue.push(AudioEvent::Type::Chunk, AudioFrameRef(), i)) {
+                if (std::chrono::steady_clock::now() > deadline) {
+                    stalled = true;
+                    break;
+                }
+                std::this_thread::yield();
+            }
+            if (queue.armWake()) {
+                std::lock_guard<std::mutex> lock(mutex);
+                ++pendingWakes;
+                cv.notify_one();
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            producerDone = true;
+            cv.notify_one();
+        }
+        consumer.join();
+
+        QVERIFY2(!stalled, "queue stayed full: events were stranded without a wakeup");
+        QCOMPARE(queue.size(), 0);
+        QCOMPARE(expected, uint64_t(EVENTS));
+        QVERIFY(ordered);
+        QVERIFY(queue.wakeups() <= uint64_t(EVENTS));
+    }
+}
+
+QTEST_APPLESS_MAIN(TestAudioHandoffQueue)
+
+#include "tst_audiohandoffqueue.moc"
@@ -0,0 +1,184 @@
+#include <QtTest>
+#include "dspkernels.h"
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Dsp 内核单元测试：当前 CPU 支持的每组向量化内核与标量实现对照
+// 长度覆盖 0、奇数、向量宽度前后（尾部处理），起始地址逐个元素错开（非对齐读写）
+// ─────────────────────────────────────────────────────────────────────────────
+class TestDspKernels : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void integerKernelsMatchScalar();
+    void conversionsMatchScalar();
+    void floatReductionsMatchScalar();
+    void base64MatchesScalar();
+    void base64KnownVectors();
+
+private:
+    static std::vector<int>     lengths();
+    static std::vector<int16_t> randomPcm(int n, uint32_t seed);
+};
+
+namespace {
+constexpr int MAX_OFFSET = 4;   // 起始地址错开 0~3 个元素
+}
+
+std::vector<int> TestDspKernels::lengths()
+{
+    std::vector<int> out;
+    for (int n = 0; n <= 70; ++n) {
+        out.push_back(n);
+    }
+    for (int n : { 127, 128, 129, 639, 640, 641, 1001 }) {
+        out.push_back(n);
+    }
+    return out;
+}
+
+// 随机样本，并混入极值和零，覆盖饱和与符号边界
+std::vector<int16_t> TestDspKernels::randomPcm(int n, uint32_t seed)
+{
+    std::vector<int16_t> pcm(static_cast<size_t>(n));
+    for (int i = 0; i < n; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        pcm[i] = static_cast<int16_t>(seed >> 16);
+        switch (seed % 29) {
+        case 0: pcm[i] = -32768; break;
+        case 1: pcm[i] = 32767;  break;
+        case 2: pcm[i] = 0;      break;
+        default: break;
+        }
+    }
+    return pcm;
+}
+
+void TestDspKernels::integerKernelsMatchScalar()
+{
+    const Dsp::Kernels &ref = Dsp::scalarKernels();
+    for (const Dsp::Kernels *ks : Dsp::availableKernels()) {
+        for (int n : lengths()) {
+            const std::vector<int16_t> pcm = randomPcm(n + MAX_OFFSET, uint32_t(n) + 1);
+            for (int offset = 0; offset < MAX_OFFSET; ++offset) {
+                const int16_t *x = pcm.data() + offset;
+                const std::string where = std::string(ks->name) + " n=" + std::to_string(n)
+                                          + " offset=" + std::to_string(offset);
+                QVERIFY2(ks->sumSquares(x, n) == ref.sumSquares(x, n), where.c_str());
+                QVERIFY2(ks->zeroCrossings(x, n) == ref.zeroCrossings(x, n), where.c_str());
+                QVERIFY2(ks->peakAbs(x, n) == ref.peakAbs(x, n), where.c_str());
+            }
+        }
+    }
+}
+
+// int16 ↔ float 转换逐位一致
+void TestDspKernels::conversionsMatchScalar()
+{
+    const Dsp::Kernels &ref = Dsp::scalarKernels();
+    for (const Dsp::Kernels *ks : Dsp::availableKernels()) {
+        for (int n : lengths()) {
+            const std::vector<int16_t> pcm = randomPcm(n + MAX_OFFSET, uint32_t(n) + 7);
+            for (int offset = 0; offset < MAX_OFFSET; ++offset) {
+                const std::string where = std::string(ks->name) + " n=" + std::to_string(n)
+                                          + " offset=" + std::to_string(offset);
+                std::vector<float> expected(n + MAX_OFFSET), actual(n + MAX_OFFSET);
+                ref.int16ToFloat(pcm.data() + offset, expected.data() + offset, n);
+                ks->int16ToFloat(pcm.data() + offset, actual.data() + offset, n);
+                QVERIFY2(std::memcmp(expected.data(), actual.data(), expected.size() * sizeof(float)) == 0,
+                         where.c_str());
+
+                // 超出 [-1, 1) 的值必须饱和，半整数处的舍入必须一致
+                std::vector<float> in(n + MAX_OFFSET);
+                for (int i = 0; i < n + MAX_OFFSET; ++i) {
+                    in[i] = (i % 5 == 0) ? (i % 2 ? 1.5f : -1.5f)
+                                         : (float(pcm[i]) + 0.5f) / 32768.0f;
+                }
+                std::vector<int16_t> expectedPcm(n + MAX_OFFSET), actualPcm(n + MAX_OFFSET);
+                ref.floatToInt16(in.data() + offset, expectedPcm.data() + offset, n);
+                ks->floatToInt16(in.data() + offset, actualPcm.data() + offset, n);
+                QVERIFY2(expectedPcm == actualPcm, where.c_str());
+            }
+        }
+    }
+}
+
+// 浮点累加的顺序不同，只要求在舍入误差范围内一致
+void TestDspKernels::floatReductionsMatchScalar()
+{
+    const Dsp::Kernels &ref = Dsp::scalarKernels();
+    for (const Dsp::Kernels *ks : Dsp::availableKernels()) {
+        for (int n : lengths()) {
+            const std::vector<int16_t> pcm = randomPcm(n + MAX_OFFSET, uint32_t(n) + 13);
+            std::vector<float> a(n + MAX_OFFSET), b(n + MAX_OFFSET);
+            ref.int16ToFloat(pcm.data(), a.data(), n + MAX_OFFSET);
+            for (int i = 0; i < n + MAX_OFFSET; ++i) {
+                b[i] = a[n + MAX_OFFSET - 1 - i] + 0.25f;   // 带直流分量
+            }
+            for (int offset = 0; offset < MAX_OFFSET; ++offset) {
+                const std::string where = std::string(ks->name) + " n=" + std::to_string(n)
+                                          + " offset=" + std::to_string(offset);
+                const float tolerance = 1e-5f * float(n + 1);
+
+                const float dotRef = ref.dot(a.data() + offset, b.data() + offset, n);
+                const float dotVec = ks->dot(a.data() + offset, b.data() + offset, n);
+                QVERIFY2(std::fabs(dotRef - dotVec) <= tolerance, where.c_str());
+
+                std::vector<float> expected(b.begin() + offset, b.begin() + offset + n);
+                std::vector<float> actual = expected;
+                const float meanRef = ref.removeDc(expected.data(), n);
+                const float meanVec = ks->removeDc(actual.data(), n);
+                QVERIFY2(std::fabs(meanRef - meanVec) <= 1e-5f, where.c_str());
+                for (int i = 0; i < n; ++i) {
+                    QVERIFY2(std::fabs(expected[i] - actual[i]) <= 1e-5f, where.c_str());
+                }
+            }
+        }
+    }
+}
+
+void TestDspKernels::base64MatchesScalar()
+{
+    const Dsp::Kernels &ref = Dsp::scalarKernels();
+    std::vector<int16_t> pcm = randomPcm(800, 99);
+    const uint8_t *bytes = reinterpret_cast<const uint8_t*>(pcm.data());
+
+    for (const Dsp::Kernels *ks : Dsp::availableKernels()) {
+        for (size_t n = 0; n <= 1280; n += (n < 200 ? 1 : 37)) {
+            for (size_t offset = 0; offset < MAX_OFFSET; ++offset) {
+                const std::string where = std::string(ks->name) + " n=" + std::to_string(n)
+                                          + " offset=" + std::to_string(offset);
+                std::string expected(Dsp::base64Length(n), '\0');
+                std::string actual(Dsp::base64Length(n), '\0');
+                QVERIFY2(ref.base64Encode(bytes + offset, n, expected.data()) == expected.size(), where.c_str());
+                QVERIFY2(ks->base64Encode(bytes + offset, n, actual.data()) == actual.size(), where.c_str());
+                QVERIFY2(expected == actual, where.c_str());
+            }
+        }
+    }
+}
+
+// RFC 4648 测试向量
+void TestDspKernels::base64KnownVectors()
+{
+    const char *cases[][2] = {
+        { "", "" }, { "f", "Zg==" }, { "fo", "Zm8=" }, { "foo", "Zm9v" },
+        { "foob", "Zm9vYg==" }, { "fooba", "Zm9vYmE=" }, { "foobar", "Zm9vYmFy" },
+    };
+    for (const Dsp::Kernels *ks : Dsp::availableKernels()) {
+        for (const auto &c : cases) {
+            const size_t n = std::strlen(c[0]);
+            std::string out(Dsp::base64Length(n), '\0');
+            ks->base64Encode(reinterpret_cast<const uint8_t*>(c[0]), n, out.data());
+            QVERIFY2(out == c[1], ks->name);
+        }
+    }
+}
+
+QTEST_APPLESS_MAIN(TestDspKernels)
+
+#include "tst_dspkernels.moc"
@@ -0,0 +1,254 @@
+#include <QtTest>
+#include "endpointer.h"
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Endpointer 单元测试：逐帧喂入语音 / 静音序列，检查断句时的静音帧数与判定依据。
+// 配置与默认 minSilenceDuration=800ms 相同：默认 20 帧，下限 7 帧，上限 40 帧
+// ─────────────────────────────────────────────────────────────────────────────
+class TestEndpointer : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+
+    void fixedTimeoutIgnoresAdaptation();
+    void shortReplyEndsSooner();
+    void longUtteranceKeepsDefault();
+    void punctuationScalesTimeout();
+    void punctuationRespectsBounds();
+    void energyTrendScalesTimeout();
+    void pauseStatisticsReplaceDefault();
+    void quickRestartCountsAsSplit();
+    void rejectedUtteranceIsNotASplit();
+    void resetClearsSpeakerStatistics();
+
+private:
+    // 喂入 frames 帧语音，期间不应断句
+    static bool speak(Endpointer *ep, int frames, float rms = SPEECH_RMS);
+    // 喂入 segments 段各 10 帧的语音，段间停顿 pauseFrames 帧，期间不应断句
+    static bool speakWithPauses(Endpointer *ep, int segments, int pauseFrames);
+    // 喂入静音直到断句，返回断句时的静音帧数；limit 帧内未断句返回 -1
+    static int silenceUntilEndpoint(Endpointer *ep, int limit = 100);
+    // 一整句：语音 + 静音至断句，并以 accepted 结束
+    static int utterance(Endpointer *ep, int gapFrames, int voicedFrames,
+                         Endpointer::Punctuation punctuation = Endpointer::Punctuation::None);
+
+    Endpointer m_ep;
+
+    static constexpr int   DEFAULT_FRAMES = 20;
+    static constexpr int   MIN_FRAMES     = 7;
+    static constexpr int   MAX_FRAMES     = 40;
+    static constexpr float SPEECH_RMS     = 0.1f;
+    static constexpr float SILENCE_RMS    = 0.005f;
+};
+
+bool TestEndpointer::speak(Endpointer *ep, int frames, float rms)
+{
+    for (int i = 0; i < frames; ++i) {
+        if (ep->update(true, rms)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool TestEndpointer::speakWithPauses(Endpointer *ep, int segments, int pauseFrames)
+{
+    for (int segment = 0; segment < segments; ++segment) {
+        for (int i = 0; segment > 0 && i < pauseFrames; ++i) {
+            if (ep->update(false, SILENCE_RMS)) {
+                return false;
+            }
+        }
+        if (!speak(ep, 10)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int TestEndpointer::silenceUntilEndpoint(Endpointer *ep, int limit)
+{
+    for (int i = 0; i < limit; ++i) {
+        if (ep->update(false, SILENCE_RMS)) {
+            return ep->silenceFrames();
+        }
+    }
+    return -1;
+}
+
+int TestEndpointer::utterance(Endpointer *ep, int gapFrames, int voicedFrames,
+                              Endpointer::Punctuation punctuation)
+{
+    ep->beginUtterance(gapFrames);
+    if (!speak(ep, voicedFrames)) {
+        return -1;
+    }
+    ep->setPunctuation(punctuation);
+    const int silence = silenceUntilEndpoint(ep);
+    ep->endUtterance(true);
+    return silence;
+}
+
+void TestEndpointer::init()
+{
+    m_ep.configure(DEFAULT_FRAMES, MIN_FRAMES, MAX_FRAMES, true);
+    m_ep.reset();
+}
+
+// 关闭自适应：无论句长和标点，都是固定的 minSilenceDuration
+void TestEndpointer::fixedTimeoutIgnoresAdaptation()
+{
+    m_ep.configure(DEFAULT_FRAMES, MIN_FRAMES, MAX_FRAMES, false);
+    QCOMPARE(utterance(&m_ep, -1, 8), DEFAULT_FRAMES);
+    QCOMPARE(utterance(&m_ep, 100, 40, Endpointer::Punctuation::Final), DEFAULT_FRAMES);
+    QCOMPARE(utterance(&m_ep, 100, 40, Endpointer::Punctuation::Pause), DEFAULT_FRAMES);
+}
+
+// 只有一段、不足 800ms 的简短回答：默认 × 0.75
+void TestEndpointer::shortReplyEndsSooner()
+{
+    QCOMPARE(utterance(&m_ep, -1, 8), 15);
+    QCOMPARE(m_ep.decision().baseFrames, DEFAULT_FRAMES);
+    QCOMPARE(m_ep.decision().shortFactor, 0.75f);
+    QCOMPARE(m_ep.decision().timeoutFrames, 15);
+    QCOMPARE(m_ep.utterances(), uint64_t(1));
+}
+
+void TestEndpointer::longUtteranceKeepsDefault()
+{
+    QCOMPARE(utterance(&m_ep, -1, 40), DEFAULT_FRAMES);
+    QCOMPARE(m_ep.decision().shortFactor, 1.0f);
+    QCOMPARE(m_ep.decision().energyFactor, 1.0f);
+    QCOMPARE(m_ep.decision().rateFactor, 1.0f);
+
+    // 第二句语速与该说话人平均相同，系数不变
+    QCOMPARE(utterance(&m_ep, 100, 40), DEFAULT_FRAMES);
+    QCOMPARE(m_ep.decision().rateFactor, 1.0f);
+}
+
+// 句末标点减半，逗号类延长 1.25 倍；静音中途到达的标点立即生效
+void TestEndpointer::punctuationScalesTimeout()
+{
+    QCOMPARE(utterance(&m_ep, -1, 40, Endpointer::Punctuation::Final), 10);
+    QCOMPARE(m_ep.decision().punctuationFactor, 0.5f);
+    QCOMPARE(utterance(&m_ep, 100, 40, Endpointer::Punctuation::Pause), 25);
+    QCOMPARE(m_ep.decision().punctuationFactor, 1.25f);
+
+    // 已静音 12 帧时才收到句末标点：超过新的 10 帧超时，下一帧即断句
+    m_ep.beginUtterance(100);
+    QVERIFY(speak(&m_ep, 40));
+    for (int i = 0; i < 12; ++i) {
+        QVERIFY(!m_ep.update(false, SILENCE_RMS));
+    }
+    m_ep.setPunctuation(Endpointer::Punctuation::Final);
+    QVERIFY(m_ep.update(false, SILENCE_RMS));
+    QCOMPARE(m_ep.silenceFrames(), 13);
+}
+
+// 系数叠加后的超时限制在 [minFrames, maxFrames]
+void TestEndpointer::punctuationRespectsBounds()
+{
+    m_ep.configure(DEFAULT_FRAMES, 12, 22, true);
+    QCOMPARE(utterance(&m_ep, -1, 40, Endpointer::Punctuation::Final), 12);
+    QCOMPARE(utterance(&m_ep, 100, 40, Endpointer::Punctuation::Pause), 22);
+}
+
+// 句尾能量明显回落（收尾）× 0.8，戛然而止 × 1.15
+void TestEndpointer::energyTrendScalesTimeout()
+{
+    m_ep.beginUtterance(-1);
+    QVERIFY(speak(&m_ep, 30, 0.2f));
+    QVERIFY(speak(&m_ep, 10, 0.02f));
+    QCOMPARE(silenceUntilEndpoint(&m_ep), 16);
+    QCOMPARE(m_ep.decision().energyFactor, 0.8f);
+    m_ep.endUtterance(true);
+
+    m_ep.beginUtterance(100);
+    QVERIFY(speak(&m_ep, 30, 0.05f));
+    QVERIFY(speak(&m_ep, 10, 0.2f));
+    QCOMPARE(silenceUntilEndpoint(&m_ep), 23);
+    QCOMPARE(m_ep.decision().energyFactor, 1.15f);
+    m_ep.endUtterance(true);
+}
+
+// 句中停顿攒够 8 个样本后，基准改为停顿 90 分位 × 1.3 + 2 帧：
+// 每次停顿 5 帧的说话人 → round(6.5) + 2 = 9 帧，比默认的 20 帧短
+void TestEndpointer::pauseStatisticsReplaceDefault()
+{
+    m_ep.beginUtterance(-1);
+    QVERIFY(speakWithPauses(&m_ep, 8, 5));
+    QCOMPARE(m_ep.pauseSamples(), 7);
+    QCOMPARE(silenceUntilEndpoint(&m_ep), DEFAULT_FRAMES);   // 样本不足，仍用默认超时
+    m_ep.endUtterance(true);
+
+    m_ep.beginUtterance(100);
+    QVERIFY(speakWithPauses(&m_ep, 8, 5));
+    QCOMPARE(m_ep.pauseSamples(), 14);
+    QCOMPARE(silenceUntilEndpoint(&m_ep), 9);
+    QCOMPARE(m_ep.decision().baseFrames, 9);
+    QCOMPARE(m_ep.decision().rateFactor, 1.0f);
+    m_ep.endUtterance(true);
+
+    // 停顿较长的说话人得到比默认更长的超时：round(15 × 1.3) + 2 = 22
+    // （先说 20 帧，避免第一次停顿时被当作短句按 15 帧断开）
+    init();
+    m_ep.beginUtterance(-1);
+    QVERIFY(speak(&m_ep, 20));
+    QVERIFY(speakWithPauses(&m_ep, 9, 15));
+    QCOMPARE(silenceUntilEndpoint(&m_ep), 22);
+    m_ep.endUtterance(true);
+}
+
+// 断句后 8 帧内又开口：记为疑似误断，把这段停顿计入统计
+void TestEndpointer::quickRestartCountsAsSplit()
+{
+    QCOMPARE(utterance(&m_ep, -1, 40), DEFAULT_FRAMES);
+    m_ep.beginUtterance(3);
+    QCOMPARE(m_ep.suspectedSplits(), uint64_t(1));
+    QCOMPARE(m_ep.pauseSamples(), 1);
+    m_ep.endUtterance(false);
+
+    QCOMPARE(utterance(&m_ep, 100, 40), DEFAULT_FRAMES);
+    m_ep.beginUtterance(8);
+    QCOMPARE(m_ep.suspectedSplits(), uint64_t(1));
+    QCOMPARE(m_ep.pauseSamples(), 1);
+}
+
+// 误触发 / 强制结束的句子不是因静音断开，紧接着开口也不算误断
+void TestEndpointer::rejectedUtteranceIsNotASplit()
+{
+    m_ep.beginUtterance(-1);
+    QVERIFY(speak(&m_ep, 40));
+    QCOMPARE(silenceUntilEndpoint(&m_ep), DEFAULT_FRAMES);
+    m_ep.endUtterance(false);
+    QCOMPARE(m_ep.utterances(), uint64_t(0));
+
+    m_ep.beginUtterance(2);
+    QCOMPARE(m_ep.suspectedSplits(), uint64_t(0));
+    QCOMPARE(m_ep.pauseSamples(), 0);
+}
+
+void TestEndpointer::resetClearsSpeakerStatistics()
+{
+    QCOMPARE(utterance(&m_ep, -1, 40), DEFAULT_FRAMES);
+    for (int i = 0; i < 8; ++i) {
+        m_ep.beginUtterance(2);
+        QVERIFY(speak(&m_ep, 40));
+        QVERIFY(silenceUntilEndpoint(&m_ep) > 0);
+        m_ep.endUtterance(true);
+    }
+    QCOMPARE(m_ep.suspectedSplits(), uint64_t(8));
+    QVERIFY(m_ep.decision().baseFrames != DEFAULT_FRAMES);
+
+    m_ep.reset();
+    QCOMPARE(m_ep.pauseSamples(), 0);
+    QCOMPARE(m_ep.suspectedSplits(), uint64_t(0));
+    QCOMPARE(m_ep.utterances(), uint64_t(0));
+    QCOMPARE(utterance(&m_ep, -1, 40), DEFAULT_FRAMES);
+}
+
+QTEST_APPLESS_MAIN(TestEndpointer)
+
+#include "tst_endpointer.moc"
@@ -0,0 +1,144 @@
+#include <QtTest>
+#include <QtEndian>
+#include "oscpacketbuilder.h"
+
+// ─────────────────────────────────────────────────────────────────────────────
+// OscPacketBuilder 单元测试：聊天框消息与原 append 路径逐字节一致（覆盖各种补齐
+// 长度和多字节 UTF-8），复用缓冲区不残留上一条的内容，以及 bundle 的元素布局
+// ─────────────────────────────────────────────────────────────────────────────
+class TestOscPacketBuilder : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void matchesLegacyChatbox_data();
+    void matchesLegacyChatbox();
+    void reuseLeavesNoStaleBytes();
+    void encodesNumericArguments();
+    void bundleElementsAreLengthPrefixed();
+
+private:
+    static QByteArray legacyChatbox(const QString &text);
+};
+
+// 原实现（SoloOscBroadcaster::sendToOSC）
+QByteArray TestOscPacketBuilder::legacyChatbox(const QString &text)
+{
+    QByteArray oscData;
+    oscData.append(QString("/chatbox/input").toUtf8());
+    oscData.append('\0');
+    while (oscData.size() % 4 != 0) oscData.append('\0');
+    oscData.append(",sTT");
+    oscData.append('\0');
+    while (oscData.size() % 4 != 0) oscData.append('\0');
+    oscData.append(text.toUtf8());
+    oscData.append('\0');
+    while (oscData.size() % 4 != 0) oscData.append('\0');
+    return oscData;
+}
+
+void TestOscPacketBuilder::matchesLegacyChatbox_data()
+{
+    QTest::addColumn<QString>("text");
+
+    QTest::newRow("empty")   << QString();
+    QTest::newRow("len 1")   << QString("a");
+    QTest::newRow("len 2")   << QString("ab");
+    QTest::newRow("len 3")   << QString("abc");
+    QTest::newRow("len 4")   << QString("abcd");
+    QTest::newRow("cjk")     << QString("你好");                       // 6 字节
+    QTest::newRow("mixed")   << QString("Hi，世界!");
+    QTest::newRow("emoji")   << QString("ok 👍");                      // 代理对 → 4 字节
+    QTest::newRow("newline") << QString("第一行\nsecond line");
+    QTest::newRow("chatbox") << QString("今天天气不错，我们去公园散步吧。\nThe weather is nice today, let's go for a walk. ")
+                                    .repeated(3).left(144);
+}
+
+void TestOscPacketBuilder::matchesLegacyChatbox()
+{
+    QFETCH(QString, text);
+
+    OscPacketBuilder builder;
+    builder.beginMessage(OscPacketBuilder::messagePrefix("/chatbox/input", ",sTT"));
+    builder.addString(text);
+    QCOMPARE(builder.data(), legacyChatbox(text));
+    QCOMPARE(builder.data().size() % 4, 0);
+}
+
+// 长消息之后编码短消息：缓冲区只截短不清零，结果仍必须与单独编码一致
+void TestOscPacketBuilder::reuseLeavesNoStaleBytes()
+{
+    const QByteArray prefix = OscPacketBuilder::messagePrefix("/chatbox/input", ",sTT");
+    const QString    longText = QString("很长的一段文字").repeated(20);
+
+    OscPacketBuilder builder(16);   // 小初始容量，第一条就要扩展
+    builder.beginMessage(prefix);
+    builder.addString(longText);
+    QCOMPARE(builder.data(), legacyChatbox(longText));
+
+    for (const QString &text : { QString("短"), QString(), QString("abc") }) {
+        builder.beginMessage(prefix);
+        builder.addString(text);
+        QCOMPARE(builder.data(), legacyChatbox(text));
+    }
+}
+
+// int32 / float32 大端写入，blob 带长度并补齐
+void TestOscPacketBuilder::encodesNumericArguments()
+{
+    OscPacketBuilder builder;
+    builder.beginMessage(OscPacketBuilder::messagePrefix("/p", ",ifb"));
+    builder.addInt(-2);
+    builder.addFloat(1.0f);
+    builder.addBlob("\xAA\xBB\xCC", 3);
+
+    QByteArray expected("/p\0\0,ifb\0\0\0\0", 12);
+    expected.append("\xFF\xFF\xFF\xFE", 4);
+    expected.append("\x3F\x80\x00\x00", 4);
+    expected.append("\x00\x00\x00\x03\xAA\xBB\xCC\x00", 8);
+    QCOMPARE(builder.data(), expected);
+}
+
+// bundle："#bundle\0" + 时间标签，每个元素 = 大端长度 + 与单独编码相同的消息
+void TestOscPacketBuilder::bundleElementsAreLengthPrefixed()
+{
+    const QByteArray chatPrefix   = OscPacketBuilder::messagePrefix("/chatbox/input", ",sTT");
+    const QByteArray typingPrefix = OscPacketBuilder::messagePrefix("/chatbox/typing", ",F");
+    const QByteArray paramPrefix  = OscPacketBuilder::messagePrefix("/avatar/parameters/Talking", ",i");
+    const QString    text("你好，world");
+
+    OscPacketBuilder single;
+    QList<QByteArray> elements;
+    single.beginMessage(chatPrefix);
+    single.addString(text);
+    elements << single.data();
+    single.beginMessage(typingPrefix);
+    elements << single.data();
+    single.beginMessage(paramPrefix);
+    single.addInt(1);
+    elements << single.data();
+
+    OscPacketBuilder bundle;
+    bundle.clear();
+    bundle.beginBundle(0x0102030405060708ULL);
+    bundle.beginMessage(chatPrefix);
+    bundle.addString(text);
+    bundle.endMessage();
+    bundle.beginMessage(typingPrefix);
+    bundle.endMessage();
+    bundle.beginMessage(paramPrefix);
+    bundle.addInt(1);
+    bundle.endMessage();
+
+    QByteArray expected("#bundle\0\x01\x02\x03\x04\x05\x06\x07\x08", 16);
+    for (const QByteArray &element : elements) {
+        QByteArray length(4, '\0');
+        qToBigEndian<qint32>(qint32(element.size()), length.data());
+        expected.append(length).append(element);
+    }
+    QCOMPARE(bundle.data(), expected);
+}
+
+QTEST_APPLESS_MAIN(TestOscPacketBuilder)
+
+#include "tst_oscpacketbuilder.moc"
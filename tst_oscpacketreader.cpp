@@ -0,0 +1,129 @@
+#include <QtTest>
+#include <QtEndian>
+#include "oscpacketreader.h"
+#include "oscpacketbuilder.h"
+
+// ─────────────────────────────────────────────────────────────────────────────
+// OscPacketReader 单元测试：用 OscPacketBuilder 编码再解码（往返），
+// 以及截断、错位、越界长度等畸形报文必须被拒绝
+// ─────────────────────────────────────────────────────────────────────────────
+class TestOscPacketReader : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void decodesBoolParameter();
+    void decodesMixedArguments();
+    void decodesBundle();
+    void decodesNestedBundle();
+    void rejectsMalformed_data();
+    void rejectsMalformed();
+
+private:
+    static QByteArray mixedMessage();
+    static QByteArray twoMessageBundle();
+};
+
+QByteArray TestOscPacketReader::mixedMessage()
+{
+    const QByteArray blob("\x01\x02\x03\x04\x05", 5);
+    OscPacketBuilder builder;
+    builder.beginMessage(OscPacketBuilder::messagePrefix("/test", ",ifsbF"));
+    builder.addInt(-7);
+    builder.addFloat(0.5f);
+    builder.addString(QString("你好 OSC"));
+    builder.addBlob(blob.constData(), int(blob.size()));
+    return builder.data();
+}
+
+QByteArray TestOscPacketReader::twoMessageBundle()
+{
+    OscPacketBuilder builder;
+    builder.beginBundle();
+    builder.beginMessage(OscPacketBuilder::messagePrefix("/avatar/parameters/Voice", ",f"));
+    builder.addFloat(0.25f);
+    builder.endMessage();
+    builder.beginMessage(OscPacketBuilder::messagePrefix("/avatar/parameters/MuteSelf", ",F"));
+    builder.endMessage();
+    return builder.data();
+}
+
+// VRChat 输出的布尔参数
+void TestOscPacketReader::decodesBoolParameter()
+{
+    OscPacketBuilder builder;
+    builder.beginMessage(OscPacketBuilder::messagePrefix("/avatar/parameters/MuteSelf", ",T"));
+
+    QList<OscMessage> messages;
+    QVERIFY(OscPacketReader::decode(builder.data(), &messages));
+    QCOMPARE(messages.size(), 1);
+    QCOMPARE(messages[0].address, QByteArray("/avatar/parameters/MuteSelf"));
+    QCOMPARE(messages[0].arguments, QVariantList{ true });
+}
+
+void TestOscPacketReader::decodesMixedArguments()
+{
+    const QByteArray blob("\x01\x02\x03\x04\x05", 5);
+
+    QList<OscMessage> messages;
+    QVERIFY(OscPacketReader::decode(mixedMessage(), &messages));
+    QCOMPARE(messages.size(), 1);
+    QCOMPARE(messages[0].address, QByteArray("/test"));
+    QCOMPARE(messages[0].arguments,
+             (QVariantList{ -7, 0.5f, QString("你好 OSC"), blob, false }));
+}
+
+void TestOscPacketReader::decodesBundle()
+{
+    QList<OscMessage> messages;
+    QVERIFY(OscPacketReader::decode(twoMessageBundle(), &messages));
+    QCOMPARE(messages.size(), 2);
+    QCOMPARE(messages[0].address, QByteArray("/avatar/parameters/Voice"));
+    QCOMPARE(messages[0].arguments, QVariantList{ 0.25f });
+    QCOMPARE(messages[1].address, QByteArray("/avatar/parameters/MuteSelf"));
+    QCOMPARE(messages[1].arguments, QVariantList{ false });
+}
+
+// bundle 元素本身也可以是 bundle
+void TestOscPacketReader::decodesNestedBundle()
+{
+    const QByteArray inner = twoMessageBundle();
+    QByteArray outer("#bundle\0", 8);
+    outer.append(QByteArray(8, '\0'));
+    QByteArray length(4, '\0');
+    qToBigEndian<qint32>(qint32(inner.size()), length.data());
+    outer.append(length).append(inner);
+
+    QList<OscMessage> messages;
+    QVERIFY(OscPacketReader::decode(outer, &messages));
+    QCOMPARE(messages.size(), 2);
+    QCOMPARE(messages[1].arguments, QVariantList{ false });
+}
+
+void TestOscPacketReader::rejectsMalformed_data()
+{
+    QTest::addColumn<QByteArray>("packet");
+
+    const QByteArray mixed = mixedMessage();
+    QByteArray badBundle = twoMessageBundle();
+    qToBigEndian<qint32>(0x7fffffff, badBundle.data() + 16);
+
+    QTest::newRow("empty")         << QByteArray();
+    QTest::newRow("truncated")     << mixed.left(mixed.size() - 4);
+    QTest::newRow("unaligned")     << mixed + QByteArray(1, '\0');
+    QTest::newRow("no terminator") << QByteArray("/abc");
+    QTest::newRow("bundle length") << badBundle;
+    QTest::newRow("unknown type")  << OscPacketBuilder::messagePrefix("/x", ",z");
+    QTest::newRow("not osc")       << QByteArray("abcd");
+}
+
+void TestOscPacketReader::rejectsMalformed()
+{
+    QFETCH(QByteArray, packet);
+    QList<OscMessage> messages;
+    QVERIFY(!OscPacketReader::decode(packet, &messages));
+}
+
+QTEST_APPLESS_MAIN(TestOscPacketReader)
+
+#include "tst_oscpacketreader.moc"
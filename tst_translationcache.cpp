@@ -0,0 +1,264 @@
+#include <QtTest>
+#include <QFileInfo>
+#include <QTemporaryDir>
+#include "translationcache.h"
+
+// ─────────────────────────────────────────────────────────────────────────────
+// TranslationCache 单元测试：磁盘层重新打开后仍能命中、尾部不完整记录的恢复、
+// 文件头损坏时重建、哈希碰撞时按键比较、MAX_DISK_BYTES 上限，以及 normalize() 的键折叠
+// ─────────────────────────────────────────────────────────────────────────────
+class TestTranslationCache : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+
+    void persistsAcrossReopen();
+    void recoversFromTruncatedRecord_data();
+    void recoversFromTruncatedRecord();
+    void resetsInvalidHeader();
+    void collidingHashComparesKeys();
+    void stopsAppendingAtSizeCap();
+    void normalizeFoldsEquivalentText_data();
+    void normalizeFoldsEquivalentText();
+    void keySeparatesLanguageAndPromptVersion();
+
+private:
+    QString cachePath(const char *name) const { return m_dir.filePath(QString::fromLatin1(name)); }
+
+    QTemporaryDir m_dir;
+
+    static constexpr qint64 HEADER_BYTES      = 16;                   // 与 TranslationCache 的文件格式一致
+    static constexpr qint64 RECORD_HEAD_BYTES = 16;
+    static constexpr qint64 MAX_DISK_BYTES    = 16 * 1024 * 1024;
+};
+
+void TestTranslationCache::init()
+{
+    QVERIFY(m_dir.isValid());
+}
+
+void TestTranslationCache::persistsAcrossReopen()
+{
+    const QString path = cachePath("persist.cache");
+    {
+        TranslationCache cache;
+        QString error;
+        QVERIFY2(cache.open(path, &error), qPrintable(error));
+        cache.insert("你好", "英语", 1, "Hello");
+        cache.insert("谢谢", "英语", 1, "Thank you");
+    }
+
+    TranslationCache cache;
+    QVERIFY(cache.open(path, nullptr));
+    QString translation;
+    QVERIFY(cache.lookup("谢谢", "英语", 1, &translation));
+    QCOMPARE(translation, QString("Thank you"));
+    QVERIFY(cache.lookup("你好", "英语", 1, &translation));
+    QCOMPARE(translation, QString("Hello"));
+    QCOMPARE(cache.stats().diskHits, quint64(2));
+
+    // 第二次查找由内存层命中
+    QVERIFY(cache.lookup("你好", "英语", 1, &translation));
+    QCOMPARE(cache.stats().memoryHits, quint64(1));
+}
+
+// 写入中途退出留下的残缺记录：打开时截掉，之前的记录照常可用，之后还能继续追加
+void TestTranslationCache::recoversFromTruncatedRecord_data()
+{
+    QTest::addColumn<QByteArray>("tail");
+
+    QByteArray head;
+    const quint32 keyBytes = 12, valueBytes = 20;
+    const quint64 hash = 0x1234;
+    head.append(reinterpret_cast<const char*>(&keyBytes), 4);
+    head.append(reinterpret_cast<const char*>(&valueBytes), 4);
+    head.append(reinterpret_cast<const char*>(&hash), 8);
+
+    QTest::newRow("partial head")  << head.left(7);
+    QTest::newRow("head only")     << head;
+    QTest::newRow("partial key")   << head + QByteArray("0123");
+    QTest::newRow("partial value") << head + QByteArray("0123456789ab") + QByteArray("xyz");
+}
+
+void TestTranslationCache::recoversFromTruncatedRecord()
+{
+    QFETCH(QByteArray, tail);
+    const QString path = cachePath("truncated.cache");
+    QFile::remove(path);
+
+    {
+        TranslationCache cache;
+        QVERIFY(cache.open(path, nullptr));
+        cache.insert("早上好", "英语", 1, "Good morning");
+    }
+    const qint64 intactSize = QFileInfo(path).size();
+
+    {
+        QFile file(path);
+        QVERIFY(file.open(QIODevice::Append));
+        QCOMPARE(file.write(tail), qint64(tail.size()));
+    }
+
+    {
+        TranslationCache cache;
+        QVERIFY(cache.open(path, nullptr));
+        QCOMPARE(QFileInfo(path).size(), intactSize);
+
+        QString translation;
+        QVERIFY(cache.lookup("早上好", "英语", 1, &translation));
+        QCOMPARE(translation, QString("Good morning"));
+        cache.insert("晚安", "英语", 1, "Good night");
+    }
+
+    TranslationCache cache;
+    QVERIFY(cache.open(path, nullptr));
+    QString translation;
+    QVERIFY(cache.lookup("早上好", "英语", 1, &translation));
+    QVERIFY(cache.lookup("晚安", "英语", 1, &translation));
+    QCOMPARE(translation, QString("Good night"));
+}
+
+// 不是缓存文件（或版本不符）：清空重建，不误读其中的内容
+void TestTranslationCache::resetsInvalidHeader()
+{
+    const QString path = cachePath("invalid.cache");
+    {
+        QFile file(path);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write(QByteArray(100, 'x'));
+    }
+
+    TranslationCache cache;
+    QVERIFY(cache.open(path, nullptr));
+    QCOMPARE(QFileInfo(path).size(), HEADER_BYTES);
+
+    QString translation;
+    QVERIFY(!cache.lookup("你好", "英语", 1, &translation));
+    cache.insert("你好", "英语", 1, "Hello");
+    QVERIFY(QFileInfo(path).size() > HEADER_BYTES);
+}
+
+// 构造一条与目标键哈希相同、键不同的记录放在前面：
+// 查找不能把它当成命中，插入后同一哈希下的两条记录各自按键区分
+void TestTranslationCache::collidingHashComparesKeys()
+{
+    // 先用正常写入拿到目标键的记录，从中读出文件头和键哈希
+    const QString source = cachePath("collision-source.cache");
+    {
+        TranslationCache cache;
+        QVERIFY(cache.open(source, nullptr));
+        cache.insert("你好", "英语", 1, "Hello");
+    }
+    QFile sourceFile(source);
+    QVERIFY(sourceFile.open(QIODevice::ReadOnly));
+    const QByteArray original = sourceFile.readAll();
+    QVERIFY(original.size() > HEADER_BYTES + RECORD_HEAD_BYTES);
+    const QByteArray header = original.left(HEADER_BYTES);
+    const QByteArray hash   = original.mid(HEADER_BYTES + 8, 8);
+
+    const QByteArray decoyKey("decoy"), decoyValue("WRONG");
+    const quint32 keyBytes = quint32(decoyKey.size()), valueBytes = quint32(decoyValue.size());
+    QByteArray decoy;
+    decoy.append(reinterpret_cast<const char*>(&keyBytes), 4);
+    decoy.append(reinterpret_cast<const char*>(&valueBytes), 4);
+    decoy.append(hash).append(decoyKey).append(decoyValue);
+
+    const QString path = cachePath("collision.cache");
+    {
+        QFile file(path);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write(header + decoy);
+    }
+
+    QString translation;
+    {
+        TranslationCache cache;
+        QVERIFY(cache.open(path, nullptr));
+        QVERIFY(!cache.lookup("你好", "英语", 1, &translation));
+        cache.insert("你好", "英语", 1, "Hello");
+    }
+    QCOMPARE(QFileInfo(path).size(), HEADER_BYTES + decoy.size() + (original.size() - HEADER_BYTES));
+
+    TranslationCache cache;
+    QVERIFY(cache.open(path, nullptr));
+    QVERIFY(cache.lookup("你好", "英语", 1, &translation));
+    QCOMPARE(translation, QString("Hello"));
+    QCOMPARE(cache.stats().diskHits, quint64(1));
+}
+
+// 超过 MAX_DISK_BYTES 后不再追加，但内存层照常工作
+void TestTranslationCache::stopsAppendingAtSizeCap()
+{
+    const QString path = cachePath("cap.cache");
+    TranslationCache cache(8);
+    QVERIFY(cache.open(path, nullptr));
+
+    const QString value(64 * 1024, QChar('a'));
+    const int inserts = int(MAX_DISK_BYTES / value.size()) + 16;
+    for (int i = 0; i < inserts; ++i) {
+        cache.insert(QString("句子 %1").arg(i), "英语", 1, value);
+    }
+    const qint64 cappedSize = QFileInfo(path).size();
+    QVERIFY(cappedSize <= MAX_DISK_BYTES);
+    QVERIFY(cappedSize > MAX_DISK_BYTES - value.size() - 1024);
+
+    cache.insert("最后一句", "英语", 1, value);
+    QCOMPARE(QFileInfo(path).size(), cappedSize);
+    QString translation;
+    QVERIFY(cache.lookup("最后一句", "英语", 1, &translation));
+    QCOMPARE(translation, value);
+    QCOMPARE(cache.stats().memoryHits, quint64(1));
+
+    // 写满前的记录仍在磁盘层（已被内存层淘汰）
+    QVERIFY(cache.lookup("句子 0", "英语", 1, &translation));
+    QCOMPARE(cache.stats().diskHits, quint64(1));
+}
+
+void TestTranslationCache::normalizeFoldsEquivalentText_data()
+{
+    QTest::addColumn<QString>("a");
+    QTest::addColumn<QString>("b");
+
+    QTest::newRow("case")              << QString("Hello World") << QString("hello world");
+    QTest::newRow("whitespace")        << QString("  hello \t  world\n") << QString("hello world");
+    QTest::newRow("trailing period")   << QString("你好。") << QString("你好");
+    QTest::newRow("trailing bangs")    << QString("谢谢！！") << QString("谢谢");
+    QTest::newRow("trailing tilde")    << QString("好的～") << QString("好的");
+    QTest::newRow("ascii punctuation") << QString("OK!.") << QString("ok");
+    QTest::newRow("fullwidth latin")   << QString("ＯＫ") << QString("ok");
+    QTest::newRow("ideographic space") << QString("你好　世界") << QString("你好 世界");
+}
+
+void TestTranslationCache::normalizeFoldsEquivalentText()
+{
+    QFETCH(QString, a);
+    QFETCH(QString, b);
+    QCOMPARE(TranslationCache::normalize(a), TranslationCache::normalize(b));
+
+    // 规范化后相同的原文共用一条缓存
+    TranslationCache cache;
+    cache.insert(a, "英语", 1, "translated");
+    QString translation;
+    QVERIFY(cache.lookup(b, "英语", 1, &translation));
+    QCOMPARE(translation, QString("translated"));
+}
+
+// 问号不折叠（疑问与陈述译法不同），目标语言和提示词版本是键的一部分
+void TestTranslationCache::keySeparatesLanguageAndPromptVersion()
+{
+    QVERIFY(TranslationCache::normalize("你好？") != TranslationCache::normalize("你好"));
+
+    TranslationCache cache;
+    cache.insert("你好", "英语", 1, "Hello");
+    QString translation;
+    QVERIFY(!cache.lookup("你好", "日语", 1, &translation));
+    QVERIFY(!cache.lookup("你好", "英语", 2, &translation));
+    QVERIFY(cache.lookup("你好", "英语", 1, &translation));
+    QCOMPARE(translation, QString("Hello"));
+}
+
+QTEST_APPLESS_MAIN(TestTranslationCache)
+
+#include "tst_translationcache.moc"
@@ -0,0 +1,257 @@
+#include <QtTest>
+#include "xunfeiresultparser.h"
+
+// ─────────────────────────────────────────────────────────────────────────────
+// XunFeiResultParser / XunFeiSegmentTable 单元测试：
+// 解析器的字段提取、\uXXXX 转义与畸形消息拒绝；分片表对 apd / rpl 序列
+// （含越界 rg、缺失或异常 sn）拼出的文本与 stableLength()
+// ─────────────────────────────────────────────────────────────────────────────
+class TestXunFeiResultParser : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void parsesResultFields();
+    void parsesErrorAndNullData();
+    void decodesEscapes();
+    void rejectsTruncated();
+    void rejectsMalformed_data();
+    void rejectsMalformed();
+
+    void appendOnlyWithoutCorrections();
+    void appendOnlyWithCorrections();
+    void replaceRange();
+    void appendAfterReplace();
+    void outOfRangeReplace();
+    void missingOrInvalidSn();
+
+private:
+    // 构造一条中间结果消息；sn <= 0 时不带 sn，pgs 为空时不带 pgs / rg
+    static QString message(int sn, const char *pgs, const QStringList &words,
+                           int rangeBegin = 0, int rangeEnd = 0, bool last = false);
+    // 解析并写入分片表
+    static void apply(XunFeiSegmentTable *table, const QString &json);
+};
+
+QString TestXunFeiResultParser::message(int sn, const char *pgs, const QStringList &words,
+                                        int rangeBegin, int rangeEnd, bool last)
+{
+    QString ws;
+    for (const QString &w : words) {
+        if (!ws.isEmpty()) ws += ',';
+        ws += QString("{\"bg\":0,\"cw\":[{\"sc\":0,\"w\":\"%1\"}]}").arg(w);
+    }
+    QString result;
+    if (sn > 0) {
+        result += QString("\"sn\":%1,").arg(sn);
+    }
+    result += QString("\"ls\":%1,\"bg\":0,\"ed\":0,").arg(last ? "true" : "false");
+    if (pgs) {
+        result += QString("\"pgs\":\"%1\",").arg(pgs);
+        if (qstrcmp(pgs, "rpl") == 0) {
+            result += QString("\"rg\":[%1,%2],").arg(rangeBegin).arg(rangeEnd);
+        }
+    }
+    result += QString("\"ws\":[%1]").arg(ws);
+    return QString("{\"code\":0,\"message\":\"success\",\"sid\":\"iat000e1234@dx0\","
+                   "\"data\":{\"result\":{%1},\"status\":%2}}")
+        .arg(result).arg(last ? 2 : 1);
+}
+
+void TestXunFeiResultParser::apply(XunFeiSegmentTable *table, const QString &json)
+{
+    XunFeiResultParser parser;
+    XunFeiResult result;
+    QVERIFY(parser.parse(json, &result));
+    table->apply(result);
+}
+
+// ─── 解析器 ──────────────────────────────────────────────────────────────────
+
+void TestXunFeiResultParser::parsesResultFields()
+{
+    XunFeiResultParser parser;
+    XunFeiResult result;
+    QVERIFY(parser.parse(message(3, "rpl", { "今天", "天气" }, 1, 2, true), &result));
+    QCOMPARE(result.code, 0);
+    QCOMPARE(result.status, 2);
+    QVERIFY(result.hasResult);
+    QCOMPARE(result.sn, 3);
+    QVERIFY(result.last);
+    QVERIFY(result.replace);
+    QVERIFY(result.corrections);
+    QCOMPARE(result.rangeBegin, 1);
+    QCOMPARE(result.rangeEnd, 2);
+    QCOMPARE(result.text, QString("今天天气"));
+
+    // 同一个 result 复用：上一条的字段必须被清掉
+    QVERIFY(parser.parse(message(4, nullptr, { "好" }), &result));
+    QCOMPARE(result.sn, 4);
+    QVERIFY(!result.replace);
+    QVERIFY(!result.corrections);
+    QVERIFY(!result.last);
+    QCOMPARE(result.text, QString("好"));
+}
+
+void TestXunFeiResultParser::parsesErrorAndNullData()
+{
+    XunFeiResultParser parser;
+    XunFeiResult result;
+    QVERIFY(parser.parse(u"{\"code\":10165,\"message\":\"invalid handle\",\"data\":null}", &result));
+    QCOMPARE(result.code, 10165);
+    QCOMPARE(result.message, QString("invalid handle"));
+    QCOMPARE(result.status, -1);
+    QVERIFY(!result.hasResult);
+
+    QVERIFY(parser.parse(u"{\"code\":0,\"data\":{\"status\":2,\"result\":null}}", &result));
+    QCOMPARE(result.status, 2);
+    QVERIFY(!result.hasResult);
+}
+
+// 讯飞把标点等字符写成 \uXXXX；代理对分两个 \u 出现
+void TestXunFeiResultParser::decodesEscapes()
+{
+    XunFeiResultParser parser;
+    XunFeiResult result;
+    QVERIFY(parser.parse(message(1, "apd", { "\\u4f60\\u597D", "\\uff1f", "\\ud83d\\udc4d",
+                                            "a\\\"b\\\\c\\/d\\n" }), &result));
+    QCOMPARE(result.text, QString("你好？") + QString::fromUtf8("👍") + QString("a\"b\\c/d\n"));
+}
+
+// 任何截断都必须失败，不能把不完整的结果当成功
+void TestXunFeiResultParser::rejectsTruncated()
+{
+    const QString full = message(2, "rpl", { "今天", "\\u5929\\u6c14" }, 1, 1, true);
+    XunFeiResultParser parser;
+    XunFeiResult result;
+    QVERIFY(parser.parse(full, &result));
+    for (qsizetype n = 0; n < full.size(); ++n) {
+        QVERIFY2(!parser.parse(QStringView(full).left(n), &result), qPrintable(full.left(n)));
+    }
+}
+
+void TestXunFeiResultParser::rejectsMalformed_data()
+{
+    QTest::addColumn<QString>("json");
+
+    QString deep = QString("{\"x\":").repeated(40) + "1" + QString("}").repeated(40);
+
+    QTest::newRow("empty")            << QString();
+    QTest::newRow("not object")       << QString("[1,2]");
+    QTest::newRow("unquoted key")     << QString("{code:0}");
+    QTest::newRow("missing colon")    << QString("{\"code\" 0}");
+    QTest::newRow("missing comma")    << QString("{\"code\":0 \"sid\":\"x\"}");
+    QTest::newRow("bad number")       << QString("{\"code\":x}");
+    QTest::newRow("bad escape")       << message(1, "apd", { "\\x41" });
+    QTest::newRow("bad hex")          << message(1, "apd", { "\\u12G4" });
+    QTest::newRow("short \\u")        << QString("{\"message\":\"\\u12\"}");
+    QTest::newRow("unclosed array")   << QString("{\"data\":{\"result\":{\"rg\":[1,2}}}");
+    QTest::newRow("too deep")         << deep;
+}
+
+void TestXunFeiResultParser::rejectsMalformed()
+{
+    QFETCH(QString, json);
+    XunFeiResultParser parser;
+    XunFeiResult result;
+    QVERIFY(!parser.parse(json, &result));
+}
+
+// ─── 分片表 ──────────────────────────────────────────────────────────────────
+
+// 未开启动态修正：逐片追加，每片都是定稿
+void TestXunFeiResultParser::appendOnlyWithoutCorrections()
+{
+    XunFeiSegmentTable table;
+    QVERIFY(table.isEmpty());
+    apply(&table, message(1, nullptr, { "今天" }));
+    apply(&table, message(2, nullptr, { "天气" }));
+    apply(&table, message(3, nullptr, { "不错" }, 0, 0, true));
+    QCOMPARE(table.text(), QString("今天天气不错"));
+    QCOMPARE(table.stableLength(), table.text().size());
+}
+
+// 开启动态修正但只有 apd：还没有 rpl 越过任何分片，全部可能被替换
+void TestXunFeiResultParser::appendOnlyWithCorrections()
+{
+    XunFeiSegmentTable table;
+    apply(&table, message(1, "apd", { "今天" }));
+    apply(&table, message(2, "apd", { "天气" }));
+    QCOMPARE(table.text(), QString("今天天气"));
+    QCOMPARE(table.stableLength(), qsizetype(0));
+}
+
+// rpl 用本片替换 [rg0, rg1] 内的旧分片，rg0 之前的分片定稿
+void TestXunFeiResultParser::replaceRange()
+{
+    XunFeiSegmentTable table;
+    apply(&table, message(1, "apd", { "我" }));
+    apply(&table, message(2, "apd", { "今" }));
+    apply(&table, message(3, "apd", { "天起" }));
+    apply(&table, message(4, "rpl", { "今天气" }, 2, 3));
+    QCOMPARE(table.text(), QString("我今天气"));
+    QCOMPARE(table.stableLength(), qsizetype(1));   // sn1 "我"
+
+    apply(&table, message(5, "rpl", { "今天天气" }, 4, 4));
+    QCOMPARE(table.text(), QString("我今天天气"));
+    QCOMPARE(table.stableLength(), qsizetype(1));   // sn2、sn3 已清空，sn4 被替换
+}
+
+// rpl 之后的 apd 追加在末尾，仍处于可替换区；下一次 rpl 越过它们后才定稿
+void TestXunFeiResultParser::appendAfterReplace()
+{
+    XunFeiSegmentTable table;
+    apply(&table, message(1, "apd", { "今" }));
+    apply(&table, message(2, "rpl", { "今天" }, 1, 1));
+    apply(&table, message(3, "apd", { "天气" }));
+    QCOMPARE(table.text(), QString("今天天气"));
+    QCOMPARE(table.stableLength(), qsizetype(0));
+
+    apply(&table, message(4, "apd", { "不" }));
+    apply(&table, message(5, "rpl", { "不错" }, 4, 4));
+    QCOMPARE(table.text(), QString("今天天气不错"));
+    QCOMPARE(table.stableLength(), QString("今天天气").size());
+
+    table.clear();
+    QVERIFY(table.isEmpty());
+    QCOMPARE(table.text(), QString());
+    QCOMPARE(table.stableLength(), qsizetype(0));
+}
+
+// rg 超出已有分片或从 0 开始：按已有范围截断，不越界
+void TestXunFeiResultParser::outOfRangeReplace()
+{
+    XunFeiSegmentTable table;
+    apply(&table, message(1, "apd", { "你" }));
+    apply(&table, message(2, "apd", { "好" }));
+    apply(&table, message(3, "rpl", { "你好" }, 0, 100));
+    QCOMPARE(table.text(), QString("你好"));
+    QCOMPARE(table.stableLength(), qsizetype(0));
+
+    apply(&table, message(4, "rpl", { "世界" }, 50, 60));   // 范围内没有分片，只追加本片
+    QCOMPARE(table.text(), QString("你好世界"));
+    QCOMPARE(table.stableLength(), QString("你好世界").size());
+}
+
+// 缺失或非正的 sn 按追加处理；异常大的 sn 被忽略
+void TestXunFeiResultParser::missingOrInvalidSn()
+{
+    XunFeiSegmentTable table;
+    apply(&table, message(0, nullptr, { "一" }));
+    apply(&table, message(0, nullptr, { "二" }));
+    QCOMPARE(table.text(), QString("一二"));
+
+    apply(&table, message(100000, nullptr, { "丢弃" }));
+    QCOMPARE(table.text(), QString("一二"));
+
+    XunFeiResult negative;
+    negative.sn   = -5;
+    negative.text = "三";
+    table.apply(negative);
+    QCOMPARE(table.text(), QString("一二三"));
+    QCOMPARE(table.stableLength(), table.text().size());
+}
+
+QTEST_APPLESS_MAIN(TestXunFeiResultParser)
+
+#include "tst_xunfeiresultparser.moc"
@@ -0,0 +1,238 @@
+#include "voiceactivitydetector.h"
+#include "dspkernels.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace {
+constexpr float PI = 3.14159265358979f;
+}
+
+std::unique_ptr<IVoiceActivityDetector> createVoiceActivityDetector(const QString &mode,
+                                                                    double threshold)
+{
+    if (mode.compare("spectral", Qt::CaseInsensitive) == 0) {
+        return std::make_unique<SpectralVoiceActivityDetector>(threshold);
+    }
+    return std::make_unique<RmsVoiceActivityDetector>(threshold);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// RmsVoiceActivityDetector
+// ─────────────────────────────────────────────────────────────────────────────
+RmsVoiceActivityDetector::RmsVoiceActivityDetector(double threshold)
+    : m_threshold(static_cast<float>(threshold))
+{
+}
+
+bool RmsVoiceActivityDetector::isSpeech(const int16_t *samples, int count)
+{
+    return Dsp::rms(samples, count) > m_threshold;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// SpectralVoiceActivityDetector
+// ─────────────────────────────────────────────────────────────────────────────
+SpectralVoiceActivityDetector::SpectralVoiceActivityDetector(double threshold)
+    : m_threshold(static_cast<float>(threshold))
+    , m_window(FFT_SIZE)
+    , m_twiddle(FFT_SIZE / 2)
+    , m_bitReverse(FFT_SIZE)
+    , m_pcm(FFT_SIZE)
+    , m_spectrum(FFT_SIZE)
+    , m_power(FFT_SIZE / 2 + 1)
+{
+    for (int i = 0; i < FFT_SIZE; ++i) {
+        m_window[i] = 0.5f - 0.5f * std::cos(2.0f * PI * i / (FFT_SIZE - 1));
+    }
+    for (int k = 0; k < FFT_SIZE / 2; ++k) {
+        const float phase = -2.0f * PI * k / FFT_SIZE;
+        m_twiddle[k] = { std::cos(phase), std::sin(phase) };
+    }
+    int bits = 0;
+    while ((1 << bits) < FFT_SIZE) ++bits;
+    for (int i = 0; i < FFT_SIZE; ++i) {
+        int r = 0;
+        for (int b = 0; b < bits; ++b) {
+            if (i & (1 << b)) r |= 1 << (bits - 1 - b);
+        }
+        m_bitReverse[i] = r;
+    }
+}
+
+void SpectralVoiceActivityDetector::reset()
+{
+    m_noiseFloorDb   = -60.0f;
+    m_onsetCount     = 0;
+    m_hangover       = 0;
+    m_speaking       = false;
+    m_budgetStrikes  = 0;
+    m_degradedFrames = 0;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// isSpeech() — 原始判决 + 起始确认 + 拖尾平滑
+// ─────────────────────────────────────────────────────────────────────────────
+bool SpectralVoiceActivityDetector::isSpeech(const int16_t *samples, int count)
+{
+    const bool raw = rawDecision(samples, count);
+
+    if (raw) {
+        if (!m_speaking && ++m_onsetCount >= ONSET_FRAMES) {
+            m_speaking = true;
+        }
+        if (m_speaking) {
+            m_hangover = HANGOVER_FRAMES;
+        }
+        return m_speaking;
+    }
+
+    m_onsetCount = 0;
+    if (m_speaking && m_hangover > 0) {
+        --m_hangover;
+        return true;
+    }
+    m_speaking = false;
+    return false;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// rawDecision() — 单帧判决
+// ─────────────────────────────────────────────────────────────────────────────
+bool SpectralVoiceActivityDetector::rawDecision(const int16_t *samples, int count)
+{
+    if (count <= 0) return false;
+
+    const Dsp::Kernels &k = Dsp::kernels();
+    const double meanSquare = k.sumSquares(samples, count) / count;
+    const float  rms        = static_cast<float>(std::sqrt(meanSquare) / 32768.0);
+
+    Features f;
+    f.logEnergyDb = 10.0f * std::log10(static_cast<float>(meanSquare / (32768.0 * 32768.0)) + 1e-10f);
+    f.zcr         = Dsp::zeroCrossingRate(samples, count);
+
+    // 能量门限：低于配置阈值的帧直接判为静音，不做频谱分析
+    if (rms <= m_threshold) {
+        trackNoiseFloor(f.logEnergyDb, false);
+        return false;
+    }
+
+    const bool energyVote = f.logEnergyDb > m_noiseFloorDb + ENERGY_MARGIN_DB;
+    const bool zcrVote    = f.zcr >= ZCR_MIN && f.zcr <= ZCR_MAX;
+
+    bool speech;
+    if (m_degradedFrames > 0) {
+        // 降级模式：只看能量与过零率
+        --m_degradedFrames;
+        speech = energyVote && zcrVote;
+    } else {
+        const auto start = std::chrono::steady_clock::now();
+        analyseSpectrum(samples, count, &f);
+        const qint64 us = std::chrono::duration_cast<std::chrono::microseconds>(
+                              std::chrono::steady_clock::now() - start).count();
+        if (us > CPU_BUDGET_US) {
+            ++m_budgetOverruns;
+            if (++m_budgetStrikes >= BUDGET_STRIKES) {
+                m_degradedFrames = DEGRADED_FRAMES;
+                m_budgetStrikes  = 0;
+            }
+        } else {
+            m_budgetStrikes = 0;
+        }
+
+        const int votes = int(energyVote) + int(zcrVote)
+                        + int(f.flatness <= FLATNESS_MAX)
+                        + int(f.bandRatio >= BAND_RATIO_MIN);
+        speech = votes >= 3;
+    }
+
+    trackNoiseFloor(f.logEnergyDb, speech);
+    return speech;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// analyseSpectrum() — 取帧中间 FFT_SIZE 个样本，去直流、加窗、FFT，计算功率谱特征
+// ─────────────────────────────────────────────────────────────────────────────
+void SpectralVoiceActivityDetector::analyseSpectrum(const int16_t *samples, int count, Features *f)
+{
+    const Dsp::Kernels &k = Dsp::kernels();
+
+    const int used   = std::min(count, FFT_SIZE);
+    const int offset = (count - used) / 2;
+    k.int16ToFloat(samples + offset, m_pcm.data(), used);
+    std::fill(m_pcm.begin() + used, m_pcm.end(), 0.0f);
+    k.removeDc(m_pcm.data(), used);
+
+    for (int i = 0; i < FFT_SIZE; ++i) {
+        m_spectrum[m_bitReverse[i]] = { m_pcm[i] * m_window[i], 0.0f };
+    }
+    fft();
+
+    for (int b = 0; b <= FFT_SIZE / 2; ++b) {
+        const float re = m_spectrum[b].real();
+        const float im = m_spectrum[b].imag();
+        m_power[b] = re * re + im * im;
+    }
+
+    auto bin = [](int hz) { return hz * FFT_SIZE / SAMPLE_RATE; };
+    const int flatLo   = bin(300);
+    const int flatHi   = bin(4000);
+    const int speechHi = bin(3400);
+    const int totalLo  = bin(100);
+    const int totalHi  = FFT_SIZE / 2 - 1;
+
+    constexpr float EPS = 1e-12f;
+    double logSum = 0.0;
+    double linSum = 0.0;
+    for (int b = flatLo; b <= flatHi; ++b) {
+        logSum += std::log(m_power[b] + EPS);
+        linSum += m_power[b];
+    }
+    const int flatBins = flatHi - flatLo + 1;
+    f->flatness = static_cast<float>(std::exp(logSum / flatBins) / (linSum / flatBins + EPS));
+
+    double speechEnergy = 0.0;
+    double totalEnergy  = 0.0;
+    for (int b = totalLo; b <= totalHi; ++b) {
+        totalEnergy += m_power[b];
+        if (b >= flatLo && b <= speechHi) speechEnergy += m_power[b];
+    }
+    f->bandRatio = static_cast<float>(speechEnergy / (totalEnergy + EPS));
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// fft() — 原地迭代基 2 FFT（输入已按位反转顺序放好）
+// ─────────────────────────────────────────────────────────────────────────────
+void SpectralVoiceActivityDetector::fft()
+{
+    std::complex<float> *a = m_spectrum.data();
+    for (int len = 2; len <= FFT_SIZE; len <<= 1) {
+        const int half = len / 2;
+        const int step = FFT_SIZE / len;
+        for (int i = 0; i < FFT_SIZE; i += len) {
+            for (int j = 0; j < half; ++j) {
+                const std::complex<float> w = m_twiddle[j * step];
+                const std::complex<float> u = a[i + j];
+                const std::complex<float> x = a[i + j + half];
+                // 手写复数乘法，避免 std::complex 的 NaN/Inf 兼容分支
+                const std::complex<float> v(x.real() * w.real() - x.imag() * w.imag(),
+                                            x.real() * w.imag() + x.imag() * w.real());
+                a[i + j]        = u + v;
+                a[i + j + half] = u - v;
+            }
+        }
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// trackNoiseFloor() — 噪声底跟踪：快降慢升，只在非语音帧更新
+// ─────────────────────────────────────────────────────────────────────────────
+void SpectralVoiceActivityDetector::trackNoiseFloor(float logEnergyDb, bool speech)
+{
+    if (speech) return;
+    if (logEnergyDb < m_noiseFloorDb) {
+        m_noiseFloorDb += 0.5f * (logEnergyDb - m_noiseFloorDb);
+    } else {
+        m_noiseFloorDb += 0.05f * (logEnergyDb - m_noiseFloorDb);
+    }
+}
@@ -0,0 +1,130 @@
+#ifndef VOICEACTIVITYDETECTOR_H
+#define VOICEACTIVITYDETECTOR_H
+
+#include <QString>
+#include <complex>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// ─────────────────────────────────────────────────────────────────────────────
+// IVoiceActivityDetector — 逐帧判断是否有人声
+//
+// 输入固定为 16kHz / 16bit / 单声道 PCM，每次一帧（40ms = 640 样本）。
+// 实现可以有内部状态（平滑、噪声跟踪），切换句子或重启采集时调用 reset()。
+// 只在采集线程中使用，不需要线程安全。
+// ─────────────────────────────────────────────────────────────────────────────
+class IVoiceActivityDetector
+{
+public:
+    virtual ~IVoiceActivityDetector() = default;
+
+    virtual const char *name() const = 0;
+
+    // 返回 true 表示该帧含语音
+    virtual bool isSpeech(const int16_t *samples, int count) = 0;
+
+    // 清除内部状态
+    virtual void reset() = 0;
+
+    // 更新音量阈值（归一化 RMS），自适应阈值与校准时调用
+    virtual void setThreshold(double threshold) = 0;
+
+    // 超出单帧 CPU 预算的帧数（没有预算概念的实现恒为 0）
+    virtual quint64 budgetOverruns() const { return 0; }
+};
+
+// 按配置创建检测器：mode 为 "rms" 或 "spectral"，未知值回退到 "rms"
+std::unique_ptr<IVoiceActivityDetector> createVoiceActivityDetector(const QString &mode,
+                                                                    double threshold);
+
+// ─────────────────────────────────────────────────────────────────────────────
+// RmsVoiceActivityDetector — 原有规则：归一化 RMS 超过阈值即为语音
+// ─────────────────────────────────────────────────────────────────────────────
+class RmsVoiceActivityDetector : public IVoiceActivityDetector
+{
+public:
+    explicit RmsVoiceActivityDetector(double threshold);
+
+    const char *name() const override { return "rms"; }
+    bool isSpeech(const int16_t *samples, int count) override;
+    void reset() override {}
+    void setThreshold(double threshold) override { m_threshold = static_cast<float>(threshold); }
+
+private:
+    float m_threshold;
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+// SpectralVoiceActivityDetector — 多特征语音检测
+//
+// 在 RMS 阈值（能量门限）之上再看三项频谱/时域特征，多数通过才算语音：
+//   - 对数能量高出跟踪到的噪声底 ENERGY_MARGIN_DB
+//   - 过零率落在人声范围（键盘敲击、嘶声过零率很高）
+//   - 300~4000Hz 频谱平坦度低（风扇、白噪声接近平坦）
+//   - 300~3400Hz 语音频带能量占比高（低频嗡声、高频游戏音效占比低）
+// 再做起始确认（连续 ONSET_FRAMES 帧）和拖尾（HANGOVER_FRAMES 帧）平滑，
+// 单帧的敲击声不会触发，句中短暂停顿也不会被切断。
+//
+// FFT 长度固定、窗函数与旋转因子预先计算、处理过程零分配，单帧开销恒定。
+// 每帧计时，连续超出 CPU_BUDGET_US 时暂停频谱分析 DEGRADED_FRAMES 帧，
+// 只用能量与过零率判断，保证采集线程不被拖慢。
+// ─────────────────────────────────────────────────────────────────────────────
+class SpectralVoiceActivityDetector : public IVoiceActivityDetector
+{
+public:
+    explicit SpectralVoiceActivityDetector(double threshold);
+
+    const char *name() const override { return "spectral"; }
+    bool isSpeech(const int16_t *samples, int count) override;
+    void reset() override;
+    void setThreshold(double threshold) override { m_threshold = static_cast<float>(threshold); }
+    quint64 budgetOverruns() const override { return m_budgetOverruns; }
+
+private:
+    struct Features {
+        float logEnergyDb;   // 10·log10(均方值)
+        float zcr;           // 过零率
+        float flatness;      // 频谱平坦度（0 = 纯音，1 = 白噪声）
+        float bandRatio;     // 语音频带能量占比
+    };
+
+    bool  rawDecision(const int16_t *samples, int count);
+    void  analyseSpectrum(const int16_t *samples, int count, Features *f);
+    void  fft();
+    void  trackNoiseFloor(float logEnergyDb, bool speech);
+
+    static constexpr int   FFT_SIZE          = 512;    // 32ms@16kHz，频率分辨率 31.25Hz
+    static constexpr int   SAMPLE_RATE       = 16000;
+    static constexpr float ENERGY_MARGIN_DB  = 6.0f;
+    static constexpr float ZCR_MIN           = 0.01f;
+    static constexpr float ZCR_MAX           = 0.35f;
+    static constexpr float FLATNESS_MAX      = 0.45f;
+    static constexpr float BAND_RATIO_MIN    = 0.55f;
+    static constexpr int   ONSET_FRAMES      = 2;      // 连续多少帧判定为语音才开始
+    static constexpr int   HANGOVER_FRAMES   = 4;      // 语音结束后保持的帧数（160ms）
+    static constexpr qint64 CPU_BUDGET_US    = 1000;   // 单帧分析预算（帧长 40ms 的 2.5%）
+    static constexpr int   BUDGET_STRIKES    = 3;      // 连续超预算多少帧后降级
+    static constexpr int   DEGRADED_FRAMES   = 25;     // 降级持续帧数（1s）
+
+    float m_threshold;
+
+    // ─── 预计算表与工作区（构造时一次性分配）─────────────────────────────────
+    std::vector<float>               m_window;     // Hann 窗
+    std::vector<std::complex<float>> m_twiddle;    // 旋转因子
+    std::vector<int>                 m_bitReverse; // 位反转下标
+    std::vector<float>               m_pcm;        // int16 → float 转换缓冲
+    std::vector<std::complex<float>> m_spectrum;   // FFT 工作区
+    std::vector<float>               m_power;      // 功率谱（FFT_SIZE/2 + 1）
+
+    // ─── 状态 ────────────────────────────────────────────────────────────────
+    float   m_noiseFloorDb    = -60.0f;
+    int     m_onsetCount      = 0;
+    int     m_hangover        = 0;
+    bool    m_speaking        = false;
+    int     m_budgetStrikes   = 0;
+    int     m_degradedFrames  = 0;
+    quint64 m_budgetOverruns  = 0;
+};
+
+#endif // VOICEACTIVITYDETECTOR_H
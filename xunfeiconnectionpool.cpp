@@ -0,0 +1,242 @@
+#include "xunfeiconnectionpool.h"
+#include <QUrl>
+#include <QUrlQuery>
+#include <QDateTime>
+#include <QCryptographicHash>
+#include <QMessageAuthenticationCode>
+
+XunFeiConnectionPool::XunFeiConnectionPool(QObject *parent)
+    : QObject(parent)
+{
+    m_maintenanceTimer = new QTimer(this);
+    connect(m_maintenanceTimer, &QTimer::timeout,
+            this, &XunFeiConnectionPool::onMaintenance);
+}
+
+XunFeiConnectionPool::~XunFeiConnectionPool()
+{
+    shutdown();
+}
+
+void XunFeiConnectionPool::configure(const QString &apiKey, const QString &apiSecret,
+                                     const QString &host, const QString &path)
+{
+    m_apiKey    = apiKey;
+    m_apiSecret = apiSecret;
+    m_host      = host;
+    m_path      = path;
+    m_cachedUrl.clear();
+    m_urlSignedAt = 0;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// formatTimestamp() - RFC1123格式时间戳
+// ─────────────────────────────────────────────────────────────────────────────
+QString XunFeiConnectionPool::formatTimestamp()
+{
+    return QDateTime::currentDateTimeUtc().toString("ddd, dd MMM yyyy hh:mm:ss") + " GMT";
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// generateAuthUrl() - 生成带鉴权的WebSocket URL
+// ─────────────────────────────────────────────────────────────────────────────
+QString XunFeiConnectionPool::generateAuthUrl() const
+{
+    const QString date = formatTimestamp();
+    const QString requestLine = "GET " + m_path + " HTTP/1.1";
+    const QString signatureOrigin = "host: " + m_host + "\ndate: " + date + "\n" + requestLine;
+
+    // HMAC-SHA256签名
+    QMessageAuthenticationCode hmac(QCryptographicHash::Sha256);
+    hmac.setKey(m_apiSecret.toUtf8());
+    hmac.addData(signatureOrigin.toUtf8());
+    QByteArray signature = hmac.result().toBase64();
+
+    // Authorization原始字符串
+    QString authorizationOrigin = QString("api_key=\"%1\", algorithm=\"hmac-sha256\", "
+                                          "headers=\"host date request-line\", signature=\"%2\"")
+                                      .arg(m_apiKey, QString::fromUtf8(signature));
+
+    // Base64编码
+    QString authorization = QString::fromUtf8(authorizationOrigin.toUtf8().toBase64());
+
+    QUrl url;
+    url.setScheme("wss");
+    url.setHost(m_host);
+    url.setPath(m_path);
+    QUrlQuery query;
+    query.addQueryItem("host", m_host);
+    query.addQueryItem("date", date);
+    query.addQueryItem("authorization", authorization);
+    url.setQuery(query);
+
+    return url.toString();
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// signedUrl() - 返回缓存的鉴权 URL，过期时重新签名
+// ─────────────────────────────────────────────────────────────────────────────
+QString XunFeiConnectionPool::signedUrl()
+{
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    if (m_cachedUrl.isEmpty() || now - m_urlSignedAt >= AUTH_REFRESH_MS) {
+        m_cachedUrl   = generateAuthUrl();
+        m_urlSignedAt = now;
+    }
+    return m_cachedUrl;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// acquire() - 取走一条连接交给识别会话
+// 优先级：已就绪 > 正在握手 > 现场新建
+// ─────────────────────────────────────────────────────────────────────────────
+QWebSocket *XunFeiConnectionPool::acquire(QObject *newParent)
+{
+    int index = -1;
+    for (int i = 0; i < m_entries.size(); ++i) {
+        if (m_entries[i].ready &&
+            m_entries[i].socket->state() == QAbstractSocket::ConnectedState) {
+            index = i;
+            break;
+        }
+    }
+    if (index < 0) {
+        for (int i = 0; i < m_entries.size(); ++i) {
+            if (!m_entries[i].ready) {
+                index = i;
+                break;
+            }
+        }
+    }
+
+    QWebSocket *socket = nullptr;
+    if (index >= 0) {
+        socket = m_entries.takeAt(index).socket;
+        socket->disconnect(this);
+    } else {
+        socket = new QWebSocket(QString(), QWebSocketProtocol::VersionLatest);
+        socket->open(QUrl(signedUrl()));
+    }
+    socket->setParent(newParent);
+
+    // 补充连接放到下一轮事件循环，不占用本次会话的首帧发送
+    if (m_maintenanceTimer->isActive()) {
+        QTimer::singleShot(0, this, &XunFeiConnectionPool::topUp);
+    }
+    return socket;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// warmUp() - 语音起点触发预热
+// ─────────────────────────────────────────────────────────────────────────────
+void XunFeiConnectionPool::warmUp()
+{
+    if (m_apiKey.isEmpty() || m_apiSecret.isEmpty()) {
+        return;
+    }
+
+    m_lastWarmUpAt = QDateTime::currentMSecsSinceEpoch();
+    if (!m_maintenanceTimer->isActive()) {
+        m_maintenanceTimer->start(MAINTENANCE_MS);
+    }
+    topUp();
+}
+
+void XunFeiConnectionPool::shutdown()
+{
+    m_maintenanceTimer->stop();
+    m_lastWarmUpAt = 0;
+    while (!m_entries.isEmpty()) {
+        discard(m_entries.first().socket);
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// onMaintenance() - 后台维护：重新签名、回收过期连接、补足连接数
+// ─────────────────────────────────────────────────────────────────────────────
+void XunFeiConnectionPool::onMaintenance()
+{
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+
+    if (now - m_lastWarmUpAt >= WARM_WINDOW_MS) {
+        // 预热窗口已过，释放所有连接，等待下一次语音起点
+        shutdown();
+        emit debug("XunFeiConnectionPool: 预热窗口结束，释放连接");
+        return;
+    }
+
+    if (now - m_urlSignedAt >= AUTH_REFRESH_MS) {
+        m_cachedUrl   = generateAuthUrl();
+        m_urlSignedAt = now;
+    }
+
+    // 空闲过久（已就绪）或握手过久（未就绪）的连接都需要重建
+    QList<QWebSocket *> stale;
+    for (const Entry &e : m_entries) {
+        if (now - e.openedAt >= IDLE_RECYCLE_MS) {
+            stale.append(e.socket);
+        }
+    }
+    for (QWebSocket *socket : stale) {
+        discard(socket);
+    }
+
+    topUp();
+}
+
+void XunFeiConnectionPool::topUp()
+{
+    while (m_entries.size() < POOL_SIZE) {
+        Entry e;
+        e.socket   = openSocket();
+        e.openedAt = QDateTime::currentMSecsSinceEpoch();
+        m_entries.append(e);
+    }
+}
+
+QWebSocket *XunFeiConnectionPool::openSocket()
+{
+    QWebSocket *socket = new QWebSocket(QString(), QWebSocketProtocol::VersionLatest, this);
+    connect(socket, &QWebSocket::connected,
+            this, &XunFeiConnectionPool::onSocketConnected);
+    connect(socket, &QWebSocket::disconnected,
+            this, &XunFeiConnectionPool::onSocketDisconnected);
+    connect(socket, QOverload<QAbstractSocket::SocketError>::of(&QWebSocket::error),
+            this, &XunFeiConnectionPool::onSocketDisconnected);
+    socket->open(QUrl(signedUrl()));
+    return socket;
+}
+
+void XunFeiConnectionPool::discard(QWebSocket *socket)
+{
+    for (int i = 0; i < m_entries.size(); ++i) {
+        if (m_entries[i].socket == socket) {
+            m_entries.removeAt(i);
+            break;
+        }
+    }
+    socket->disconnect(this);
+    socket->abort();
+    socket->deleteLater();
+}
+
+void XunFeiConnectionPool::onSocketConnected()
+{
+    QWebSocket *socket = qobject_cast<QWebSocket *>(sender());
+    for (Entry &e : m_entries) {
+        if (e.socket == socket) {
+            e.ready    = true;
+            e.openedAt = QDateTime::currentMSecsSinceEpoch();  // 空闲计时从握手完成开始
+            break;
+        }
+    }
+}
+
+void XunFeiConnectionPool::onSocketDisconnected()
+{
+    // 池中连接被服务端断开或出错：丢弃，由下一次维护补足
+    QWebSocket *socket = qobject_cast<QWebSocket *>(sender());
+    if (socket) {
+        discard(socket);
+    }
+}
@@ -0,0 +1,86 @@
+#ifndef XUNFEICONNECTIONPOOL_H
+#define XUNFEICONNECTIONPOOL_H
+
+#include <QObject>
+#include <QWebSocket>
+#include <QTimer>
+#include <QList>
+
+// ─────────────────────────────────────────────────────────────────────────────
+// XunFeiConnectionPool — 讯飞 WebSocket 预热连接池
+//
+// 讯飞听写接口每条连接只能承载一次会话（收到 status=2 结果后由服务端关闭），
+// 因此这里"复用"的是建连过程：检测到语音起点时提前完成 DNS/TCP/TLS/握手，
+// 会话开始时直接取走一条已就绪的连接，建连不再出现在关键路径上。
+//
+//   - 鉴权 URL 由定时器在后台定期重新签名，取用时无需现场计算 HMAC
+//   - 讯飞会断开长时间不发数据的连接，空闲连接在到期前主动回收重建
+//   - 最后一次预热请求后超过 WARM_WINDOW_MS 不再维持连接，避免无谓的握手
+//
+// 与 SpeechRecogniser 运行在同一线程。
+// ─────────────────────────────────────────────────────────────────────────────
+class XunFeiConnectionPool : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit XunFeiConnectionPool(QObject *parent = nullptr);
+    ~XunFeiConnectionPool();
+
+    void configure(const QString &apiKey, const QString &apiSecret,
+                   const QString &host, const QString &path);
+
+    // 取走一条已连接的 socket；没有就绪连接时返回一条刚开始连接的 socket。
+    // 返回的 socket 归调用者所有，信号连接已清空。
+    QWebSocket *acquire(QObject *newParent);
+
+public slots:
+    // 语音起点触发：补足连接数并刷新预热窗口
+    void warmUp();
+    // 关闭全部连接并停止后台维护
+    void shutdown();
+
+signals:
+    void debug(const QString &message);
+
+private slots:
+    void onMaintenance();
+    void onSocketConnected();
+    void onSocketDisconnected();
+
+private:
+    QString signedUrl();
+    QString generateAuthUrl() const;
+    static QString formatTimestamp();
+
+    QWebSocket *openSocket();
+    void topUp();
+    void discard(QWebSocket *socket);
+
+    struct Entry {
+        QWebSocket *socket   = nullptr;
+        qint64      openedAt = 0;      // 发起连接的时间（ms）
+        bool        ready    = false;  // 已完成握手
+    };
+    QList<Entry> m_entries;
+
+    QTimer *m_maintenanceTimer = nullptr;
+
+    QString m_apiKey;
+    QString m_apiSecret;
+    QString m_host;
+    QString m_path;
+
+    QString m_cachedUrl;         // 最近一次签名的鉴权 URL
+    qint64  m_urlSignedAt  = 0;  // 签名时间（ms）
+    qint64  m_lastWarmUpAt = 0;  // 最近一次预热请求时间（ms）
+
+    // ─── 常量 ────────────────────────────────────────────────────────────────
+    static constexpr int POOL_SIZE          = 2;       // 预热连接数
+    static constexpr int MAINTENANCE_MS     = 1000;    // 后台维护周期
+    static constexpr int AUTH_REFRESH_MS    = 60000;   // 鉴权 URL 重新签名周期（讯飞允许 300s 偏差）
+    static constexpr int IDLE_RECYCLE_MS    = 8000;    // 空闲连接回收时间（讯飞约 10s 无数据断开）
+    static constexpr int WARM_WINDOW_MS     = 60000;   // 预热窗口
+};
+
+#endif // XUNFEICONNECTIONPOOL_H
@@ -0,0 +1,86 @@
+#include "xunfeiframeencoder.h"
+#include "dspkernels.h"
+#include <cstring>
+
+namespace {
+
+// JSON 字符串转义，非 ASCII 字符一律写成 \uXXXX，保证输出是纯 ASCII
+QByteArray jsonString(const QString &s)
+{
+    static const char HEX[] = "0123456789abcdef";
+    QByteArray out;
+    out.reserve(s.size() + 2);
+    out += '"';
+    for (const QChar ch : s) {
+        const char16_t c = ch.unicode();
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += char(c);
+        } else if (c >= 0x20 && c < 0x7F) {
+            out += char(c);
+        } else {
+            out += "\\u";
+            out += HEX[(c >> 12) & 0xF];
+            out += HEX[(c >> 8) & 0xF];
+            out += HEX[(c >> 4) & 0xF];
+            out += HEX[c & 0xF];
+        }
+    }
+    out += '"';
+    return out;
+}
+
+const char AUDIO_TAIL[] = "\"}}";
+constexpr int AUDIO_TAIL_LEN = sizeof(AUDIO_TAIL) - 1;
+
+} // namespace
+
+// ─────────────────────────────────────────────────────────────────────────────
+// configure() — 固定部分只在配置变化时生成一次
+// 字段与原 QJsonObject 版本一致（键顺序不影响讯飞解析）
+// eos 为讯飞端静音检测时长（毫秒）；dwa=wpgs 时中间结果会带 pgs/rg 修正之前的分片
+// ─────────────────────────────────────────────────────────────────────────────
+void XunFeiFrameEncoder::configure(const QString &appId, int sampleRate, bool dynamicCorrection)
+{
+    m_firstHead = "{\"common\":{\"app_id\":" + jsonString(appId) + "},"
+                  "\"business\":{\"language\":\"zh_cn\",\"domain\":\"iat\","
+                  "\"accent\":\"mandarin\",\"eos\":10000"
+                  + QByteArray(dynamicCorrection ? ",\"dwa\":\"wpgs\"" : "") + "},"
+                  "\"data\":{\"status\":";
+    m_head       = "{\"data\":{\"status\":";
+    m_dataFields = ",\"format\":\"audio/L16;rate=" + QByteArray::number(sampleRate)
+                   + "\",\"encoding\":\"raw\",\"audio\":\"";
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// encodeAudio() — 先按最终长度调整缓冲区（容量不足时才扩容），再顺序写入
+// ─────────────────────────────────────────────────────────────────────────────
+const QByteArray &XunFeiFrameEncoder::encodeAudio(int status, const char *audio, int size)
+{
+    const QByteArray &head = (status == 0) ? m_firstHead : m_head;
+    const size_t b64Len    = Dsp::base64Length(static_cast<size_t>(qMax(0, size)));
+    const qsizetype total  = head.size() + 1 + m_dataFields.size()
+                             + static_cast<qsizetype>(b64Len) + AUDIO_TAIL_LEN;
+
+    if (m_buffer.capacity() < total) {
+        m_buffer.reserve(total);
+    }
+    m_buffer.resize(total);   // Qt 6 的 resize 不会缩减容量
+
+    char *p = m_buffer.data();
+    memcpy(p, head.constData(), static_cast<size_t>(head.size()));
+    p += head.size();
+    *p++ = static_cast<char>('0' + qBound(0, status, 9));
+    memcpy(p, m_dataFields.constData(), static_cast<size_t>(m_dataFields.size()));
+    p += m_dataFields.size();
+    p += Dsp::kernels().base64Encode(reinterpret_cast<const uint8_t*>(audio),
+                                     static_cast<size_t>(qMax(0, size)), p);
+    memcpy(p, AUDIO_TAIL, AUDIO_TAIL_LEN);
+    return m_buffer;
+}
+
+const QByteArray &XunFeiFrameEncoder::encodeEnd()
+{
+    static const QByteArray END_FRAME = QByteArrayLiteral("{\"data\":{\"status\":2}}");
+    return END_FRAME;
+}
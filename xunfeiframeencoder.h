@@ -0,0 +1,44 @@
+#ifndef XUNFEIFRAMEENCODER_H
+#define XUNFEIFRAMEENCODER_H
+
+#include <QByteArray>
+#include <QString>
+
+// ─────────────────────────────────────────────────────────────────────────────
+// XunFeiFrameEncoder — 讯飞 IAT 协议帧编码器
+//
+// 原做法：QJsonObject 嵌套 → toBase64() → fromUtf8 转 QString → toJson() →
+// 再 fromUtf8 → sendTextMessage 内部 toUtf8，同一段音频被完整拷贝五六次，
+// 整句模式下每次都是几 MB。
+// 这里把 JSON 外壳预先拼好，base64（Dsp 向量化内核）直接写进一块复用的
+// UTF-8 缓冲区，一帧只写一遍，稳态下编码本身不分配。
+// 输出保证是纯 ASCII（app_id 中的非 ASCII 字符转义为 \uXXXX），
+// 发送时 QString::fromLatin1 一次拓宽即可，无需 UTF-8 解码。
+// 讯飞只接受文本帧，sendTextMessage 边界上仍有两次拷贝：拓宽成 QString 一次
+// （每帧一次分配），QWebSocket 内部 toUtf8 再一次。
+// 返回的引用在下一次 encode*() 前有效；只在识别线程中使用。
+// ─────────────────────────────────────────────────────────────────────────────
+class XunFeiFrameEncoder
+{
+public:
+    XunFeiFrameEncoder() = default;
+
+    // 预先生成各类帧的固定部分；dynamicCorrection 开启讯飞动态修正（dwa=wpgs）
+    void configure(const QString &appId, int sampleRate, bool dynamicCorrection = false);
+
+    // 音频帧：status=0 时附带 common/business 参数
+    const QByteArray &encodeAudio(int status, const char *audio, int size);
+    // 尾帧：只包含 data.status=2
+    const QByteArray &encodeEnd();
+
+    // 编码结果转为 sendTextMessage 需要的 QString（ASCII，单次拓宽；每次调用分配一个新 QString）
+    static QString toMessage(const QByteArray &frame) { return QString::fromLatin1(frame); }
+
+private:
+    QByteArray m_firstHead;   // {"common":{...},"business":{...},"data":{"status":
+    QByteArray m_head;        // {"data":{"status":
+    QByteArray m_dataFields;  // ,"format":"audio/L16;rate=16000","encoding":"raw","audio":"
+    QByteArray m_buffer;      // 复用的输出缓冲区，只增不减
+};
+
+#endif // XUNFEIFRAMEENCODER_H
@@ -0,0 +1,388 @@
+#include "xunfeiresultparser.h"
+
+void XunFeiResult::clear()
+{
+    code       = 0;
+    status     = -1;
+    hasResult  = false;
+    sn         = 0;
+    last       = false;
+    replace    = false;
+    corrections = false;
+    rangeBegin = 0;
+    rangeEnd   = 0;
+    message.truncate(0);   // truncate 保留容量，clear() 会释放
+    text.truncate(0);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// parse() — 消息结构：
+//   {"code":0,"message":"success","sid":"...",
+//    "data":{"status":1,"result":{"sn":2,"ls":false,"pgs":"rpl","rg":[1,1],
+//            "ws":[{"bg":0,"cw":[{"sc":0,"w":"你好"}]}, ...]}}}
+// ─────────────────────────────────────────────────────────────────────────────
+bool XunFeiResultParser::parse(QStringView json, XunFeiResult *result)
+{
+    m_src   = json;
+    m_pos   = 0;
+    m_depth = 0;
+    m_out   = result;
+    m_out->clear();
+
+    const bool ok = parseRoot();
+    m_out = nullptr;
+    return ok;
+}
+
+bool XunFeiResultParser::parseRoot()
+{
+    return parseObject([this](QStringView key) {
+        if (key == u"code")    return parseInt(&m_out->code);
+        if (key == u"message") return parseString(&m_out->message);
+        if (key == u"data")    return parseData();
+        return skipValue();
+    });
+}
+
+bool XunFeiResultParser::parseData()
+{
+    skipSpace();
+    if (m_pos < m_src.size() && m_src[m_pos] == u'n') {
+        return skipValue();   // "data":null
+    }
+    if (m_out->status < 0) {
+        m_out->status = 0;
+    }
+    return parseObject([this](QStringView key) {
+        if (key == u"status") return parseInt(&m_out->status);
+        if (key == u"result") return parseResult();
+        return skipValue();
+    });
+}
+
+bool XunFeiResultParser::parseResult()
+{
+    skipSpace();
+    if (m_pos < m_src.size() && m_src[m_pos] == u'n') {
+        return skipValue();
+    }
+    m_out->hasResult = true;
+    return parseObject([this](QStringView key) {
+        if (key == u"sn") return parseInt(&m_out->sn);
+        if (key == u"ls") return parseBool(&m_out->last);
+        if (key == u"pgs") {
+            QStringView pgs;
+            if (!parseRawString(&pgs)) return false;
+            m_out->replace     = (pgs == u"rpl");
+            m_out->corrections = true;
+            return true;
+        }
+        if (key == u"rg") {
+            int index = 0;
+            return parseArray([this, &index]() {
+                int value = 0;
+                if (!parseInt(&value)) return false;
+                if (index == 0) m_out->rangeBegin = value;
+                if (index == 1) m_out->rangeEnd   = value;
+                ++index;
+                return true;
+            });
+        }
+        if (key == u"ws") {
+            return parseArray([this]() { return parseWord(); });
+        }
+        return skipValue();
+    });
+}
+
+bool XunFeiResultParser::parseWord()
+{
+    return parseObject([this](QStringView key) {
+        if (key != u"cw") return skipValue();
+        return parseArray([this]() {
+            return parseObject([this](QStringView cwKey) {
+                if (cwKey == u"w") return parseString(&m_out->text);
+                return skipValue();
+            });
+        });
+    });
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// 通用结构：对象逐个成员回调（回调负责解析值），数组逐个元素回调
+// ─────────────────────────────────────────────────────────────────────────────
+template <typename OnMember>
+bool XunFeiResultParser::parseObject(OnMember &&onMember)
+{
+    if (!consume(u'{')) return false;
+    if (++m_depth > MAX_DEPTH) return false;
+
+    skipSpace();
+    if (consume(u'}')) {
+        --m_depth;
+        return true;
+    }
+    for (;;) {
+        QStringView key;
+        if (!parseRawString(&key)) return false;
+        if (!consume(u':'))        return false;
+        if (!onMember(key))        return false;
+        if (consume(u','))         continue;
+        if (consume(u'}'))         break;
+        return false;
+    }
+    --m_depth;
+    return true;
+}
+
+template <typename OnElement>
+bool XunFeiResultParser::parseArray(OnElement &&onElement)
+{
+    if (!consume(u'[')) return false;
+    if (++m_depth > MAX_DEPTH) return false;
+
+    skipSpace();
+    if (consume(u']')) {
+        --m_depth;
+        return true;
+    }
+    for (;;) {
+        if (!onElement())   return false;
+        if (consume(u','))  continue;
+        if (consume(u']'))  break;
+        return false;
+    }
+    --m_depth;
+    return true;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// 基本值
+// ─────────────────────────────────────────────────────────────────────────────
+void XunFeiResultParser::skipSpace()
+{
+    while (m_pos < m_src.size()) {
+        const char16_t c = m_src[m_pos].unicode();
+        if (c != u' ' && c != u'\n' && c != u'\r' && c != u'\t') break;
+        ++m_pos;
+    }
+}
+
+bool XunFeiResultParser::consume(char16_t c)
+{
+    skipSpace();
+    if (m_pos < m_src.size() && m_src[m_pos].unicode() == c) {
+        ++m_pos;
+        return true;
+    }
+    return false;
+}
+
+bool XunFeiResultParser::parseRawString(QStringView *out)
+{
+    if (!consume(u'"')) return false;
+
+    const qsizetype start = m_pos;
+    bool escaped = false;
+    while (m_pos < m_src.size()) {
+        const char16_t c = m_src[m_pos].unicode();
+        if (c == u'"') {
+            // 带转义的短字段不会与任何已知键匹配，按未知字段跳过
+            *out = escaped ? QStringView() : m_src.sliced(start, m_pos - start);
+            ++m_pos;
+            return true;
+        }
+        if (c == u'\\') {
+            escaped = true;
+            ++m_pos;
+        }
+        ++m_pos;
+    }
+    return false;
+}
+
+bool XunFeiResultParser::parseString(QString *out)
+{
+    if (!consume(u'"')) return false;
+
+    qsizetype run = m_pos;   // 未转义片段的起点，整段追加
+    while (m_pos < m_src.size()) {
+        const char16_t c = m_src[m_pos].unicode();
+        if (c == u'"') {
+            if (out) out->append(m_src.sliced(run, m_pos - run));
+            ++m_pos;
+            return true;
+        }
+        if (c != u'\\') {
+            ++m_pos;
+            continue;
+        }
+
+        if (out) out->append(m_src.sliced(run, m_pos - run));
+        if (m_pos + 1 >= m_src.size()) return false;
+        const char16_t e = m_src[m_pos + 1].unicode();
+        m_pos += 2;
+
+        char16_t decoded = 0;
+        switch (e) {
+        case u'"':  decoded = u'"';  break;
+        case u'\\': decoded = u'\\'; break;
+        case u'/':  decoded = u'/';  break;
+        case u'b':  decoded = u'\b'; break;
+        case u'f':  decoded = u'\f'; break;
+        case u'n':  decoded = u'\n'; break;
+        case u'r':  decoded = u'\r'; break;
+        case u't':  decoded = u'\t'; break;
+        case u'u': {
+            // 代理对由两个 \u 依次追加，UTF-16 下无需合并
+            if (m_pos + 4 > m_src.size()) return false;
+            for (int i = 0; i < 4; ++i) {
+                const char16_t h = m_src[m_pos + i].unicode();
+                int v;
+                if (h >= u'0' && h <= u'9')      v = h - u'0';
+                else if (h >= u'a' && h <= u'f') v = h - u'a' + 10;
+                else if (h >= u'A' && h <= u'F') v = h - u'A' + 10;
+                else return false;
+                decoded = static_cast<char16_t>((decoded << 4) | v);
+            }
+            m_pos += 4;
+            break;
+        }
+        default:
+            return false;
+        }
+        if (out) out->append(QChar(decoded));
+        run = m_pos;
+    }
+    return false;
+}
+
+bool XunFeiResultParser::parseInt(int *out)
+{
+    skipSpace();
+    bool negative = false;
+    if (m_pos < m_src.size() && m_src[m_pos] == u'-') {
+        negative = true;
+        ++m_pos;
+    }
+    const qsizetype start = m_pos;
+    long long value = 0;
+    while (m_pos < m_src.size() && m_src[m_pos] >= u'0' && m_src[m_pos] <= u'9') {
+        value = qMin(value * 10 + (m_src[m_pos].unicode() - u'0'), 0x7FFFFFFFLL);
+        ++m_pos;
+    }
+    if (m_pos == start) return false;
+
+    // 小数部分与指数按整数截断处理
+    while (m_pos < m_src.size()) {
+        const char16_t c = m_src[m_pos].unicode();
+        if (!((c >= u'0' && c <= u'9') || c == u'.' || c == u'e' || c == u'E'
+              || c == u'+' || c == u'-')) break;
+        ++m_pos;
+    }
+    *out = static_cast<int>(negative ? -value : value);
+    return true;
+}
+
+bool XunFeiResultParser::parseBool(bool *out)
+{
+    skipSpace();
+    const QStringView rest = m_src.sliced(m_pos);
+    if (rest.startsWith(u"true"))  { *out = true;  m_pos += 4; return true; }
+    if (rest.startsWith(u"false")) { *out = false; m_pos += 5; return true; }
+    return skipValue();   // null 等，保持默认值
+}
+
+bool XunFeiResultParser::skipValue()
+{
+    skipSpace();
+    if (m_pos >= m_src.size()) return false;
+
+    const char16_t c = m_src[m_pos].unicode();
+    if (c == u'{') return parseObject([this](QStringView) { return skipValue(); });
+    if (c == u'[') return parseArray([this]() { return skipValue(); });
+    if (c == u'"') return parseString(nullptr);
+
+    // 数字 / true / false / null：跳到下一个分隔符
+    const qsizetype start = m_pos;
+    while (m_pos < m_src.size()) {
+        const char16_t d = m_src[m_pos].unicode();
+        if (d == u',' || d == u'}' || d == u']' || d == u' ' || d == u'\n'
+            || d == u'\r' || d == u'\t') break;
+        ++m_pos;
+    }
+    return m_pos > start;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// XunFeiSegmentTable
+// ─────────────────────────────────────────────────────────────────────────────
+void XunFeiSegmentTable::apply(const XunFeiResult &result)
+{
+    // 没有 sn 的结果按追加处理
+    const int sn = (result.sn > 0) ? result.sn : static_cast<int>(qMax<size_t>(m_segments.size(), 1));
+    if (sn >= MAX_SEGMENTS) {
+        return;
+    }
+    if (m_segments.size() <= static_cast<size_t>(sn)) {
+        m_segments.resize(static_cast<size_t>(sn) + 1);
+    }
+
+    // 动态修正：rg 范围内的旧分片作废，由本片替代；rg 起点之前的分片不会再变
+    if (result.corrections) {
+        m_corrections = true;
+    }
+    if (result.replace) {
+        m_stableEnd = qMax(1, result.rangeBegin);
+        const int first = qMax(1, result.rangeBegin);
+        const int last  = qMin(result.rangeEnd, static_cast<int>(m_segments.size()) - 1);
+        for (int i = first; i <= last; ++i) {
+            m_segments[static_cast<size_t>(i)].truncate(0);
+        }
+    }
+
+    // 按字符拷贝而不是共享：解析器下次复用 result.text 时不会因共享而重新分配
+    QString &segment = m_segments[static_cast<size_t>(sn)];
+    segment.truncate(0);
+    segment.append(result.text.constData(), result.text.size());
+}
+
+QString XunFeiSegmentTable::text() const
+{
+    qsizetype length = 0;
+    for (const QString &s : m_segments) {
+        length += s.size();
+    }
+    QString out;
+    out.reserve(length);
+    for (const QString &s : m_segments) {
+        out += s;
+    }
+    return out;
+}
+
+qsizetype XunFeiSegmentTable::stableLength() const
+{
+    const size_t end = m_corrections ? qMin(static_cast<size_t>(m_stableEnd), m_segments.size())
+                                     : m_segments.size();
+    qsizetype length = 0;
+    for (size_t i = 0; i < end; ++i) {
+        length += m_segments[i].size();
+    }
+    return length;
+}
+
+void XunFeiSegmentTable::clear()
+{
+    m_segments.clear();
+    m_corrections = false;
+    m_stableEnd   = 1;
+}
+
+bool XunFeiSegmentTable::isEmpty() const
+{
+    for (const QString &s : m_segments) {
+        if (!s.isEmpty()) return false;
+    }
+    return true;
+}
@@ -0,0 +1,95 @@
+#ifndef XUNFEIRESULTPARSER_H
+#define XUNFEIRESULTPARSER_H
+
+#include <QString>
+#include <QStringView>
+#include <vector>
+
+// ─────────────────────────────────────────────────────────────────────────────
+// XunFeiResult — 一条讯飞返回消息中识别会话关心的字段
+// clear() 只清空内容、保留字符串容量，同一个对象反复用于解析不会反复分配
+// ─────────────────────────────────────────────────────────────────────────────
+struct XunFeiResult
+{
+    int     code   = 0;        // 0 表示成功
+    QString message;           // code != 0 时的错误描述
+    int     status = -1;       // data.status：0/1 中间结果，2 最终结果；-1 表示无 data
+    bool    hasResult = false; // 是否包含 data.result
+    int     sn   = 0;          // 结果序号（从 1 开始）
+    bool    last = false;      // ls：是否为最后一片结果
+    bool    replace = false;   // pgs == "rpl"：替换 rg 范围内的旧结果（动态修正）
+    bool    corrections = false; // 带 pgs 字段（dwa=wpgs）：追加的分片之后仍可能被替换
+    int     rangeBegin = 0;    // rg[0]
+    int     rangeEnd   = 0;    // rg[1]
+    QString text;              // 本片结果所有 ws[].cw[].w 依次拼接
+
+    void clear();
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+// XunFeiResultParser — 讯飞 IAT 返回消息的拉取式解析器
+//
+// 直接在 sendTextMessage 收到的 UTF-16 文本上顺序扫描，只取出
+// code / message / status / sn / ls / pgs / rg 以及各词的 w，其余字段原样跳过，
+// 不构造 QJsonDocument，也不做 toUtf8() 转换。
+// 词文本解码后直接追加进 XunFeiResult::text，稳态下每条消息没有堆分配。
+// ─────────────────────────────────────────────────────────────────────────────
+class XunFeiResultParser
+{
+public:
+    // 解析一条消息，格式错误时返回 false（result 内容不完整，应丢弃）
+    bool parse(QStringView json, XunFeiResult *result);
+
+private:
+    template <typename OnMember>  bool parseObject(OnMember &&onMember);
+    template <typename OnElement> bool parseArray(OnElement &&onElement);
+
+    bool parseRoot();
+    bool parseData();
+    bool parseResult();
+    bool parseWord();                        // ws[] 中的一项：依次追加 cw[].w
+
+    bool parseRawString(QStringView *out);   // 不含转义时返回原文视图（键、pgs 等短字段）
+    bool parseString(QString *out);          // 解码转义并追加到 out；out 为空时只跳过
+    bool parseInt(int *out);
+    bool parseBool(bool *out);
+    bool skipValue();
+    void skipSpace();
+    bool consume(char16_t c);
+
+    QStringView   m_src;
+    qsizetype     m_pos   = 0;
+    int           m_depth = 0;
+    XunFeiResult *m_out   = nullptr;
+
+    static constexpr int MAX_DEPTH = 32;
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+// XunFeiSegmentTable — 按 sn 保存的结果分片表
+//
+// 开启动态修正（dwa=wpgs）后，讯飞会用 pgs=rpl 的新结果替换 rg 范围内的旧分片；
+// 未开启时每片都是追加（pgs=apd 或不带 pgs），效果与原来的逐片拼接相同。
+// text() 按 sn 顺序拼出当前完整文本。
+// stableLength() 为 text() 中不会再被替换的前缀长度：rpl 替换的总是最近的若干分片，
+// 最近一次 rpl 的 rg 起点之前的分片已被越过，视为定稿；其后的分片（包括 apd 追加的）
+// 仍可能被下一次 rpl 替换。未开启动态修正时每片都是定稿，整段稳定。
+// ─────────────────────────────────────────────────────────────────────────────
+class XunFeiSegmentTable
+{
+public:
+    void    apply(const XunFeiResult &result);
+    QString text() const;
+    qsizetype stableLength() const;
+    void    clear();
+    bool    isEmpty() const;
+
+private:
+    std::vector<QString> m_segments;   // 下标为 sn，0 号不用
+    bool m_corrections = false;        // 收到过带 pgs 的结果
+    int  m_stableEnd   = 1;            // sn 小于此值的分片为定稿
+
+    static constexpr int MAX_SEGMENTS = 4096;   // 防御异常 sn
+};
+
+#endif // XUNFEIRESULTPARSER_H